@@ -0,0 +1,53 @@
+#include <core/ec/fixed_base.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace crypt_gost::core::ec;
+
+namespace
+{
+
+enum Scalar
+{
+    SPARSE,
+    DENSE,
+};
+
+// Fixed base multiplication must take the same time for a scalar with zero low half as for
+// a full one, compare the two rows of the output.
+template < size_t bitSize >
+void FixedBaseMul( benchmark::State& state, const CurveParams& params )
+{
+    using Number = typename Curve< bitSize >::Number;
+    Curve< bitSize > curve( params );
+    FixedBaseTable< bitSize > table( curve, curve.Base() );
+    const Number k = state.range( 0 ) == SPARSE
+                         ? ( curve.Order() >> ( bitSize / 2 + 2 ) ) << ( bitSize / 2 )
+                         : ( curve.Order() >> 2 ) + Number( 0x123456789 );
+    for( auto _: state )
+    {
+        benchmark::DoNotOptimize( table.Mul( k ) );
+    }
+}
+
+void FixedBaseMul256( benchmark::State& state, const CurveParams& params )
+{
+    FixedBaseMul< 256 >( state, params );
+}
+
+void FixedBaseMul512( benchmark::State& state, const CurveParams& params )
+{
+    FixedBaseMul< 512 >( state, params );
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE( FixedBaseMul256, ParamSet256A, Tc26ParamSet256A() )
+    ->Arg( SPARSE )
+    ->Arg( DENSE );
+BENCHMARK_CAPTURE( FixedBaseMul256, ParamSet256B, Tc26ParamSet256B() )
+    ->Arg( SPARSE )
+    ->Arg( DENSE );
+BENCHMARK_CAPTURE( FixedBaseMul512, ParamSet512A, Tc26ParamSet512A() )
+    ->Arg( SPARSE )
+    ->Arg( DENSE );
@@ -9,9 +9,15 @@ HeapAllocator& HeapAllocator::GetInstance()
     return allocator;
 }
 
+// aligned_alloc requires size to be a multiple of alignment, e.g. a number of three bytes
+// with alignment 8 is not, so the size is rounded up.
 void* HeapAllocator::Allocate( size_t size, size_t alignment ) noexcept
 {
-    return alignment ? aligned_alloc( alignment, size ) : malloc( size );
+    if( alignment == 0 )
+    {
+        return malloc( size );
+    }
+    return aligned_alloc( alignment, ( size + alignment - 1 ) / alignment * alignment );
 }
 
 void HeapAllocator::Deallocate( void* ptr ) noexcept
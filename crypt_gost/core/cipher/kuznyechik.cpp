@@ -0,0 +1,330 @@
+#include <cstring>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/util/mem_buf.hpp>
+#include <core/util/secure_zero.hpp>
+#include "kuznyechik_kernel.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+using namespace crypt_gost::core::cipher::kernel;
+using kuznyechik::GfMul;
+using kuznyechik::INVERSE_PI;
+using kuznyechik::L_COEFFICIENTS;
+using kuznyechik::PI;
+
+namespace
+{
+
+using Block = Kuznyechik::Block;
+
+constexpr size_t BLOCK_SIZE = Kuznyechik::BLOCK_SIZE;
+constexpr size_t TABLE_ALIGNMENT = 16;
+
+uint8_t LinearFunction( const uint8_t* bytes ) noexcept
+{
+    uint8_t ret = 0;
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        ret ^= GfMul( bytes[ i ], L_COEFFICIENTS[ i ] );
+    }
+    return ret;
+}
+
+// L = R^16, where R shifts bytes towards the end and puts l of them in front.
+void TransformL( uint8_t* bytes ) noexcept
+{
+    for( size_t round = 0; round < BLOCK_SIZE; ++round )
+    {
+        uint8_t first = LinearFunction( bytes );
+        std::memmove( bytes + 1, bytes, BLOCK_SIZE - 1 );
+        bytes[ 0 ] = first;
+    }
+}
+
+// L^-1 = ( R^-1 )^16. The last coefficient of l is 1, so the byte shifted out by R is
+// recovered as l of the rotated block.
+void TransformInverseL( uint8_t* bytes ) noexcept
+{
+    for( size_t round = 0; round < BLOCK_SIZE; ++round )
+    {
+        uint8_t first = bytes[ 0 ];
+        std::memmove( bytes, bytes + 1, BLOCK_SIZE - 1 );
+        bytes[ BLOCK_SIZE - 1 ] = first;
+        bytes[ BLOCK_SIZE - 1 ] = LinearFunction( bytes );
+    }
+}
+
+/**
+ * @brief Lookup tables, entry [ i ][ b ] is the transformation of a block with byte b at
+ * position i and zeros elsewhere.
+ */
+struct Tables
+{
+    // L( S( x ) ).
+    Block encrypt[ BLOCK_SIZE ][ 256 ];
+    // L^-1( S^-1( x ) ).
+    Block decrypt[ BLOCK_SIZE ][ 256 ];
+    // Key schedule constants C_i = L( i ), i = 1..32.
+    Block constants[ 32 ];
+};
+
+const Tables& GetTables()
+{
+    static const util::MemBuf buffer = [] {
+        util::MemBuf ret( sizeof( Tables ), TABLE_ALIGNMENT );
+        Tables& tables = *static_cast< Tables* >( ret.GetBuf() );
+        uint8_t bytes[ BLOCK_SIZE ];
+        for( size_t i = 0; i < BLOCK_SIZE; ++i )
+        {
+            for( size_t b = 0; b < 256; ++b )
+            {
+                std::memset( bytes, 0, sizeof( bytes ) );
+                bytes[ i ] = PI[ b ];
+                TransformL( bytes );
+                std::memcpy( &tables.encrypt[ i ][ b ], bytes, BLOCK_SIZE );
+
+                std::memset( bytes, 0, sizeof( bytes ) );
+                bytes[ i ] = INVERSE_PI.bytes[ b ];
+                TransformInverseL( bytes );
+                std::memcpy( &tables.decrypt[ i ][ b ], bytes, BLOCK_SIZE );
+            }
+        }
+        for( size_t i = 0; i < 32; ++i )
+        {
+            std::memset( bytes, 0, sizeof( bytes ) );
+            bytes[ BLOCK_SIZE - 1 ] = static_cast< uint8_t >( i + 1 );
+            TransformL( bytes );
+            std::memcpy( &tables.constants[ i ], bytes, BLOCK_SIZE );
+        }
+        return ret;
+    }();
+    return *static_cast< const Tables* >( buffer.GetBuf() );
+}
+
+inline Block Load( const uint8_t* data ) noexcept
+{
+    Block ret;
+    std::memcpy( &ret, data, BLOCK_SIZE );
+    return ret;
+}
+
+inline void Store( uint8_t* data, const Block& block ) noexcept
+{
+    std::memcpy( data, &block, BLOCK_SIZE );
+}
+
+inline Block Xor( const Block& a, const Block& b ) noexcept
+{
+    return Block{ a.lo ^ b.lo, a.hi ^ b.hi };
+}
+
+// XOR of table entries selected by the bytes of x.
+inline Block Lookup( const Block ( *table )[ 256 ], const Block& x ) noexcept
+{
+    uint8_t bytes[ BLOCK_SIZE ];
+    std::memcpy( bytes, &x, BLOCK_SIZE );
+    Block ret = table[ 0 ][ bytes[ 0 ] ];
+    for( size_t i = 1; i < BLOCK_SIZE; ++i )
+    {
+        ret.lo ^= table[ i ][ bytes[ i ] ].lo;
+        ret.hi ^= table[ i ][ bytes[ i ] ].hi;
+    }
+    return ret;
+}
+
+inline Block Substitute( const uint8_t* sbox, const Block& x ) noexcept
+{
+    uint8_t bytes[ BLOCK_SIZE ];
+    std::memcpy( bytes, &x, BLOCK_SIZE );
+    for( auto& byte: bytes )
+    {
+        byte = sbox[ byte ];
+    }
+    return Load( bytes );
+}
+
+} // namespace
+
+Kuznyechik::Kuznyechik( const uint8_t* key )
+    : encryptKeys_()
+    , decryptKeys_()
+{
+    GetTables();
+    SetKey( key );
+}
+
+Kuznyechik::~Kuznyechik() noexcept
+{
+    util::SecureZero( encryptKeys_, sizeof( encryptKeys_ ) );
+    util::SecureZero( decryptKeys_, sizeof( decryptKeys_ ) );
+}
+
+void Kuznyechik::SetKey( const uint8_t* key ) noexcept
+{
+    const Tables& tables = GetTables();
+
+    // ( K_2i+1, K_2i+2 ) = F[ C_8i ] ... F[ C_8i-7 ]( K_2i-1, K_2i ), where
+    // F[ C ]( a1, a0 ) = ( L( S( a1 ^ C ) ) ^ a0, a1 ).
+    Block a1 = Load( key );
+    Block a0 = Load( key + BLOCK_SIZE );
+    encryptKeys_[ 0 ] = a1;
+    encryptKeys_[ 1 ] = a0;
+    for( size_t i = 0; i < 32; ++i )
+    {
+        Block next = Xor( Lookup( tables.encrypt, Xor( a1, tables.constants[ i ] ) ), a0 );
+        a0 = a1;
+        a1 = next;
+        if( ( i + 1 ) % 8 == 0 )
+        {
+            size_t pair = ( i + 1 ) / 8;
+            encryptKeys_[ 2 * pair ] = a1;
+            encryptKeys_[ 2 * pair + 1 ] = a0;
+        }
+    }
+
+    // Inner decryption rounds add L^-1( K ), which is the decryption lookup of S( K ).
+    decryptKeys_[ 0 ] = encryptKeys_[ 0 ];
+    for( size_t i = 1; i + 1 < ROUND_KEY_COUNT; ++i )
+    {
+        decryptKeys_[ i ] = Lookup( tables.decrypt, Substitute( PI, encryptKeys_[ i ] ) );
+    }
+    decryptKeys_[ ROUND_KEY_COUNT - 1 ] = encryptKeys_[ ROUND_KEY_COUNT - 1 ];
+}
+
+void Kuznyechik::EncryptBlock( const uint8_t* in, uint8_t* out ) const noexcept
+{
+    EncryptBlocks( in, out, 1 );
+}
+
+void Kuznyechik::DecryptBlock( const uint8_t* in, uint8_t* out ) const noexcept
+{
+    DecryptBlocks( in, out, 1 );
+}
+
+void Kuznyechik::EncryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+{
+    kuznyechik::EncryptBlocksDispatcher().Get()( encryptKeys_, in, out, count );
+}
+
+void Kuznyechik::DecryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+{
+    kuznyechik::DecryptBlocksDispatcher().Get()( decryptKeys_, in, out, count );
+}
+
+void Kuznyechik::EncryptBlocksMultiKey( const Kuznyechik* const* ciphers,
+                                        const uint8_t* in,
+                                        uint8_t* out,
+                                        size_t count ) noexcept
+{
+    constexpr size_t GROUP_SIZE = 64;
+    const Block* keys[ GROUP_SIZE ];
+    auto kernel = kuznyechik::EncryptBlocksMultiKeyDispatcher().Get();
+    for( size_t first = 0; first < count; first += GROUP_SIZE )
+    {
+        size_t n = count - first < GROUP_SIZE ? count - first : GROUP_SIZE;
+        for( size_t i = 0; i < n; ++i )
+        {
+            keys[ i ] = ciphers[ first + i ]->encryptKeys_;
+        }
+        kernel( keys, in + first * BLOCK_SIZE, out + first * BLOCK_SIZE, n );
+    }
+}
+
+void kuznyechik::generic::EncryptBlocks( const Block* keys,
+                                         const uint8_t* in,
+                                         uint8_t* out,
+                                         size_t count ) noexcept
+{
+    const Tables& tables = GetTables();
+    for( size_t n = 0; n < count; ++n )
+    {
+        Block x = Load( in + n * BLOCK_SIZE );
+        for( size_t i = 0; i + 1 < Kuznyechik::ROUND_KEY_COUNT; ++i )
+        {
+            x = Lookup( tables.encrypt, Xor( x, keys[ i ] ) );
+        }
+        Store( out + n * BLOCK_SIZE, Xor( x, keys[ Kuznyechik::ROUND_KEY_COUNT - 1 ] ) );
+    }
+}
+
+// y = L^-1( c ^ K_10 ), then y = L^-1( S^-1( y ) ^ K_i ) = L^-1( S^-1( y ) ) ^ L^-1( K_i )
+// for i = 9..2, and the block is S^-1( y ) ^ K_1.
+void kuznyechik::generic::DecryptBlocks( const Block* keys,
+                                         const uint8_t* in,
+                                         uint8_t* out,
+                                         size_t count ) noexcept
+{
+    const Tables& tables = GetTables();
+    for( size_t n = 0; n < count; ++n )
+    {
+        Block x = Xor( Load( in + n * BLOCK_SIZE ), keys[ Kuznyechik::ROUND_KEY_COUNT - 1 ] );
+        x = Lookup( tables.decrypt, Substitute( PI, x ) );
+        for( size_t i = Kuznyechik::ROUND_KEY_COUNT - 2; i > 0; --i )
+        {
+            x = Xor( Lookup( tables.decrypt, x ), keys[ i ] );
+        }
+        Store( out + n * BLOCK_SIZE,
+               Xor( Substitute( INVERSE_PI.bytes, x ), keys[ 0 ] ) );
+    }
+}
+
+void kuznyechik::generic::EncryptBlocksMultiKey( const Block* const* keys,
+                                                 const uint8_t* in,
+                                                 uint8_t* out,
+                                                 size_t count ) noexcept
+{
+    for( size_t n = 0; n < count; ++n )
+    {
+        EncryptBlocks( keys[ n ], in + n * BLOCK_SIZE, out + n * BLOCK_SIZE, 1 );
+    }
+}
+
+cpu::Dispatcher< kuznyechik::EncryptBlocksFn >& kuznyechik::EncryptBlocksDispatcher() noexcept
+{
+    static cpu::Dispatcher< EncryptBlocksFn > dispatcher( generic::EncryptBlocks );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::EncryptBlocksAvx2, cpu::FEATURE_AVX2 | cpu::FEATURE_GFNI );
+        dispatcher.Register( x86_64::EncryptBlocksAvx512,
+                             cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512BW
+                                 | cpu::FEATURE_AVX512VBMI | cpu::FEATURE_GFNI );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< kuznyechik::DecryptBlocksFn >& kuznyechik::DecryptBlocksDispatcher() noexcept
+{
+    static cpu::Dispatcher< DecryptBlocksFn > dispatcher( generic::DecryptBlocks );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::DecryptBlocksAvx2, cpu::FEATURE_AVX2 | cpu::FEATURE_GFNI );
+        dispatcher.Register( x86_64::DecryptBlocksAvx512,
+                             cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512BW
+                                 | cpu::FEATURE_AVX512VBMI | cpu::FEATURE_GFNI );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< kuznyechik::EncryptBlocksMultiKeyFn >&
+kuznyechik::EncryptBlocksMultiKeyDispatcher() noexcept
+{
+    static cpu::Dispatcher< EncryptBlocksMultiKeyFn > dispatcher( generic::EncryptBlocksMultiKey );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::EncryptBlocksMultiKeyAvx2,
+                             cpu::FEATURE_AVX2 | cpu::FEATURE_GFNI );
+        dispatcher.Register( x86_64::EncryptBlocksMultiKeyAvx512,
+                             cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512BW
+                                 | cpu::FEATURE_AVX512VBMI | cpu::FEATURE_GFNI );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
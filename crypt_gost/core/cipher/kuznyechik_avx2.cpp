@@ -0,0 +1,193 @@
+#include <core/util/secure_zero.hpp>
+#include "kuznyechik_kernel.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx2,gfni" )
+
+#    include <immintrin.h>
+#    include "kuznyechik_sliced.h"
+
+using namespace crypt_gost::core::cipher::kernel;
+
+namespace
+{
+
+// Row h holds S( 16h + i ) for i = 0..15, repeated in both 128-bit lanes for vpshufb.
+struct alignas( 32 ) SboxRow
+{
+    uint8_t bytes[ 32 ];
+};
+
+struct SboxRows
+{
+    SboxRow rows[ 16 ];
+};
+
+constexpr SboxRows MakeSboxRows( const uint8_t* sbox ) noexcept
+{
+    SboxRows ret{};
+    for( size_t h = 0; h < 16; ++h )
+    {
+        for( size_t i = 0; i < 32; ++i )
+        {
+            ret.rows[ h ].bytes[ i ] = sbox[ 16 * h + i % 16 ];
+        }
+    }
+    return ret;
+}
+
+constexpr SboxRows SBOX_ROWS = MakeSboxRows( kuznyechik::PI );
+constexpr SboxRows INVERSE_SBOX_ROWS = MakeSboxRows( kuznyechik::INVERSE_PI.bytes );
+
+// Byte j of 32 blocks.
+struct Avx2Ops
+{
+    using Vec = __m256i;
+    static constexpr size_t WIDTH = 32;
+    static constexpr size_t MIN_PADDED_BLOCKS = 24;
+
+    static inline Vec Load( const uint8_t* ptr ) noexcept
+    {
+        return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+    }
+
+    static inline void Store( uint8_t* ptr, Vec value ) noexcept
+    {
+        _mm256_storeu_si256( reinterpret_cast< __m256i* >( ptr ), value );
+    }
+
+    static inline Vec Row( const SboxRow& row ) noexcept
+    {
+        return _mm256_load_si256( reinterpret_cast< const __m256i* >( row.bytes ) );
+    }
+
+    static inline Vec Broadcast( uint8_t value ) noexcept
+    {
+        return _mm256_set1_epi8( static_cast< char >( value ) );
+    }
+
+    static inline Vec Xor( Vec a, Vec b ) noexcept
+    {
+        return _mm256_xor_si256( a, b );
+    }
+
+    template < size_t bytes >
+    static inline Vec UnpackLo( Vec a, Vec b ) noexcept
+    {
+        if constexpr( bytes == 1 )
+        {
+            return _mm256_unpacklo_epi8( a, b );
+        }
+        else if constexpr( bytes == 2 )
+        {
+            return _mm256_unpacklo_epi16( a, b );
+        }
+        else if constexpr( bytes == 4 )
+        {
+            return _mm256_unpacklo_epi32( a, b );
+        }
+        else
+        {
+            return _mm256_unpacklo_epi64( a, b );
+        }
+    }
+
+    template < size_t bytes >
+    static inline Vec UnpackHi( Vec a, Vec b ) noexcept
+    {
+        if constexpr( bytes == 1 )
+        {
+            return _mm256_unpackhi_epi8( a, b );
+        }
+        else if constexpr( bytes == 2 )
+        {
+            return _mm256_unpackhi_epi16( a, b );
+        }
+        else if constexpr( bytes == 4 )
+        {
+            return _mm256_unpackhi_epi32( a, b );
+        }
+        else
+        {
+            return _mm256_unpackhi_epi64( a, b );
+        }
+    }
+
+    // Look up the low nibble in all 16 rows, then select the row by bits of the high
+    // nibble, each moved to the top bit of the byte for vpblendvb.
+    static inline Vec Lookup( const SboxRows& sbox, Vec x ) noexcept
+    {
+        const Vec low = _mm256_and_si256( x, Broadcast( 0x0f ) );
+        Vec r[ 16 ];
+        for( size_t h = 0; h < 16; ++h )
+        {
+            r[ h ] = _mm256_shuffle_epi8( Row( sbox.rows[ h ] ), low );
+        }
+        Vec select = _mm256_slli_epi16( x, 3 );
+        for( size_t h = 0; h < 8; ++h )
+        {
+            r[ h ] = _mm256_blendv_epi8( r[ 2 * h ], r[ 2 * h + 1 ], select );
+        }
+        select = _mm256_slli_epi16( x, 2 );
+        for( size_t h = 0; h < 4; ++h )
+        {
+            r[ h ] = _mm256_blendv_epi8( r[ 2 * h ], r[ 2 * h + 1 ], select );
+        }
+        select = _mm256_slli_epi16( x, 1 );
+        for( size_t h = 0; h < 2; ++h )
+        {
+            r[ h ] = _mm256_blendv_epi8( r[ 2 * h ], r[ 2 * h + 1 ], select );
+        }
+        return _mm256_blendv_epi8( r[ 0 ], r[ 1 ], x );
+    }
+
+    static inline Vec Substitute( Vec x ) noexcept
+    {
+        return Lookup( SBOX_ROWS, x );
+    }
+
+    static inline Vec InverseSubstitute( Vec x ) noexcept
+    {
+        return Lookup( INVERSE_SBOX_ROWS, x );
+    }
+
+    template < uint8_t c >
+    static inline Vec Mul( Vec x ) noexcept
+    {
+        constexpr uint64_t MATRIX = MulMatrix( c );
+        return _mm256_gf2p8affine_epi64_epi8(
+            x, _mm256_set1_epi64x( static_cast< long long >( MATRIX ) ), 0 );
+    }
+};
+
+} // namespace
+
+void kuznyechik::x86_64::EncryptBlocksAvx2( const Block* keys,
+                                            const uint8_t* in,
+                                            uint8_t* out,
+                                            size_t count ) noexcept
+{
+    ProcessBlocksSliced< Avx2Ops, true >( keys, in, out, count );
+}
+
+void kuznyechik::x86_64::DecryptBlocksAvx2( const Block* keys,
+                                            const uint8_t* in,
+                                            uint8_t* out,
+                                            size_t count ) noexcept
+{
+    ProcessBlocksSliced< Avx2Ops, false >( keys, in, out, count );
+}
+
+void kuznyechik::x86_64::EncryptBlocksMultiKeyAvx2( const Block* const* keys,
+                                                    const uint8_t* in,
+                                                    uint8_t* out,
+                                                    size_t count ) noexcept
+{
+    EncryptBlocksSlicedMultiKey< Avx2Ops >( keys, in, out, count );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
@@ -0,0 +1,148 @@
+#include <core/util/secure_zero.hpp>
+#include "kuznyechik_kernel.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx512f,avx512bw,avx512vbmi,gfni" )
+// Some AVX-512 intrinsics pass a deliberately undefined source operand, which GCC
+// reports as uninitialized once they are inlined.
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#    include <immintrin.h>
+#    include "kuznyechik_sliced.h"
+
+using namespace crypt_gost::core::cipher::kernel;
+
+namespace
+{
+
+// Byte j of 64 blocks.
+struct Avx512Ops
+{
+    using Vec = __m512i;
+    static constexpr size_t WIDTH = 64;
+    static constexpr size_t MIN_PADDED_BLOCKS = 12;
+
+    static inline Vec Load( const uint8_t* ptr ) noexcept
+    {
+        return _mm512_loadu_si512( ptr );
+    }
+
+    static inline void Store( uint8_t* ptr, Vec value ) noexcept
+    {
+        _mm512_storeu_si512( ptr, value );
+    }
+
+    static inline Vec Broadcast( uint8_t value ) noexcept
+    {
+        return _mm512_set1_epi8( static_cast< char >( value ) );
+    }
+
+    static inline Vec Xor( Vec a, Vec b ) noexcept
+    {
+        return _mm512_xor_si512( a, b );
+    }
+
+    template < size_t bytes >
+    static inline Vec UnpackLo( Vec a, Vec b ) noexcept
+    {
+        if constexpr( bytes == 1 )
+        {
+            return _mm512_unpacklo_epi8( a, b );
+        }
+        else if constexpr( bytes == 2 )
+        {
+            return _mm512_unpacklo_epi16( a, b );
+        }
+        else if constexpr( bytes == 4 )
+        {
+            return _mm512_unpacklo_epi32( a, b );
+        }
+        else
+        {
+            return _mm512_unpacklo_epi64( a, b );
+        }
+    }
+
+    template < size_t bytes >
+    static inline Vec UnpackHi( Vec a, Vec b ) noexcept
+    {
+        if constexpr( bytes == 1 )
+        {
+            return _mm512_unpackhi_epi8( a, b );
+        }
+        else if constexpr( bytes == 2 )
+        {
+            return _mm512_unpackhi_epi16( a, b );
+        }
+        else if constexpr( bytes == 4 )
+        {
+            return _mm512_unpackhi_epi32( a, b );
+        }
+        else
+        {
+            return _mm512_unpackhi_epi64( a, b );
+        }
+    }
+
+    // Two 128-entry permutations cover the S-box, the top bit of the index selects between
+    // them.
+    static inline Vec Lookup( const uint8_t* sbox, Vec x ) noexcept
+    {
+        Vec low = _mm512_permutex2var_epi8( _mm512_loadu_si512( sbox ), x,
+                                            _mm512_loadu_si512( sbox + 64 ) );
+        Vec high = _mm512_permutex2var_epi8( _mm512_loadu_si512( sbox + 128 ), x,
+                                             _mm512_loadu_si512( sbox + 192 ) );
+        return _mm512_mask_blend_epi8( _mm512_movepi8_mask( x ), low, high );
+    }
+
+    static inline Vec Substitute( Vec x ) noexcept
+    {
+        return Lookup( kuznyechik::PI, x );
+    }
+
+    static inline Vec InverseSubstitute( Vec x ) noexcept
+    {
+        return Lookup( kuznyechik::INVERSE_PI.bytes, x );
+    }
+
+    template < uint8_t c >
+    static inline Vec Mul( Vec x ) noexcept
+    {
+        constexpr uint64_t MATRIX = MulMatrix( c );
+        return _mm512_gf2p8affine_epi64_epi8(
+            x, _mm512_set1_epi64( static_cast< long long >( MATRIX ) ), 0 );
+    }
+};
+
+} // namespace
+
+void kuznyechik::x86_64::EncryptBlocksAvx512( const Block* keys,
+                                              const uint8_t* in,
+                                              uint8_t* out,
+                                              size_t count ) noexcept
+{
+    ProcessBlocksSliced< Avx512Ops, true >( keys, in, out, count );
+}
+
+void kuznyechik::x86_64::DecryptBlocksAvx512( const Block* keys,
+                                              const uint8_t* in,
+                                              uint8_t* out,
+                                              size_t count ) noexcept
+{
+    ProcessBlocksSliced< Avx512Ops, false >( keys, in, out, count );
+}
+
+void kuznyechik::x86_64::EncryptBlocksMultiKeyAvx512( const Block* const* keys,
+                                                      const uint8_t* in,
+                                                      uint8_t* out,
+                                                      size_t count ) noexcept
+{
+    EncryptBlocksSlicedMultiKey< Avx512Ops >( keys, in, out, count );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/pi.hpp>
+#include <core/cpu/dispatch.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+namespace kernel
+{
+
+namespace kuznyechik
+{
+
+using Block = Kuznyechik::Block;
+
+// Nonlinear bijection pi.
+using cipher::PI;
+
+struct Sbox
+{
+    uint8_t bytes[ 256 ];
+};
+
+constexpr Sbox InvertPi() noexcept
+{
+    Sbox ret{};
+    for( size_t b = 0; b < 256; ++b )
+    {
+        ret.bytes[ PI[ b ] ] = static_cast< uint8_t >( b );
+    }
+    return ret;
+}
+
+// pi^-1.
+inline constexpr Sbox INVERSE_PI = InvertPi();
+
+// Coefficients of linear function l, for the first to the last byte.
+inline constexpr uint8_t L_COEFFICIENTS[ Kuznyechik::BLOCK_SIZE ] = {
+    148, 32, 133, 16, 194, 192, 1, 251, 1, 192, 194, 16, 133, 32, 148, 1
+};
+
+// Multiplication in GF(2^8) modulo x^8 + x^7 + x^6 + x + 1.
+constexpr uint8_t GfMul( uint8_t a, uint8_t b ) noexcept
+{
+    constexpr unsigned POLYNOMIAL = 0x1C3;
+    unsigned x = a;
+    unsigned ret = 0;
+    while( b != 0 )
+    {
+        if( ( b & 1 ) != 0 )
+        {
+            ret ^= x;
+        }
+        x <<= 1;
+        if( ( x & 0x100 ) != 0 )
+        {
+            x ^= POLYNOMIAL;
+        }
+        b >>= 1;
+    }
+    return static_cast< uint8_t >( ret );
+}
+
+/**
+ * @brief Encrypt \p count consecutive blocks with ten round keys.
+ */
+using EncryptBlocksFn = void ( * )( const Block* keys,
+                                    const uint8_t* in,
+                                    uint8_t* out,
+                                    size_t count );
+
+/**
+ * @brief Decrypt \p count consecutive blocks with ten round keys of decryption, where the inner
+ * ones are transformed by L^-1.
+ */
+using DecryptBlocksFn = EncryptBlocksFn;
+
+/**
+ * @brief Encrypt \p count consecutive blocks, block i with the ten round keys \p keys[ i ].
+ */
+using EncryptBlocksMultiKeyFn = void ( * )( const Block* const* keys,
+                                            const uint8_t* in,
+                                            uint8_t* out,
+                                            size_t count );
+
+namespace generic
+{
+
+// One block at a time with L( S( x ) ) lookup tables.
+void EncryptBlocks( const Block* keys, const uint8_t* in, uint8_t* out, size_t count ) noexcept;
+
+// One block at a time with L^-1( S^-1( x ) ) lookup tables.
+void DecryptBlocks( const Block* keys, const uint8_t* in, uint8_t* out, size_t count ) noexcept;
+
+void EncryptBlocksMultiKey( const Block* const* keys,
+                            const uint8_t* in,
+                            uint8_t* out,
+                            size_t count ) noexcept;
+
+} // namespace generic
+
+#if defined( __x86_64__ )
+
+namespace x86_64
+{
+
+void EncryptBlocksAvx2( const Block* keys,
+                        const uint8_t* in,
+                        uint8_t* out,
+                        size_t count ) noexcept;
+
+void EncryptBlocksAvx512( const Block* keys,
+                          const uint8_t* in,
+                          uint8_t* out,
+                          size_t count ) noexcept;
+
+void DecryptBlocksAvx2( const Block* keys,
+                        const uint8_t* in,
+                        uint8_t* out,
+                        size_t count ) noexcept;
+
+void DecryptBlocksAvx512( const Block* keys,
+                          const uint8_t* in,
+                          uint8_t* out,
+                          size_t count ) noexcept;
+
+void EncryptBlocksMultiKeyAvx2( const Block* const* keys,
+                                const uint8_t* in,
+                                uint8_t* out,
+                                size_t count ) noexcept;
+
+void EncryptBlocksMultiKeyAvx512( const Block* const* keys,
+                                  const uint8_t* in,
+                                  uint8_t* out,
+                                  size_t count ) noexcept;
+
+} // namespace x86_64
+
+#endif // __x86_64__
+
+cpu::Dispatcher< EncryptBlocksFn >& EncryptBlocksDispatcher() noexcept;
+cpu::Dispatcher< DecryptBlocksFn >& DecryptBlocksDispatcher() noexcept;
+cpu::Dispatcher< EncryptBlocksMultiKeyFn >& EncryptBlocksMultiKeyDispatcher() noexcept;
+
+} // namespace kuznyechik
+
+} // namespace kernel
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
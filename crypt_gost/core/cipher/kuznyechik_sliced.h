@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstring>
+#include <utility>
+#include <core/util/secure_zero.hpp>
+#include "kuznyechik_kernel.h"
+
+// Byte-sliced Kuznyechik shared by the vector kernels. Ops provides the vector type of
+// Ops::WIDTH bytes and the operations on it, the including file compiles the algorithm for
+// its own instruction set, so everything here has internal linkage.
+//
+// A batch of Ops::WIDTH blocks is transposed into 16 vectors, vector j holding byte j of
+// every block. S is then a bytewise lookup, and L = R^16 is computed on whole vectors:
+// R puts l( x ) in front and shifts the other bytes, which only renames vectors, so the cost
+// of L is 16 evaluations of l, each with 7 multiplications by constants thanks to symmetric
+// coefficients. Decryption runs the same way with S^-1 and R^-1, which shifts the other way.
+// Round keys are broadcast to every block, or, when each block has its own key, sliced the
+// same way as the blocks.
+
+namespace
+{
+
+using namespace crypt_gost::core::cipher::kernel::kuznyechik;
+
+constexpr size_t BLOCK_SIZE = crypt_gost::core::cipher::Kuznyechik::BLOCK_SIZE;
+constexpr size_t ROUND_KEY_COUNT = crypt_gost::core::cipher::Kuznyechik::ROUND_KEY_COUNT;
+
+// Unpacking network leaves byte j of the rows in vector BIT_REVERSE[ j ] and vice versa.
+constexpr size_t BIT_REVERSE[ BLOCK_SIZE ] = { 0, 8, 4, 12, 2, 10, 6, 14,
+                                               1, 9, 5, 13, 3, 11, 7, 15 };
+
+// Multiplication by c is linear over GF(2), so it is a single GF2P8AFFINEQB with the bit
+// matrix of c. Byte 7 - i of the matrix selects the bits of x, whose parity is bit i of
+// the product.
+constexpr uint64_t MulMatrix( uint8_t c ) noexcept
+{
+    uint64_t ret = 0;
+    for( size_t i = 0; i < 8; ++i )
+    {
+        uint64_t row = 0;
+        for( size_t k = 0; k < 8; ++k )
+        {
+            uint8_t product = GfMul( c, static_cast< uint8_t >( 1 << k ) );
+            row |= static_cast< uint64_t >( ( product >> i ) & 1 ) << k;
+        }
+        ret |= row << ( 8 * ( 7 - i ) );
+    }
+    return ret;
+}
+
+template < typename Ops, size_t bytes >
+inline void TransposeStage( typename Ops::Vec* v ) noexcept
+{
+    typename Ops::Vec t[ BLOCK_SIZE ];
+    for( size_t i = 0; i < BLOCK_SIZE / 2; ++i )
+    {
+        t[ i ] = Ops::template UnpackLo< bytes >( v[ 2 * i ], v[ 2 * i + 1 ] );
+        t[ i + BLOCK_SIZE / 2 ] = Ops::template UnpackHi< bytes >( v[ 2 * i ], v[ 2 * i + 1 ] );
+    }
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        v[ i ] = t[ i ];
+    }
+}
+
+// 16 x 16 byte transposition in every 128-bit lane.
+template < typename Ops >
+inline void Transpose( typename Ops::Vec* v ) noexcept
+{
+    TransposeStage< Ops, 1 >( v );
+    TransposeStage< Ops, 2 >( v );
+    TransposeStage< Ops, 4 >( v );
+    TransposeStage< Ops, 8 >( v );
+}
+
+// One application of R. After s applications byte k of the block is in v[ ( k - s ) mod 16 ],
+// and the vector of the byte shifted out receives l. Byte 0 was produced by the previous
+// step, so its term is added last and the other terms are computed meanwhile.
+template < typename Ops, size_t s >
+inline void StepR( typename Ops::Vec* v ) noexcept
+{
+    auto at = [ v ]( size_t k ) -> typename Ops::Vec& {
+        return v[ ( k + BLOCK_SIZE - s ) % BLOCK_SIZE ];
+    };
+    auto a = Ops::Xor( Ops::template Mul< 32 >( Ops::Xor( at( 1 ), at( 13 ) ) ),
+                       Ops::template Mul< 133 >( Ops::Xor( at( 2 ), at( 12 ) ) ) );
+    auto b = Ops::Xor( Ops::template Mul< 16 >( Ops::Xor( at( 3 ), at( 11 ) ) ),
+                       Ops::template Mul< 194 >( Ops::Xor( at( 4 ), at( 10 ) ) ) );
+    auto c = Ops::Xor( Ops::template Mul< 192 >( Ops::Xor( at( 5 ), at( 9 ) ) ),
+                       Ops::template Mul< 251 >( at( 7 ) ) );
+    auto d = Ops::Xor( Ops::Xor( at( 6 ), at( 8 ) ), at( 15 ) );
+    auto sum = Ops::Xor( Ops::Xor( a, b ), Ops::Xor( c, d ) );
+    at( 15 ) = Ops::Xor( sum, Ops::template Mul< 148 >( Ops::Xor( at( 0 ), at( 14 ) ) ) );
+}
+
+template < typename Ops, size_t... s >
+inline void TransformL( typename Ops::Vec* v, std::index_sequence< s... > ) noexcept
+{
+    ( StepR< Ops, s >( v ), ... );
+}
+
+// One application of R^-1, which moves byte 0 to the end and replaces it by l of the bytes
+// 1..15, 0. After s applications byte k is in v[ ( k + s ) mod 16 ], and the last byte of the
+// previous step is multiplied last.
+template < typename Ops, size_t s >
+inline void StepInverseR( typename Ops::Vec* v ) noexcept
+{
+    auto at = [ v ]( size_t k ) -> typename Ops::Vec& {
+        return v[ ( k + s ) % BLOCK_SIZE ];
+    };
+    auto a = Ops::Xor( Ops::template Mul< 32 >( Ops::Xor( at( 2 ), at( 14 ) ) ),
+                       Ops::template Mul< 133 >( Ops::Xor( at( 3 ), at( 13 ) ) ) );
+    auto b = Ops::Xor( Ops::template Mul< 16 >( Ops::Xor( at( 4 ), at( 12 ) ) ),
+                       Ops::template Mul< 194 >( Ops::Xor( at( 5 ), at( 11 ) ) ) );
+    auto c = Ops::Xor( Ops::template Mul< 192 >( Ops::Xor( at( 6 ), at( 10 ) ) ),
+                       Ops::template Mul< 251 >( at( 8 ) ) );
+    auto d = Ops::Xor( Ops::Xor( at( 7 ), at( 9 ) ), at( 0 ) );
+    auto sum = Ops::Xor( Ops::Xor( a, b ), Ops::Xor( c, d ) );
+    at( 0 ) = Ops::Xor( sum, Ops::template Mul< 148 >( Ops::Xor( at( 1 ), at( 15 ) ) ) );
+}
+
+template < typename Ops, size_t... s >
+inline void TransformInverseL( typename Ops::Vec* v, std::index_sequence< s... > ) noexcept
+{
+    ( StepInverseR< Ops, s >( v ), ... );
+}
+
+// Vector j receives byte j of Ops::WIDTH consecutive blocks.
+template < typename Ops >
+inline void LoadSliced( const uint8_t* in, typename Ops::Vec* v ) noexcept
+{
+    typename Ops::Vec rows[ BLOCK_SIZE ];
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        rows[ i ] = Ops::Load( in + i * Ops::WIDTH );
+    }
+    Transpose< Ops >( rows );
+    for( size_t j = 0; j < BLOCK_SIZE; ++j )
+    {
+        v[ j ] = rows[ BIT_REVERSE[ j ] ];
+    }
+}
+
+template < typename Ops >
+inline void StoreSliced( typename Ops::Vec* v, uint8_t* out ) noexcept
+{
+    Transpose< Ops >( v );
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        Ops::Store( out + BIT_REVERSE[ i ] * Ops::WIDTH, v[ i ] );
+    }
+}
+
+// Round keys shared by all blocks of a batch.
+template < typename Ops >
+struct SharedKeys
+{
+    const Block* keys;
+
+    inline void Add( typename Ops::Vec* v, size_t round ) const noexcept
+    {
+        uint8_t bytes[ BLOCK_SIZE ];
+        std::memcpy( bytes, keys + round, BLOCK_SIZE );
+        for( size_t j = 0; j < BLOCK_SIZE; ++j )
+        {
+            v[ j ] = Ops::Xor( v[ j ], Ops::Broadcast( bytes[ j ] ) );
+        }
+    }
+};
+
+// Round keys of every block, gathered into \p buffer of a batch and sliced as the blocks.
+template < typename Ops >
+struct LaneKeys
+{
+    const Block* const* keys;
+    uint8_t* buffer;
+
+    inline void Add( typename Ops::Vec* v, size_t round ) const noexcept
+    {
+        for( size_t b = 0; b < Ops::WIDTH; ++b )
+        {
+            std::memcpy( buffer + b * BLOCK_SIZE, keys[ b ] + round, BLOCK_SIZE );
+        }
+        typename Ops::Vec k[ BLOCK_SIZE ];
+        LoadSliced< Ops >( buffer, k );
+        for( size_t j = 0; j < BLOCK_SIZE; ++j )
+        {
+            v[ j ] = Ops::Xor( v[ j ], k[ j ] );
+        }
+    }
+};
+
+// Ops::WIDTH consecutive blocks. Decryption keys are those of generic::DecryptBlocks: the
+// first is added before L^-1, the inner ones after it, and the last after S^-1.
+template < typename Ops, bool encrypt, typename Keys >
+inline void ProcessBatch( const Keys& keys, const uint8_t* in, uint8_t* out ) noexcept
+{
+    using Vec = typename Ops::Vec;
+    constexpr auto STEPS = std::make_index_sequence< BLOCK_SIZE >();
+    Vec v[ BLOCK_SIZE ];
+    LoadSliced< Ops >( in, v );
+
+    if constexpr( encrypt )
+    {
+        for( size_t round = 0; round + 1 < ROUND_KEY_COUNT; ++round )
+        {
+            keys.Add( v, round );
+            for( size_t j = 0; j < BLOCK_SIZE; ++j )
+            {
+                v[ j ] = Ops::Substitute( v[ j ] );
+            }
+            TransformL< Ops >( v, STEPS );
+        }
+        keys.Add( v, ROUND_KEY_COUNT - 1 );
+    }
+    else
+    {
+        keys.Add( v, ROUND_KEY_COUNT - 1 );
+        TransformInverseL< Ops >( v, STEPS );
+        for( size_t round = ROUND_KEY_COUNT - 2; round > 0; --round )
+        {
+            for( size_t j = 0; j < BLOCK_SIZE; ++j )
+            {
+                v[ j ] = Ops::InverseSubstitute( v[ j ] );
+            }
+            TransformInverseL< Ops >( v, STEPS );
+            keys.Add( v, round );
+        }
+        for( size_t j = 0; j < BLOCK_SIZE; ++j )
+        {
+            v[ j ] = Ops::InverseSubstitute( v[ j ] );
+        }
+        keys.Add( v, 0 );
+    }
+
+    StoreSliced< Ops >( v, out );
+}
+
+// Whole batches, then the tail either padded to a batch or, when it is too short to pay
+// off, one block at a time.
+template < typename Ops, bool encrypt >
+void ProcessBlocksSliced( const Block* keys, const uint8_t* in, uint8_t* out, size_t count )
+{
+    constexpr size_t BATCH_SIZE = Ops::WIDTH * BLOCK_SIZE;
+    for( ; count >= Ops::WIDTH; count -= Ops::WIDTH )
+    {
+        ProcessBatch< Ops, encrypt >( SharedKeys< Ops >{ keys }, in, out );
+        in += BATCH_SIZE;
+        out += BATCH_SIZE;
+    }
+    if( count >= Ops::MIN_PADDED_BLOCKS )
+    {
+        alignas( 64 ) uint8_t batch[ BATCH_SIZE ] = {};
+        std::memcpy( batch, in, count * BLOCK_SIZE );
+        ProcessBatch< Ops, encrypt >( SharedKeys< Ops >{ keys }, batch, batch );
+        std::memcpy( out, batch, count * BLOCK_SIZE );
+    }
+    else if( count > 0 )
+    {
+        if constexpr( encrypt )
+        {
+            generic::EncryptBlocks( keys, in, out, count );
+        }
+        else
+        {
+            generic::DecryptBlocks( keys, in, out, count );
+        }
+    }
+}
+
+// Block i with round keys keys[ i ]. A batch under one key is processed as by
+// ProcessBlocksSliced, the keys of a short batch are padded with the first ones, and their
+// buffer is wiped since it holds round keys.
+template < typename Ops >
+void EncryptBlocksSlicedMultiKey( const Block* const* keys,
+                                  const uint8_t* in,
+                                  uint8_t* out,
+                                  size_t count )
+{
+    constexpr size_t BATCH_SIZE = Ops::WIDTH * BLOCK_SIZE;
+    alignas( 64 ) uint8_t buffer[ BATCH_SIZE ];
+    for( ; count >= Ops::WIDTH; count -= Ops::WIDTH )
+    {
+        bool shared = true;
+        for( size_t i = 1; i < Ops::WIDTH; ++i )
+        {
+            shared = shared && keys[ i ] == keys[ 0 ];
+        }
+        if( shared )
+        {
+            ProcessBatch< Ops, true >( SharedKeys< Ops >{ keys[ 0 ] }, in, out );
+        }
+        else
+        {
+            ProcessBatch< Ops, true >( LaneKeys< Ops >{ keys, buffer }, in, out );
+        }
+        keys += Ops::WIDTH;
+        in += BATCH_SIZE;
+        out += BATCH_SIZE;
+    }
+    if( count >= Ops::MIN_PADDED_BLOCKS )
+    {
+        const Block* padded[ Ops::WIDTH ];
+        for( size_t i = 0; i < Ops::WIDTH; ++i )
+        {
+            padded[ i ] = keys[ i < count ? i : 0 ];
+        }
+        alignas( 64 ) uint8_t batch[ BATCH_SIZE ] = {};
+        std::memcpy( batch, in, count * BLOCK_SIZE );
+        ProcessBatch< Ops, true >( LaneKeys< Ops >{ padded, buffer }, batch, batch );
+        std::memcpy( out, batch, count * BLOCK_SIZE );
+    }
+    else
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            generic::EncryptBlocks( keys[ i ], in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, 1 );
+        }
+    }
+    crypt_gost::core::util::SecureZero( buffer, sizeof( buffer ) );
+}
+
+} // namespace
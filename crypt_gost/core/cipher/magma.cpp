@@ -0,0 +1,199 @@
+#include <cstring>
+#include <core/cipher/magma.hpp>
+#include <core/util/secure_zero.hpp>
+#include "magma_kernel.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+using namespace crypt_gost::core::cipher::kernel;
+
+namespace
+{
+
+constexpr size_t BLOCK_SIZE = Magma::BLOCK_SIZE;
+constexpr size_t ROUND_COUNT = Magma::ROUND_COUNT;
+constexpr size_t INTERLEAVE = 4;
+
+constexpr uint32_t RotateLeft11( uint32_t x ) noexcept
+{
+    return ( x << 11 ) | ( x >> 21 );
+}
+
+/**
+ * @brief Entry [ j ][ b ] is g[ 0 ] of a word with byte b at position j and zeros elsewhere,
+ * counting from the least significant byte.
+ */
+struct Tables
+{
+    uint32_t g[ 4 ][ 256 ];
+};
+
+constexpr Tables MakeTables() noexcept
+{
+    Tables ret{};
+    for( size_t j = 0; j < 4; ++j )
+    {
+        for( size_t b = 0; b < 256; ++b )
+        {
+            uint32_t s = static_cast< uint32_t >( magma::PI[ 2 * j + 1 ][ b >> 4 ] << 4
+                                                  | magma::PI[ 2 * j ][ b & 15 ] );
+            ret.g[ j ][ b ] = RotateLeft11( s << ( 8 * j ) );
+        }
+    }
+    return ret;
+}
+
+constexpr Tables TABLES = MakeTables();
+
+inline uint32_t RoundFunction( uint32_t a, uint32_t key ) noexcept
+{
+    uint32_t x = a + key;
+    return TABLES.g[ 0 ][ x & 0xff ] ^ TABLES.g[ 1 ][ ( x >> 8 ) & 0xff ]
+           ^ TABLES.g[ 2 ][ ( x >> 16 ) & 0xff ] ^ TABLES.g[ 3 ][ x >> 24 ];
+}
+
+inline uint32_t LoadWord( const uint8_t* data ) noexcept
+{
+    return static_cast< uint32_t >( data[ 0 ] ) << 24 | static_cast< uint32_t >( data[ 1 ] ) << 16
+           | static_cast< uint32_t >( data[ 2 ] ) << 8 | static_cast< uint32_t >( data[ 3 ] );
+}
+
+inline void StoreWord( uint8_t* data, uint32_t word ) noexcept
+{
+    data[ 0 ] = static_cast< uint8_t >( word >> 24 );
+    data[ 1 ] = static_cast< uint8_t >( word >> 16 );
+    data[ 2 ] = static_cast< uint8_t >( word >> 8 );
+    data[ 3 ] = static_cast< uint8_t >( word );
+}
+
+// Rounds G[ k ]( a1, a0 ) = ( a0, g[ k ]( a0 ) ^ a1 ), the last one without the swap. A block
+// is a chain of dependent lookups, so INTERLEAVE blocks go through the rounds together.
+template < size_t blocks >
+inline void ProcessInterleaved( const uint32_t* keys, const uint8_t* in, uint8_t* out ) noexcept
+{
+    uint32_t a1[ blocks ];
+    uint32_t a0[ blocks ];
+    for( size_t n = 0; n < blocks; ++n )
+    {
+        a1[ n ] = LoadWord( in + n * BLOCK_SIZE );
+        a0[ n ] = LoadWord( in + n * BLOCK_SIZE + 4 );
+    }
+    for( size_t i = 0; i < ROUND_COUNT; i += 2 )
+    {
+        for( size_t n = 0; n < blocks; ++n )
+        {
+            a1[ n ] ^= RoundFunction( a0[ n ], keys[ i ] );
+        }
+        for( size_t n = 0; n < blocks; ++n )
+        {
+            a0[ n ] ^= RoundFunction( a1[ n ], keys[ i + 1 ] );
+        }
+    }
+    for( size_t n = 0; n < blocks; ++n )
+    {
+        StoreWord( out + n * BLOCK_SIZE, a0[ n ] );
+        StoreWord( out + n * BLOCK_SIZE + 4, a1[ n ] );
+    }
+}
+
+} // namespace
+
+Magma::Magma( const uint8_t* key ) noexcept
+    : encryptKeys_()
+    , decryptKeys_()
+{
+    SetKey( key );
+}
+
+Magma::~Magma() noexcept
+{
+    util::SecureZero( encryptKeys_, sizeof( encryptKeys_ ) );
+    util::SecureZero( decryptKeys_, sizeof( decryptKeys_ ) );
+}
+
+// Rounds 1..24 use K_1..K_8 three times, rounds 25..32 use K_8..K_1.
+void Magma::SetKey( const uint8_t* key ) noexcept
+{
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        size_t index = i < 24 ? i % 8 : 7 - i % 8;
+        encryptKeys_[ i ] = LoadWord( key + 4 * index );
+    }
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        decryptKeys_[ i ] = encryptKeys_[ ROUND_COUNT - 1 - i ];
+    }
+}
+
+void Magma::EncryptBlock( const uint8_t* in, uint8_t* out ) const noexcept
+{
+    magma::generic::ProcessBlocks( encryptKeys_, in, out, 1 );
+}
+
+void Magma::DecryptBlock( const uint8_t* in, uint8_t* out ) const noexcept
+{
+    magma::generic::ProcessBlocks( decryptKeys_, in, out, 1 );
+}
+
+void Magma::EncryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+{
+    magma::ProcessBlocksDispatcher().Get()( encryptKeys_, in, out, count );
+}
+
+void Magma::DecryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+{
+    magma::ProcessBlocksDispatcher().Get()( decryptKeys_, in, out, count );
+}
+
+// Consecutive blocks under one key, as an engine fills them for a long message, are passed to
+// the kernel together.
+void Magma::EncryptBlocksMultiKey( const Magma* const* ciphers,
+                                   const uint8_t* in,
+                                   uint8_t* out,
+                                   size_t count ) noexcept
+{
+    size_t first = 0;
+    while( first < count )
+    {
+        size_t last = first + 1;
+        while( last < count && ciphers[ last ] == ciphers[ first ] )
+        {
+            ++last;
+        }
+        ciphers[ first ]->EncryptBlocks(
+            in + first * BLOCK_SIZE, out + first * BLOCK_SIZE, last - first );
+        first = last;
+    }
+}
+
+void magma::generic::ProcessBlocks( const uint32_t* keys,
+                                    const uint8_t* in,
+                                    uint8_t* out,
+                                    size_t count ) noexcept
+{
+    for( ; count >= INTERLEAVE; count -= INTERLEAVE )
+    {
+        ProcessInterleaved< INTERLEAVE >( keys, in, out );
+        in += INTERLEAVE * BLOCK_SIZE;
+        out += INTERLEAVE * BLOCK_SIZE;
+    }
+    for( ; count > 0; --count )
+    {
+        ProcessInterleaved< 1 >( keys, in, out );
+        in += BLOCK_SIZE;
+        out += BLOCK_SIZE;
+    }
+}
+
+cpu::Dispatcher< magma::ProcessBlocksFn >& magma::ProcessBlocksDispatcher() noexcept
+{
+    static cpu::Dispatcher< ProcessBlocksFn > dispatcher( generic::ProcessBlocks );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::ProcessBlocksAvx2, cpu::FEATURE_AVX2 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
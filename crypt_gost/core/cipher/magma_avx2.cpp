@@ -0,0 +1,293 @@
+#include <core/util/secure_zero.hpp>
+#include "magma_kernel.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx2" )
+
+#    include <cstring>
+#    include <immintrin.h>
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+using namespace crypt_gost::core::cipher::kernel;
+
+// Byte-sliced Magma. A batch of 32 blocks is transposed into 8 vectors, vector j holding
+// byte j of every block, so a word of the Feistel network is four vectors, one per byte.
+// The key is added with carries propagated between the byte vectors. The 4-bit S-boxes
+// are vpshufb lookups of the nibbles, and their tables are pre-shifted so that the
+// rotation by 11 bits, a shift by 3 with one byte renamed, is folded into the lookups:
+// byte s of g( a ) is assembled from three lookups of bytes s - 1 and s - 2 of a + k.
+
+namespace
+{
+
+using Vec = __m256i;
+
+constexpr size_t BLOCK_SIZE = Magma::BLOCK_SIZE;
+constexpr size_t ROUND_COUNT = Magma::ROUND_COUNT;
+constexpr size_t WIDTH = 32;
+constexpr size_t BATCH_SIZE = WIDTH * BLOCK_SIZE;
+// Shorter tails are faster one block at a time than padded to a batch.
+constexpr size_t MIN_PADDED_BLOCKS = 14;
+
+// Unpacking network leaves word j of the rows in vector BIT_REVERSE[ j ] and vice versa.
+constexpr size_t BIT_REVERSE[ BLOCK_SIZE ] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+
+// 16-entry table for vpshufb, repeated in both 128-bit lanes.
+struct alignas( 32 ) ShuffleTable
+{
+    uint8_t bytes[ 32 ];
+};
+
+/**
+ * @brief Lookups for input byte p of the round function: low and high nibbles, substituted
+ * and shifted to their place in output byte p + 1, and the bits of the high nibble which
+ * reach output byte p + 2.
+ */
+struct SboxTables
+{
+    ShuffleTable low[ 4 ];
+    ShuffleTable high[ 4 ];
+    ShuffleTable highCarry[ 4 ];
+    // Bytes of a block grouped by position in every 128-bit lane, and back.
+    ShuffleTable group;
+    ShuffleTable ungroup;
+};
+
+constexpr SboxTables MakeSboxTables() noexcept
+{
+    SboxTables ret{};
+    for( size_t i = 0; i < 32; ++i )
+    {
+        size_t n = i % 16;
+        for( size_t p = 0; p < 4; ++p )
+        {
+            ret.low[ p ].bytes[ i ] = static_cast< uint8_t >( magma::PI[ 2 * p ][ n ] << 3 );
+            ret.high[ p ].bytes[ i ] =
+                static_cast< uint8_t >( magma::PI[ 2 * p + 1 ][ n ] << 7 );
+            ret.highCarry[ p ].bytes[ i ] = magma::PI[ 2 * p + 1 ][ n ] >> 1;
+        }
+        ret.group.bytes[ i ] = static_cast< uint8_t >( n % 2 * 8 + n / 2 );
+        ret.ungroup.bytes[ i ] = static_cast< uint8_t >( n % 8 * 2 + n / 8 );
+    }
+    return ret;
+}
+
+constexpr SboxTables SBOX_TABLES = MakeSboxTables();
+
+inline Vec Table( const ShuffleTable& table ) noexcept
+{
+    return _mm256_load_si256( reinterpret_cast< const Vec* >( table.bytes ) );
+}
+
+inline Vec Broadcast( uint8_t value ) noexcept
+{
+    return _mm256_set1_epi8( static_cast< char >( value ) );
+}
+
+/**
+ * @brief Round key bytes, and the bounds whose excess in a signed comparison of a biased
+ * byte signals a carry out of the addition.
+ */
+struct RoundKey
+{
+    Vec bytes[ 4 ];
+    Vec bounds[ 4 ];
+};
+
+void ExpandKeys( const uint32_t* keys, RoundKey* expanded ) noexcept
+{
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        for( size_t s = 0; s < 4; ++s )
+        {
+            uint8_t byte = static_cast< uint8_t >( keys[ i ] >> ( 8 * s ) );
+            uint8_t bound = static_cast< uint8_t >( ( 0xff - byte ) ^ 0x80 );
+            expanded[ i ].bytes[ s ] = Broadcast( byte );
+            expanded[ i ].bounds[ s ] = Broadcast( bound );
+        }
+    }
+}
+
+template < size_t bytes >
+inline Vec UnpackLo( Vec a, Vec b ) noexcept
+{
+    if constexpr( bytes == 2 )
+    {
+        return _mm256_unpacklo_epi16( a, b );
+    }
+    else if constexpr( bytes == 4 )
+    {
+        return _mm256_unpacklo_epi32( a, b );
+    }
+    else
+    {
+        return _mm256_unpacklo_epi64( a, b );
+    }
+}
+
+template < size_t bytes >
+inline Vec UnpackHi( Vec a, Vec b ) noexcept
+{
+    if constexpr( bytes == 2 )
+    {
+        return _mm256_unpackhi_epi16( a, b );
+    }
+    else if constexpr( bytes == 4 )
+    {
+        return _mm256_unpackhi_epi32( a, b );
+    }
+    else
+    {
+        return _mm256_unpackhi_epi64( a, b );
+    }
+}
+
+template < size_t bytes >
+inline void TransposeStage( Vec* v ) noexcept
+{
+    Vec t[ BLOCK_SIZE ];
+    for( size_t i = 0; i < BLOCK_SIZE / 2; ++i )
+    {
+        t[ i ] = UnpackLo< bytes >( v[ 2 * i ], v[ 2 * i + 1 ] );
+        t[ i + BLOCK_SIZE / 2 ] = UnpackHi< bytes >( v[ 2 * i ], v[ 2 * i + 1 ] );
+    }
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        v[ i ] = t[ i ];
+    }
+}
+
+// 8 x 8 transposition of 16-bit words in every 128-bit lane.
+inline void Transpose( Vec* v ) noexcept
+{
+    TransposeStage< 2 >( v );
+    TransposeStage< 4 >( v );
+    TransposeStage< 8 >( v );
+}
+
+// a + k modulo 2^32, byte s of the words in vector s.
+inline void AddKey( const Vec* a, const RoundKey& key, Vec* sum ) noexcept
+{
+    const Vec bias = Broadcast( 0x80 );
+    const Vec ones = Broadcast( 0xff );
+    Vec carry = _mm256_setzero_si256();
+    for( size_t s = 0; s < 4; ++s )
+    {
+        Vec x = _mm256_add_epi8( a[ s ], key.bytes[ s ] );
+        sum[ s ] = _mm256_sub_epi8( x, carry );
+        if( s < 3 )
+        {
+            Vec overflow = _mm256_cmpgt_epi8( _mm256_xor_si256( a[ s ], bias ), key.bounds[ s ] );
+            carry = _mm256_or_si256(
+                overflow, _mm256_and_si256( carry, _mm256_cmpeq_epi8( x, ones ) ) );
+        }
+    }
+}
+
+// b ^= g[ k ]( a ).
+inline void Round( const Vec* a, Vec* b, const RoundKey& key ) noexcept
+{
+    const Vec mask = Broadcast( 0x0f );
+    Vec sum[ 4 ];
+    AddKey( a, key, sum );
+    Vec low[ 4 ];
+    Vec high[ 4 ];
+    for( size_t p = 0; p < 4; ++p )
+    {
+        low[ p ] = _mm256_and_si256( sum[ p ], mask );
+        high[ p ] = _mm256_and_si256( _mm256_srli_epi16( sum[ p ], 4 ), mask );
+    }
+    for( size_t s = 0; s < 4; ++s )
+    {
+        size_t p = ( s + 3 ) % 4;
+        size_t q = ( s + 2 ) % 4;
+        Vec g = _mm256_xor_si256(
+            _mm256_shuffle_epi8( Table( SBOX_TABLES.low[ p ] ), low[ p ] ),
+            _mm256_shuffle_epi8( Table( SBOX_TABLES.high[ p ] ), high[ p ] ) );
+        Vec carried = _mm256_shuffle_epi8( Table( SBOX_TABLES.highCarry[ q ] ), high[ q ] );
+        b[ s ] = _mm256_xor_si256( b[ s ], _mm256_xor_si256( g, carried ) );
+    }
+}
+
+// WIDTH consecutive blocks.
+void ProcessBatch( const RoundKey* keys, const uint8_t* in, uint8_t* out ) noexcept
+{
+    Vec rows[ BLOCK_SIZE ];
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        rows[ i ] = _mm256_shuffle_epi8(
+            _mm256_loadu_si256( reinterpret_cast< const Vec* >( in + i * 32 ) ),
+            Table( SBOX_TABLES.group ) );
+    }
+    Transpose( rows );
+
+    // Byte s of a word is byte 3 - s of its half of the block.
+    Vec a1[ 4 ];
+    Vec a0[ 4 ];
+    for( size_t s = 0; s < 4; ++s )
+    {
+        a1[ s ] = rows[ BIT_REVERSE[ 3 - s ] ];
+        a0[ s ] = rows[ BIT_REVERSE[ 7 - s ] ];
+    }
+    for( size_t i = 0; i < ROUND_COUNT; i += 2 )
+    {
+        Round( a0, a1, keys[ i ] );
+        Round( a1, a0, keys[ i + 1 ] );
+    }
+    // The last round does not swap.
+    Vec v[ BLOCK_SIZE ];
+    for( size_t s = 0; s < 4; ++s )
+    {
+        v[ 3 - s ] = a0[ s ];
+        v[ 7 - s ] = a1[ s ];
+    }
+
+    Transpose( v );
+    for( size_t i = 0; i < BLOCK_SIZE; ++i )
+    {
+        _mm256_storeu_si256( reinterpret_cast< Vec* >( out + BIT_REVERSE[ i ] * 32 ),
+                             _mm256_shuffle_epi8( v[ i ], Table( SBOX_TABLES.ungroup ) ) );
+    }
+}
+
+} // namespace
+
+void magma::x86_64::ProcessBlocksAvx2( const uint32_t* keys,
+                                       const uint8_t* in,
+                                       uint8_t* out,
+                                       size_t count ) noexcept
+{
+    if( count < MIN_PADDED_BLOCKS )
+    {
+        generic::ProcessBlocks( keys, in, out, count );
+        return;
+    }
+
+    RoundKey expanded[ ROUND_COUNT ];
+    ExpandKeys( keys, expanded );
+    for( ; count >= WIDTH; count -= WIDTH )
+    {
+        ProcessBatch( expanded, in, out );
+        in += BATCH_SIZE;
+        out += BATCH_SIZE;
+    }
+    if( count >= MIN_PADDED_BLOCKS )
+    {
+        alignas( 32 ) uint8_t batch[ BATCH_SIZE ] = {};
+        std::memcpy( batch, in, count * BLOCK_SIZE );
+        ProcessBatch( expanded, batch, batch );
+        std::memcpy( out, batch, count * BLOCK_SIZE );
+    }
+    else if( count > 0 )
+    {
+        generic::ProcessBlocks( keys, in, out, count );
+    }
+    util::SecureZero( expanded, sizeof( expanded ) );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cipher/magma.hpp>
+#include <core/cpu/dispatch.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+namespace kernel
+{
+
+namespace magma
+{
+
+// Substitutions pi_0 .. pi_7, pi_i replaces bits 4i .. 4i + 3 of the word.
+inline constexpr uint8_t PI[ 8 ][ 16 ] = {
+    { 12, 4, 6, 2, 10, 5, 11, 9, 14, 8, 13, 7, 0, 3, 15, 1 },
+    { 6, 8, 2, 3, 9, 10, 5, 12, 1, 14, 4, 7, 11, 13, 0, 15 },
+    { 11, 3, 5, 8, 2, 15, 10, 13, 14, 1, 7, 4, 12, 9, 6, 0 },
+    { 12, 8, 2, 1, 13, 4, 15, 6, 7, 0, 10, 5, 3, 14, 9, 11 },
+    { 7, 15, 5, 10, 8, 1, 6, 13, 0, 9, 3, 14, 11, 4, 2, 12 },
+    { 5, 13, 15, 6, 9, 2, 12, 10, 11, 7, 8, 1, 4, 3, 14, 0 },
+    { 8, 14, 2, 5, 6, 9, 1, 12, 15, 4, 11, 0, 13, 10, 3, 7 },
+    { 1, 7, 14, 13, 0, 5, 8, 3, 4, 15, 10, 6, 9, 12, 11, 2 },
+};
+
+/**
+ * @brief Run \p count consecutive blocks through 32 rounds with round keys \p keys. The last
+ * round does not swap halves, so with keys in reverse order this decrypts.
+ */
+using ProcessBlocksFn = void ( * )( const uint32_t* keys,
+                                    const uint8_t* in,
+                                    uint8_t* out,
+                                    size_t count );
+
+namespace generic
+{
+
+// One block at a time with merged substitution tables.
+void ProcessBlocks( const uint32_t* keys,
+                    const uint8_t* in,
+                    uint8_t* out,
+                    size_t count ) noexcept;
+
+} // namespace generic
+
+#if defined( __x86_64__ )
+
+namespace x86_64
+{
+
+void ProcessBlocksAvx2( const uint32_t* keys,
+                        const uint8_t* in,
+                        uint8_t* out,
+                        size_t count ) noexcept;
+
+} // namespace x86_64
+
+#endif // __x86_64__
+
+cpu::Dispatcher< ProcessBlocksFn >& ProcessBlocksDispatcher() noexcept;
+
+} // namespace magma
+
+} // namespace kernel
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
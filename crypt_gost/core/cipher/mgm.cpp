@@ -0,0 +1,145 @@
+#include <core/cipher/block_util.hpp>
+#include <core/cipher/mgm.hpp>
+#include "mgm_kernel.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+namespace
+{
+
+// v * h for every 4-bit v, three words of the 131-bit product, least significant first.
+inline void WindowTable128( uint64_t h1, uint64_t h0, uint64_t table[ 16 ][ 3 ] ) noexcept
+{
+    table[ 0 ][ 0 ] = table[ 0 ][ 1 ] = table[ 0 ][ 2 ] = 0;
+    table[ 1 ][ 0 ] = h0;
+    table[ 1 ][ 1 ] = h1;
+    table[ 1 ][ 2 ] = 0;
+    for( size_t v = 2; v < 16; v += 2 )
+    {
+        const uint64_t* half = table[ v / 2 ];
+        table[ v ][ 0 ] = half[ 0 ] << 1;
+        table[ v ][ 1 ] = half[ 1 ] << 1 | half[ 0 ] >> 63;
+        table[ v ][ 2 ] = half[ 2 ] << 1 | half[ 1 ] >> 63;
+        for( size_t i = 0; i < 3; ++i )
+        {
+            table[ v + 1 ][ i ] = table[ v ][ i ] ^ table[ 1 ][ i ];
+        }
+    }
+}
+
+inline void WindowTable64( uint64_t h, uint64_t table[ 16 ][ 2 ] ) noexcept
+{
+    table[ 0 ][ 0 ] = table[ 0 ][ 1 ] = 0;
+    table[ 1 ][ 0 ] = h;
+    table[ 1 ][ 1 ] = 0;
+    for( size_t v = 2; v < 16; v += 2 )
+    {
+        const uint64_t* half = table[ v / 2 ];
+        table[ v ][ 0 ] = half[ 0 ] << 1;
+        table[ v ][ 1 ] = half[ 1 ] << 1 | half[ 0 ] >> 63;
+        table[ v + 1 ][ 0 ] = table[ v ][ 0 ] ^ h;
+        table[ v + 1 ][ 1 ] = table[ v ][ 1 ];
+    }
+}
+
+} // namespace
+
+void mgm::MultiplySum128( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept
+{
+    kernel::mgm::MultiplySum128Dispatcher().Get()( sum, h, x, count );
+}
+
+void mgm::MultiplySum64( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept
+{
+    kernel::mgm::MultiplySum64Dispatcher().Get()( sum, h, x, count );
+}
+
+void kernel::mgm::generic::MultiplySum128( uint8_t* sum,
+                                           const uint8_t* h,
+                                           const uint8_t* x,
+                                           size_t count ) noexcept
+{
+    uint64_t product[ 4 ] = {};
+    for( size_t i = 0; i < count; ++i, h += 16, x += 16 )
+    {
+        uint64_t table[ 16 ][ 3 ];
+        WindowTable128( block::LoadBigEndian64( h ), block::LoadBigEndian64( h + 8 ), table );
+        // Horner's scheme over the nibbles of x, most significant first.
+        uint64_t r[ 4 ] = {};
+        for( size_t j = 0; j < 16; ++j )
+        {
+            for( size_t k = 0; k < 2; ++k )
+            {
+                uint8_t nibble = static_cast< uint8_t >( x[ j ] >> ( 4 - 4 * k ) & 15 );
+                r[ 3 ] = r[ 3 ] << 4 | r[ 2 ] >> 60;
+                r[ 2 ] = ( r[ 2 ] << 4 | r[ 1 ] >> 60 ) ^ table[ nibble ][ 2 ];
+                r[ 1 ] = ( r[ 1 ] << 4 | r[ 0 ] >> 60 ) ^ table[ nibble ][ 1 ];
+                r[ 0 ] = r[ 0 ] << 4 ^ table[ nibble ][ 0 ];
+            }
+        }
+        for( size_t j = 0; j < 4; ++j )
+        {
+            product[ j ] ^= r[ j ];
+        }
+    }
+    uint64_t reduced[ 2 ];
+    Reduce128( product, reduced );
+    block::StoreBigEndian64( sum, block::LoadBigEndian64( sum ) ^ reduced[ 1 ] );
+    block::StoreBigEndian64( sum + 8, block::LoadBigEndian64( sum + 8 ) ^ reduced[ 0 ] );
+}
+
+void kernel::mgm::generic::MultiplySum64( uint8_t* sum,
+                                          const uint8_t* h,
+                                          const uint8_t* x,
+                                          size_t count ) noexcept
+{
+    uint64_t high = 0;
+    uint64_t low = 0;
+    for( size_t i = 0; i < count; ++i, h += 8, x += 8 )
+    {
+        uint64_t table[ 16 ][ 2 ];
+        WindowTable64( block::LoadBigEndian64( h ), table );
+        uint64_t r1 = 0;
+        uint64_t r0 = 0;
+        for( size_t j = 0; j < 8; ++j )
+        {
+            for( size_t k = 0; k < 2; ++k )
+            {
+                uint8_t nibble = static_cast< uint8_t >( x[ j ] >> ( 4 - 4 * k ) & 15 );
+                r1 = ( r1 << 4 | r0 >> 60 ) ^ table[ nibble ][ 1 ];
+                r0 = r0 << 4 ^ table[ nibble ][ 0 ];
+            }
+        }
+        high ^= r1;
+        low ^= r0;
+    }
+    block::StoreBigEndian64( sum, block::LoadBigEndian64( sum ) ^ Reduce64( high, low ) );
+}
+
+cpu::Dispatcher< kernel::mgm::MultiplySumFn >& kernel::mgm::MultiplySum128Dispatcher() noexcept
+{
+    static cpu::Dispatcher< MultiplySumFn > dispatcher( generic::MultiplySum128 );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::MultiplySum128Pclmul,
+                             cpu::FEATURE_PCLMUL | cpu::FEATURE_SSSE3 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< kernel::mgm::MultiplySumFn >& kernel::mgm::MultiplySum64Dispatcher() noexcept
+{
+    static cpu::Dispatcher< MultiplySumFn > dispatcher( generic::MultiplySum64 );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::MultiplySum64Pclmul, cpu::FEATURE_PCLMUL );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cpu/dispatch.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+namespace kernel
+{
+
+namespace mgm
+{
+
+/**
+ * @brief sum ^= h_0 * x_0 ^ ... ^ h_count-1 * x_count-1, where \p sum, \p h and \p x are
+ * big-endian blocks of the field. Products are summed unreduced and reduced once.
+ */
+using MultiplySumFn = void ( * )( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count );
+
+// Reduction of a 256-bit product, least significant word first, modulo
+// x^128 + x^7 + x^2 + x + 1.
+inline void Reduce128( const uint64_t* product, uint64_t* out ) noexcept
+{
+    uint64_t p3 = product[ 3 ];
+    uint64_t p2 = product[ 2 ] ^ ( p3 >> 63 ) ^ ( p3 >> 62 ) ^ ( p3 >> 57 );
+    uint64_t p1 = product[ 1 ] ^ p3 ^ ( p3 << 1 ) ^ ( p3 << 2 ) ^ ( p3 << 7 );
+    out[ 1 ] = p1 ^ ( p2 >> 63 ) ^ ( p2 >> 62 ) ^ ( p2 >> 57 );
+    out[ 0 ] = product[ 0 ] ^ p2 ^ ( p2 << 1 ) ^ ( p2 << 2 ) ^ ( p2 << 7 );
+}
+
+// Reduction of a 128-bit product modulo x^64 + x^4 + x^3 + x + 1.
+inline uint64_t Reduce64( uint64_t high, uint64_t low ) noexcept
+{
+    uint64_t over = ( high >> 63 ) ^ ( high >> 61 ) ^ ( high >> 60 );
+    high ^= over;
+    return low ^ high ^ ( high << 1 ) ^ ( high << 3 ) ^ ( high << 4 );
+}
+
+namespace generic
+{
+
+// Multiples of h by every 4-bit polynomial, product accumulated a nibble of x at a time.
+void MultiplySum128( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept;
+void MultiplySum64( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept;
+
+} // namespace generic
+
+#if defined( __x86_64__ )
+
+namespace x86_64
+{
+
+void MultiplySum128Pclmul( uint8_t* sum,
+                           const uint8_t* h,
+                           const uint8_t* x,
+                           size_t count ) noexcept;
+void MultiplySum64Pclmul( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept;
+
+} // namespace x86_64
+
+#endif // __x86_64__
+
+cpu::Dispatcher< MultiplySumFn >& MultiplySum128Dispatcher() noexcept;
+cpu::Dispatcher< MultiplySumFn >& MultiplySum64Dispatcher() noexcept;
+
+} // namespace mgm
+
+} // namespace kernel
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
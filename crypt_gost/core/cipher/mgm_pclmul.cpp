@@ -0,0 +1,69 @@
+#include <core/cipher/block_util.hpp>
+#include "mgm_kernel.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "pclmul,ssse3" )
+
+#    include <immintrin.h>
+
+using namespace crypt_gost::core::cipher;
+using namespace crypt_gost::core::cipher::kernel;
+
+// Partial products of 64-bit halves are summed over all blocks, then combined and reduced.
+
+void mgm::x86_64::MultiplySum128Pclmul( uint8_t* sum,
+                                        const uint8_t* h,
+                                        const uint8_t* x,
+                                        size_t count ) noexcept
+{
+    // Big-endian block to the least significant half in the low quadword.
+    const __m128i reverse = _mm_setr_epi8( 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 );
+    __m128i low = _mm_setzero_si128();
+    __m128i middle = _mm_setzero_si128();
+    __m128i high = _mm_setzero_si128();
+    for( size_t i = 0; i < count; ++i, h += 16, x += 16 )
+    {
+        __m128i a = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( h ) ),
+                                      reverse );
+        __m128i b = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( x ) ),
+                                      reverse );
+        low = _mm_xor_si128( low, _mm_clmulepi64_si128( a, b, 0x00 ) );
+        middle = _mm_xor_si128( middle, _mm_clmulepi64_si128( a, b, 0x01 ) );
+        middle = _mm_xor_si128( middle, _mm_clmulepi64_si128( a, b, 0x10 ) );
+        high = _mm_xor_si128( high, _mm_clmulepi64_si128( a, b, 0x11 ) );
+    }
+    low = _mm_xor_si128( low, _mm_slli_si128( middle, 8 ) );
+    high = _mm_xor_si128( high, _mm_srli_si128( middle, 8 ) );
+
+    uint64_t product[ 4 ];
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( product ), low );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( product + 2 ), high );
+    uint64_t reduced[ 2 ];
+    Reduce128( product, reduced );
+    block::StoreBigEndian64( sum, block::LoadBigEndian64( sum ) ^ reduced[ 1 ] );
+    block::StoreBigEndian64( sum + 8, block::LoadBigEndian64( sum + 8 ) ^ reduced[ 0 ] );
+}
+
+void mgm::x86_64::MultiplySum64Pclmul( uint8_t* sum,
+                                       const uint8_t* h,
+                                       const uint8_t* x,
+                                       size_t count ) noexcept
+{
+    __m128i acc = _mm_setzero_si128();
+    for( size_t i = 0; i < count; ++i, h += 8, x += 8 )
+    {
+        __m128i a = _mm_cvtsi64_si128( static_cast< long long >( block::LoadBigEndian64( h ) ) );
+        __m128i b = _mm_cvtsi64_si128( static_cast< long long >( block::LoadBigEndian64( x ) ) );
+        acc = _mm_xor_si128( acc, _mm_clmulepi64_si128( a, b, 0x00 ) );
+    }
+    uint64_t product[ 2 ];
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( product ), acc );
+    uint64_t reduced = Reduce64( product[ 1 ], product[ 0 ] );
+    block::StoreBigEndian64( sum, block::LoadBigEndian64( sum ) ^ reduced );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
@@ -0,0 +1,113 @@
+#include <atomic>
+#include <core/cpu/cpu_features.hpp>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#    include <cpuid.h>
+#endif
+
+using namespace crypt_gost::core::cpu;
+
+namespace
+{
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+
+// XCR0 bits of register states, which the OS saves on context switch.
+constexpr uint64_t XCR0_AVX_STATE = ( 1u << 1 ) | ( 1u << 2 );
+constexpr uint64_t XCR0_AVX512_STATE = ( 1u << 5 ) | ( 1u << 6 ) | ( 1u << 7 );
+
+inline uint32_t FeatureIf( bool supported, Feature feature ) noexcept
+{
+    return supported ? static_cast< uint32_t >( feature ) : 0u;
+}
+
+uint64_t ReadXcr0() noexcept
+{
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+    return ( static_cast< uint64_t >( edx ) << 32 ) | eax;
+}
+
+uint32_t QueryFeatures() noexcept
+{
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    uint32_t features = 0;
+
+    if( !__get_cpuid( 1, &eax, &ebx, &ecx, &edx ) )
+    {
+        return features;
+    }
+
+    features |= FeatureIf( ecx & bit_SSSE3, FEATURE_SSSE3 );
+    features |= FeatureIf( ecx & bit_SSE4_1, FEATURE_SSE41 );
+    features |= FeatureIf( ecx & bit_PCLMUL, FEATURE_PCLMUL );
+
+    bool osAvx = false;
+    bool osAvx512 = false;
+    if( ( ecx & bit_OSXSAVE ) && ( ecx & bit_AVX ) )
+    {
+        uint64_t xcr0 = ReadXcr0();
+        osAvx = ( xcr0 & XCR0_AVX_STATE ) == XCR0_AVX_STATE;
+        osAvx512 = osAvx && ( xcr0 & XCR0_AVX512_STATE ) == XCR0_AVX512_STATE;
+    }
+
+    if( !__get_cpuid_count( 7, 0, &eax, &ebx, &ecx, &edx ) )
+    {
+        return features;
+    }
+
+    features |= FeatureIf( ebx & bit_BMI2, FEATURE_BMI2 );
+    features |= FeatureIf( ebx & bit_ADX, FEATURE_ADX );
+    features |= FeatureIf( osAvx && ( ebx & bit_AVX2 ), FEATURE_AVX2 );
+    features |= FeatureIf( osAvx && ( ecx & bit_GFNI ), FEATURE_GFNI );
+    features |= FeatureIf( osAvx && ( ecx & bit_VPCLMULQDQ ), FEATURE_VPCLMULQDQ );
+    if( osAvx512 && ( ebx & bit_AVX512F ) )
+    {
+        features |= FEATURE_AVX512F;
+        features |= FeatureIf( ebx & bit_AVX512BW, FEATURE_AVX512BW );
+        features |= FeatureIf( ebx & bit_AVX512VL, FEATURE_AVX512VL );
+        features |= FeatureIf( ebx & bit_AVX512IFMA, FEATURE_AVX512IFMA );
+        features |= FeatureIf( ecx & bit_AVX512VBMI, FEATURE_AVX512VBMI );
+    }
+    return features;
+}
+
+#else
+
+uint32_t QueryFeatures() noexcept
+{
+    return 0;
+}
+
+#endif
+
+std::atomic< uint32_t > featureMask{ ~0u };
+std::atomic< uint32_t > generation{ 0 };
+
+} // namespace
+
+uint32_t crypt_gost::core::cpu::DetectFeatures() noexcept
+{
+    static const uint32_t features = QueryFeatures();
+    return features;
+}
+
+uint32_t crypt_gost::core::cpu::GetFeatures() noexcept
+{
+    return DetectFeatures() & featureMask.load( std::memory_order_relaxed );
+}
+
+void crypt_gost::core::cpu::SetFeatureMask( uint32_t mask ) noexcept
+{
+    featureMask.store( mask, std::memory_order_relaxed );
+    generation.fetch_add( 1, std::memory_order_release );
+}
+
+uint32_t crypt_gost::core::cpu::GetGeneration() noexcept
+{
+    return generation.load( std::memory_order_acquire );
+}
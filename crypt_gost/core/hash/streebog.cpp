@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <core/hash/streebog.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/traits.hpp>
+#include "streebog_kernel.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::hash;
+using namespace crypt_gost::core::hash::kernel;
+using streebog::A;
+using streebog::PI;
+using streebog::ROUND_COUNT;
+using streebog::TABLES;
+using streebog::WORD_COUNT;
+
+namespace
+{
+
+constexpr size_t BLOCK_SIZE = Streebog::BLOCK_SIZE;
+
+// Iteration constants C_1 .. C_12, least significant word first.
+constexpr uint64_t C[ ROUND_COUNT ][ WORD_COUNT ] = {
+    { 0xdd806559f2a64507, 0x05767436cc744d23, 0xa2422a08a460d315, 0x4b7ce09192676901,
+      0x714eb88d7585c4fc, 0x2f6a76432e45d016, 0xebcb2f81c0657c1f, 0xb1085bda1ecadae9 },
+    { 0xe679047021b19bb7, 0x55dda21bd7cbcd56, 0x5cb561c2db0aa7ca, 0x9ab5176b12d69958,
+      0x61d55e0f16b50131, 0xf3feea720a232b98, 0x4fe39d460f70b5d7, 0x6fa3b58aa99d2f1a },
+    { 0x991e96f50aba0ab2, 0xc2b6f443867adb31, 0xc1c93a376062db09, 0xd3e20fe490359eb1,
+      0xf2ea7514b1297b7b, 0x06f15e5f529c1f8b, 0x0a39fc286a3d8435, 0xf574dcac2bce2fc7 },
+    { 0x220cbebc84e3d12e, 0x3453eaa193e837f1, 0xd8b71333935203be, 0xa9d72c82ed03d675,
+      0x9d721cad685e353f, 0x488e857e335c3c7d, 0xf948e1a05d71e4dd, 0xef1fdfb3e81566d2 },
+    { 0x601758fd7c6cfe57, 0x7a56a27ea9ea63f5, 0xdfff00b723271a16, 0xbfcd1747253af5a3,
+      0x359e35d7800fffbd, 0x7f151c1f1686104a, 0x9a3f410c6ca92363, 0x4bea6bacad474799 },
+    { 0xfa68407a46647d6e, 0xbf71c57236904f35, 0x0af21f66c2bec6b6, 0xcffaa6b71c9ab7b4,
+      0x187f9ab49af08ec6, 0x2d66c4f95142a46c, 0x6fa4c33b7a3039c0, 0xae4faeae1d3ad3d9 },
+    { 0x8886564d3a14d493, 0x3517454ca23c4af3, 0x06476983284a0504, 0x0992abc52d822c37,
+      0xd3473e33197a93c9, 0x399ec6c7e6bf87c9, 0x51ac86febf240954, 0xf4c70e16eeaac5ec },
+    { 0xa47f0dd4bf02e71e, 0x36acc2355951a8d9, 0x69d18d2bd1a5c42f, 0xf4892bcb929b0690,
+      0x89b4443b4ddbc49a, 0x4eb7f8719c36de1e, 0x03e7aa020c6e4141, 0x9b1f5b424d93c9a7 },
+    { 0x7261445183235adb, 0x0e38dc92cb1f2a60, 0x7b2b8a9aa6079c54, 0x800a440bdbb2ceb1,
+      0x3cd955b7e00d0984, 0x3a7d3a1b25894224, 0x944c9ad8ec165fde, 0x378f5a541631229b },
+    { 0x74b4c7fb98459ced, 0x3698fad1153bb6c3, 0x7a1e6c303b7652f4, 0x9fe76702af69334b,
+      0x1fffe18a1b336103, 0x8941e71cff8a78db, 0x382ae548b2e4f3f3, 0xabbedea680056f52 },
+    { 0x6bcaa4cd81f32d1b, 0xdea2594ac06fd85d, 0xefbacd1d7d476e98, 0x8a1d71efea48b9ca,
+      0x2001802114846679, 0xd8fa6bbbebab0761, 0x3002c6cd635afe94, 0x7bcd9ed0efc889fb },
+    { 0x48bc924af11bd720, 0xfaf417d5d9b21b99, 0xe71da4aa88e12852, 0x5d80ef9d1891cc86,
+      0xf82012d430219f9b, 0xcda43c32bcdf1d77, 0xd21380b00449b17a, 0x378ee767f11631ba },
+};
+
+constexpr streebog::Tables MakeTables() noexcept
+{
+    streebog::Tables ret{};
+    for( size_t k = 0; k < WORD_COUNT; ++k )
+    {
+        for( size_t b = 0; b < 256; ++b )
+        {
+            uint64_t entry = 0;
+            for( size_t i = 0; i < 8; ++i )
+            {
+                if( ( ( PI[ b ] >> i ) & 1 ) != 0 )
+                {
+                    entry ^= A[ 63 - ( 8 * k + i ) ];
+                }
+            }
+            ret.lps[ k ][ b ] = entry;
+        }
+    }
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        for( size_t j = 0; j < WORD_COUNT; ++j )
+        {
+            ret.constants[ i ][ j ] = C[ i ][ j ];
+        }
+    }
+    return ret;
+}
+
+} // namespace
+
+// Built at compile time, constant initialization keeps it in read-only data.
+const streebog::Tables streebog::TABLES = MakeTables();
+
+namespace
+{
+
+// The bytes of every word are taken in order by shifting, which is cheaper than extracting
+// byte j of all words for every output word.
+inline void TransformLps( const uint64_t* x, uint64_t* out ) noexcept
+{
+    uint64_t ret[ WORD_COUNT ] = {};
+    for( size_t k = 0; k < WORD_COUNT; ++k )
+    {
+        uint64_t word = x[ k ];
+        for( size_t j = 0; j < WORD_COUNT; ++j )
+        {
+            ret[ j ] ^= TABLES.lps[ k ][ word & 0xff ];
+            word >>= 8;
+        }
+    }
+    std::memcpy( out, ret, sizeof( ret ) );
+}
+
+inline void Xor( const uint64_t* a, const uint64_t* b, uint64_t* out ) noexcept
+{
+    for( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        out[ i ] = a[ i ] ^ b[ i ];
+    }
+}
+
+// a += b modulo 2^512.
+inline void Add( uint64_t* a, const uint64_t* b ) noexcept
+{
+    uint64_t carry = 0;
+    for( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        uint64_t sum = a[ i ] + b[ i ];
+        uint64_t next = sum < a[ i ];
+        sum += carry;
+        next |= sum < carry;
+        a[ i ] = sum;
+        carry = next;
+    }
+}
+
+inline void AddLength( uint64_t* length, uint64_t bits ) noexcept
+{
+    uint64_t addend[ WORD_COUNT ] = { bits };
+    Add( length, addend );
+}
+
+inline void LoadWords( const uint8_t* data, uint64_t* words ) noexcept
+{
+    std::memcpy( words, data, BLOCK_SIZE );
+    if( !util::traits::IsLittleEndian() )
+    {
+        for( size_t i = 0; i < WORD_COUNT; ++i )
+        {
+            words[ i ] = util::traits::ChangeByteOrdering( words[ i ] );
+        }
+    }
+}
+
+inline void StoreWords( const uint64_t* words, uint8_t* data ) noexcept
+{
+    for( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        uint64_t word = util::traits::IsLittleEndian()
+                            ? words[ i ]
+                            : util::traits::ChangeByteOrdering( words[ i ] );
+        std::memcpy( data + 8 * i, &word, sizeof( word ) );
+    }
+}
+
+// g_N( h, m ) = E( LPS( h ^ N ), m ) ^ h ^ m, where E( K, m ) runs 12 rounds LPSX[ K_i ]
+// with K_i+1 = LPS( K_i ^ C_i ) and adds K_13.
+void CompressWords( uint64_t* h, const uint64_t* n, const uint64_t* m ) noexcept
+{
+    uint64_t key[ WORD_COUNT ];
+    uint64_t state[ WORD_COUNT ];
+    Xor( h, n, key );
+    TransformLps( key, key );
+    Xor( key, m, state );
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        TransformLps( state, state );
+        Xor( key, TABLES.constants[ i ], key );
+        TransformLps( key, key );
+        Xor( state, key, state );
+    }
+    for( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        h[ i ] ^= state[ i ] ^ m[ i ];
+    }
+}
+
+inline void SetInitialVector( uint64_t* h, size_t digestSize ) noexcept
+{
+    std::memset( h, digestSize == Streebog::DIGEST_SIZE_256 ? 0x01 : 0x00,
+                 WORD_COUNT * sizeof( uint64_t ) );
+}
+
+// The 256-bit digest is the most significant half of h.
+inline void StoreDigest( const uint64_t* h, size_t digestSize, uint8_t* digest ) noexcept
+{
+    uint8_t bytes[ BLOCK_SIZE ];
+    StoreWords( h, bytes );
+    std::memcpy( digest, bytes + BLOCK_SIZE - digestSize, digestSize );
+    util::SecureZero( bytes, sizeof( bytes ) );
+}
+
+/**
+ * @brief Message being hashed by DigestMany. Every step is one compression: whole blocks
+ * of the message, the padded last block, then the length and the sum.
+ */
+struct Lane
+{
+    enum Stage
+    {
+        BLOCKS,
+        LAST,
+        LENGTH,
+        SUM
+    };
+
+    uint64_t h[ WORD_COUNT ];
+    uint64_t length[ WORD_COUNT ];
+    uint64_t sum[ WORD_COUNT ];
+    // Padded last block, then the length or the sum as bytes.
+    uint8_t block[ BLOCK_SIZE ];
+    const uint8_t* data;
+    size_t remaining;
+    size_t index;
+    Stage stage;
+
+    void Start( const Streebog::Message& message, size_t messageIndex, size_t digestSize ) noexcept
+    {
+        SetInitialVector( h, digestSize );
+        std::memset( length, 0, sizeof( length ) );
+        std::memset( sum, 0, sizeof( sum ) );
+        data = message.data;
+        remaining = message.size;
+        index = messageIndex;
+        stage = remaining >= BLOCK_SIZE ? BLOCKS : LAST;
+    }
+
+    streebog::CompressJob Job() noexcept
+    {
+        static constexpr uint64_t ZERO[ WORD_COUNT ] = {};
+
+        switch( stage )
+        {
+        case BLOCKS:
+            return streebog::CompressJob{ h, length, data };
+        case LAST:
+            std::memset( block, 0, sizeof( block ) );
+            if( remaining != 0 )
+            {
+                std::memcpy( block, data, remaining );
+            }
+            block[ remaining ] = 0x01;
+            return streebog::CompressJob{ h, length, block };
+        case LENGTH:
+            StoreWords( length, block );
+            return streebog::CompressJob{ h, ZERO, block };
+        default:
+            StoreWords( sum, block );
+            return streebog::CompressJob{ h, ZERO, block };
+        }
+    }
+
+    // Account for the compressed block, returns false when the digest is ready.
+    bool Advance() noexcept
+    {
+        uint64_t m[ WORD_COUNT ];
+        switch( stage )
+        {
+        case BLOCKS:
+            LoadWords( data, m );
+            Add( sum, m );
+            AddLength( length, 8 * BLOCK_SIZE );
+            data += BLOCK_SIZE;
+            remaining -= BLOCK_SIZE;
+            stage = remaining >= BLOCK_SIZE ? BLOCKS : LAST;
+            return true;
+        case LAST:
+            LoadWords( block, m );
+            Add( sum, m );
+            AddLength( length, 8 * remaining );
+            stage = LENGTH;
+            return true;
+        case LENGTH:
+            stage = SUM;
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+// Lanes kept in flight, enough to fill the widest kernel.
+constexpr size_t LANE_COUNT = 64;
+
+} // namespace
+
+Streebog::Streebog( size_t digestSize )
+    : h_()
+    , length_()
+    , sum_()
+    , buffer_()
+    , bufferSize_( 0 )
+    , digestSize_( digestSize )
+{
+    [[unlikely]] if( digestSize != DIGEST_SIZE_256 && digestSize != DIGEST_SIZE_512 )
+    {
+        throw std::runtime_error( "Unsupported digest size" );
+    }
+    Init();
+}
+
+Streebog::~Streebog() noexcept
+{
+    util::SecureZero( h_, sizeof( h_ ) );
+    util::SecureZero( sum_, sizeof( sum_ ) );
+    util::SecureZero( buffer_, sizeof( buffer_ ) );
+}
+
+size_t Streebog::GetDigestSize() const noexcept
+{
+    return digestSize_;
+}
+
+// IV is zero for the 512-bit digest and bytes 0x01 for the 256-bit one.
+void Streebog::Init() noexcept
+{
+    SetInitialVector( h_, digestSize_ );
+    std::memset( length_, 0, sizeof( length_ ) );
+    std::memset( sum_, 0, sizeof( sum_ ) );
+    bufferSize_ = 0;
+}
+
+void Streebog::Update( const uint8_t* data, size_t size ) noexcept
+{
+    if( size == 0 )
+    {
+        return;
+    }
+    if( bufferSize_ != 0 )
+    {
+        size_t chunk = std::min( size, BLOCK_SIZE - bufferSize_ );
+        std::memcpy( buffer_ + bufferSize_, data, chunk );
+        bufferSize_ += chunk;
+        data += chunk;
+        size -= chunk;
+        if( bufferSize_ < BLOCK_SIZE )
+        {
+            return;
+        }
+        Compress( buffer_ );
+        bufferSize_ = 0;
+    }
+    for( ; size >= BLOCK_SIZE; size -= BLOCK_SIZE )
+    {
+        Compress( data );
+        data += BLOCK_SIZE;
+    }
+    std::memcpy( buffer_, data, size );
+    bufferSize_ = size;
+}
+
+void Streebog::Update( const util::ConstSegment* segments, size_t count ) noexcept
+{
+    for( size_t i = 0; i < count; ++i )
+    {
+        Update( segments[ i ].data, segments[ i ].size );
+    }
+}
+
+// The last block, possibly empty, is padded with 0x01 and zeros, and contributes its actual
+// length. Then the length and the sum of blocks are compressed with N = 0.
+void Streebog::Final( uint8_t* digest ) noexcept
+{
+    static constexpr uint64_t ZERO[ WORD_COUNT ] = {};
+
+    std::memset( buffer_ + bufferSize_, 0, BLOCK_SIZE - bufferSize_ );
+    buffer_[ bufferSize_ ] = 0x01;
+    uint64_t m[ WORD_COUNT ];
+    LoadWords( buffer_, m );
+    CompressWords( h_, length_, m );
+    AddLength( length_, 8 * bufferSize_ );
+    Add( sum_, m );
+    CompressWords( h_, ZERO, length_ );
+    CompressWords( h_, ZERO, sum_ );
+    StoreDigest( h_, digestSize_, digest );
+    Init();
+}
+
+void Streebog::Compress( const uint8_t* block ) noexcept
+{
+    uint64_t m[ WORD_COUNT ];
+    LoadWords( block, m );
+    CompressWords( h_, length_, m );
+    AddLength( length_, 8 * BLOCK_SIZE );
+    Add( sum_, m );
+}
+
+// Lanes take the next message as soon as theirs is done, so messages of different lengths
+// keep the kernel busy until the last ones.
+void Streebog::DigestMany( size_t digestSize,
+                           const Message* messages,
+                           size_t count,
+                           uint8_t* digests )
+{
+    [[unlikely]] if( digestSize != DIGEST_SIZE_256 && digestSize != DIGEST_SIZE_512 )
+    {
+        throw std::runtime_error( "Unsupported digest size" );
+    }
+
+    streebog::CompressFn compress = streebog::CompressDispatcher().Get();
+    Lane lanes[ LANE_COUNT ];
+    Lane* active[ LANE_COUNT ];
+    size_t activeCount = 0;
+    size_t next = 0;
+    for( ; activeCount < LANE_COUNT && next < count; ++activeCount, ++next )
+    {
+        lanes[ activeCount ].Start( messages[ next ], next, digestSize );
+        active[ activeCount ] = &lanes[ activeCount ];
+    }
+
+    streebog::CompressJob jobs[ LANE_COUNT ];
+    while( activeCount != 0 )
+    {
+        for( size_t i = 0; i < activeCount; ++i )
+        {
+            jobs[ i ] = active[ i ]->Job();
+        }
+        compress( jobs, activeCount );
+        for( size_t i = 0; i < activeCount; )
+        {
+            Lane& lane = *active[ i ];
+            if( lane.Advance() )
+            {
+                ++i;
+                continue;
+            }
+            StoreDigest( lane.h, digestSize, digests + lane.index * digestSize );
+            if( next < count )
+            {
+                lane.Start( messages[ next ], next, digestSize );
+                ++next;
+                ++i;
+            }
+            else
+            {
+                active[ i ] = active[ --activeCount ];
+            }
+        }
+    }
+
+    util::SecureZero( lanes, sizeof( lanes ) );
+}
+
+void streebog::generic::Compress( const CompressJob* jobs, size_t count ) noexcept
+{
+    for( size_t i = 0; i < count; ++i )
+    {
+        uint64_t m[ WORD_COUNT ];
+        LoadWords( jobs[ i ].m, m );
+        CompressWords( jobs[ i ].h, jobs[ i ].n, m );
+    }
+}
+
+cpu::Dispatcher< streebog::CompressFn >& streebog::CompressDispatcher() noexcept
+{
+    static cpu::Dispatcher< CompressFn > dispatcher( generic::Compress );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::CompressAvx512,
+                             cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512BW
+                                 | cpu::FEATURE_AVX512VBMI | cpu::FEATURE_GFNI );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
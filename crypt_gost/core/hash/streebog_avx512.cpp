@@ -0,0 +1,241 @@
+#include <core/util/secure_zero.hpp>
+#include "streebog_kernel.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx512f,avx512bw,avx512vbmi,gfni" )
+// Some AVX-512 intrinsics pass a deliberately undefined source operand, which GCC
+// reports as uninitialized once they are inlined.
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#    include <cstring>
+#    include <immintrin.h>
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::hash;
+using namespace crypt_gost::core::hash::kernel::streebog;
+
+// Byte-sliced Streebog. The 512-bit values of 64 jobs are transposed into 64 vectors,
+// vector p holding byte p of every job. S is then a bytewise lookup and P only renames
+// vectors. Byte i of l( y ) is XOR over bytes k of y of products with 8 x 8 bit matrices,
+// each a single GF2P8AFFINEQB, so word j of L( P( S( x ) ) ) takes 64 of them.
+
+namespace
+{
+
+using Vec = __m512i;
+
+constexpr size_t BLOCK_SIZE = Streebog::BLOCK_SIZE;
+constexpr size_t WIDTH = 64;
+// Fewer jobs are faster one at a time with lookup tables.
+constexpr size_t MIN_JOBS = 16;
+
+// Bit matrices of l for input byte k and output byte i, in GF2P8AFFINEQB layout: byte
+// 7 - q selects the input bits whose parity is bit q of the output.
+struct Matrices
+{
+    uint64_t m[ WORD_COUNT ][ WORD_COUNT ];
+};
+
+constexpr Matrices MakeMatrices() noexcept
+{
+    Matrices ret{};
+    for( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        for( size_t k = 0; k < WORD_COUNT; ++k )
+        {
+            uint64_t matrix = 0;
+            for( size_t q = 0; q < 8; ++q )
+            {
+                uint64_t row = 0;
+                for( size_t r = 0; r < 8; ++r )
+                {
+                    row |= ( ( A[ 63 - 8 * k - r ] >> ( 8 * i + q ) ) & 1 ) << r;
+                }
+                matrix |= row << ( 8 * ( 7 - q ) );
+            }
+            ret.m[ i ][ k ] = matrix;
+        }
+    }
+    return ret;
+}
+
+constexpr Matrices MATRICES = MakeMatrices();
+
+// Byte interleaving of the low and the high halves of two vectors, for vpermt2b.
+struct alignas( 64 ) InterleaveIndices
+{
+    uint8_t low[ 64 ];
+    uint8_t high[ 64 ];
+};
+
+constexpr InterleaveIndices MakeInterleaveIndices() noexcept
+{
+    InterleaveIndices ret{};
+    for( size_t t = 0; t < 64; ++t )
+    {
+        ret.low[ t ] = static_cast< uint8_t >( t / 2 + ( t % 2 ) * 64 );
+        ret.high[ t ] = static_cast< uint8_t >( 32 + t / 2 + ( t % 2 ) * 64 );
+    }
+    return ret;
+}
+
+constexpr InterleaveIndices INTERLEAVE = MakeInterleaveIndices();
+
+// 64 x 64 byte transposition: six rounds of interleaving vector i with vector i + 32.
+inline void Transpose( Vec* v ) noexcept
+{
+    const Vec low = _mm512_load_si512( INTERLEAVE.low );
+    const Vec high = _mm512_load_si512( INTERLEAVE.high );
+    Vec t[ WIDTH ];
+    for( size_t stage = 0; stage < 6; ++stage )
+    {
+        for( size_t i = 0; i < WIDTH / 2; ++i )
+        {
+            t[ 2 * i ] = _mm512_permutex2var_epi8( v[ i ], low, v[ i + WIDTH / 2 ] );
+            t[ 2 * i + 1 ] = _mm512_permutex2var_epi8( v[ i ], high, v[ i + WIDTH / 2 ] );
+        }
+        for( size_t i = 0; i < WIDTH; ++i )
+        {
+            v[ i ] = t[ i ];
+        }
+    }
+}
+
+/**
+ * @brief Two 128-entry permutations cover pi, the top bit of the index selects between them.
+ */
+struct Sbox
+{
+    Vec quarters[ 4 ];
+
+    Sbox() noexcept
+    {
+        for( size_t i = 0; i < 4; ++i )
+        {
+            quarters[ i ] = _mm512_loadu_si512( PI + 64 * i );
+        }
+    }
+
+    inline Vec operator()( Vec x ) const noexcept
+    {
+        Vec low = _mm512_permutex2var_epi8( quarters[ 0 ], x, quarters[ 1 ] );
+        Vec high = _mm512_permutex2var_epi8( quarters[ 2 ], x, quarters[ 3 ] );
+        return _mm512_mask_blend_epi8( _mm512_movepi8_mask( x ), low, high );
+    }
+};
+
+inline Vec Multiply( Vec x, uint64_t matrix ) noexcept
+{
+    return _mm512_gf2p8affine_epi64_epi8(
+        x, _mm512_set1_epi64( static_cast< long long >( matrix ) ), 0 );
+}
+
+// Byte j of word k of x goes to byte k of word j under P.
+inline void TransformLps( const Sbox& sbox, const Vec* x, Vec* out ) noexcept
+{
+    Vec s[ BLOCK_SIZE ];
+    for( size_t p = 0; p < BLOCK_SIZE; ++p )
+    {
+        s[ p ] = sbox( x[ p ] );
+    }
+    for( size_t j = 0; j < WORD_COUNT; ++j )
+    {
+        for( size_t i = 0; i < WORD_COUNT; ++i )
+        {
+            Vec sum = Multiply( s[ j ], MATRICES.m[ i ][ 0 ] );
+            for( size_t k = 1; k < WORD_COUNT; ++k )
+            {
+                sum = _mm512_xor_si512( sum, Multiply( s[ 8 * k + j ], MATRICES.m[ i ][ k ] ) );
+            }
+            out[ 8 * j + i ] = sum;
+        }
+    }
+}
+
+// Up to WIDTH jobs, rows of missing ones are zero.
+void CompressBatch( const CompressJob* jobs, size_t count ) noexcept
+{
+    Vec h[ BLOCK_SIZE ];
+    Vec key[ BLOCK_SIZE ];
+    Vec m[ BLOCK_SIZE ];
+    Vec state[ BLOCK_SIZE ];
+    for( size_t lane = 0; lane < WIDTH; ++lane )
+    {
+        if( lane < count )
+        {
+            h[ lane ] = _mm512_loadu_si512( jobs[ lane ].h );
+            key[ lane ] = _mm512_loadu_si512( jobs[ lane ].n );
+            m[ lane ] = _mm512_loadu_si512( jobs[ lane ].m );
+        }
+        else
+        {
+            h[ lane ] = _mm512_setzero_si512();
+            key[ lane ] = _mm512_setzero_si512();
+            m[ lane ] = _mm512_setzero_si512();
+        }
+    }
+    Transpose( h );
+    Transpose( key );
+    Transpose( m );
+
+    const Sbox sbox;
+    for( size_t p = 0; p < BLOCK_SIZE; ++p )
+    {
+        key[ p ] = _mm512_xor_si512( key[ p ], h[ p ] );
+    }
+    TransformLps( sbox, key, key );
+    for( size_t p = 0; p < BLOCK_SIZE; ++p )
+    {
+        state[ p ] = _mm512_xor_si512( key[ p ], m[ p ] );
+    }
+    for( size_t i = 0; i < ROUND_COUNT; ++i )
+    {
+        const auto* constant = reinterpret_cast< const uint8_t* >( TABLES.constants[ i ] );
+        TransformLps( sbox, state, state );
+        for( size_t p = 0; p < BLOCK_SIZE; ++p )
+        {
+            key[ p ] = _mm512_xor_si512( key[ p ],
+                                         _mm512_set1_epi8( static_cast< char >( constant[ p ] ) ) );
+        }
+        TransformLps( sbox, key, key );
+        for( size_t p = 0; p < BLOCK_SIZE; ++p )
+        {
+            state[ p ] = _mm512_xor_si512( state[ p ], key[ p ] );
+        }
+    }
+    for( size_t p = 0; p < BLOCK_SIZE; ++p )
+    {
+        h[ p ] = _mm512_xor_si512( h[ p ], _mm512_xor_si512( state[ p ], m[ p ] ) );
+    }
+
+    Transpose( h );
+    for( size_t lane = 0; lane < count; ++lane )
+    {
+        _mm512_storeu_si512( jobs[ lane ].h, h[ lane ] );
+    }
+    util::SecureZero( h, sizeof( h ) );
+    util::SecureZero( key, sizeof( key ) );
+    util::SecureZero( m, sizeof( m ) );
+    util::SecureZero( state, sizeof( state ) );
+}
+
+} // namespace
+
+void x86_64::CompressAvx512( const CompressJob* jobs, size_t count ) noexcept
+{
+    while( count >= MIN_JOBS )
+    {
+        size_t batch = count < WIDTH ? count : WIDTH;
+        CompressBatch( jobs, batch );
+        jobs += batch;
+        count -= batch;
+    }
+    generic::Compress( jobs, count );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
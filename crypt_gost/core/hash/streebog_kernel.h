@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cipher/pi.hpp>
+#include <core/cpu/dispatch.hpp>
+#include <core/hash/streebog.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace hash
+{
+
+namespace kernel
+{
+
+namespace streebog
+{
+
+constexpr size_t WORD_COUNT = 8;
+constexpr size_t ROUND_COUNT = 12;
+
+// Nonlinear bijection pi, the same as in Kuznyechik.
+using cipher::PI;
+
+// Rows A_0 .. A_63 of the matrix of linear transformation l, which maps bit i of a word to
+// A_63-i.
+inline constexpr uint64_t A[ 64 ] = {
+    0x8e20faa72ba0b470, 0x47107ddd9b505a38, 0xad08b0e0c3282d1c, 0xd8045870ef14980e,
+    0x6c022c38f90a4c07, 0x3601161cf205268d, 0x1b8e0b0e798c13c8, 0x83478b07b2468764,
+    0xa011d380818e8f40, 0x5086e740ce47c920, 0x2843fd2067adea10, 0x14aff010bdd87508,
+    0x0ad97808d06cb404, 0x05e23c0468365a02, 0x8c711e02341b2d01, 0x46b60f011a83988e,
+    0x90dab52a387ae76f, 0x486dd4151c3dfdb9, 0x24b86a840e90f0d2, 0x125c354207487869,
+    0x092e94218d243cba, 0x8a174a9ec8121e5d, 0x4585254f64090fa0, 0xaccc9ca9328a8950,
+    0x9d4df05d5f661451, 0xc0a878a0a1330aa6, 0x60543c50de970553, 0x302a1e286fc58ca7,
+    0x18150f14b9ec46dd, 0x0c84890ad27623e0, 0x0642ca05693b9f70, 0x0321658cba93c138,
+    0x86275df09ce8aaa8, 0x439da0784e745554, 0xafc0503c273aa42a, 0xd960281e9d1d5215,
+    0xe230140fc0802984, 0x71180a8960409a42, 0xb60c05ca30204d21, 0x5b068c651810a89e,
+    0x456c34887a3805b9, 0xac361a443d1c8cd2, 0x561b0d22900e4669, 0x2b838811480723ba,
+    0x9bcf4486248d9f5d, 0xc3e9224312c8c1a0, 0xeffa11af0964ee50, 0xf97d86d98a327728,
+    0xe4fa2054a80b329c, 0x727d102a548b194e, 0x39b008152acb8227, 0x9258048415eb419d,
+    0x492c024284fbaec0, 0xaa16012142f35760, 0x550b8e9e21f7a530, 0xa48b474f9ef5dc18,
+    0x70a6a56e2440598e, 0x3853dc371220a247, 0x1ca76e95091051ad, 0x0edd37c48a08a6d8,
+    0x07e095624504536c, 0x8d70c431ac02a736, 0xc83862965601dd1b, 0x641c314b2b8ee083,
+};
+
+
+/**
+ * @brief Entry lps[ k ][ b ] is l( pi( b ) << 8k ). Byte j of word k of x goes to byte k of
+ * word j under P, so word j of L( P( S( x ) ) ) is XOR of entries [ k ][ byte j of x_k ].
+ */
+struct Tables
+{
+    alignas( 64 ) uint64_t lps[ WORD_COUNT ][ 256 ];
+    // Iteration constants C_1 .. C_12, least significant word first.
+    uint64_t constants[ ROUND_COUNT ][ WORD_COUNT ];
+};
+
+extern const Tables TABLES;
+
+/**
+ * @brief One application of the compression function, h = g_N( h, m ). Words are least
+ * significant first, block \p m is BLOCK_SIZE bytes of the message.
+ */
+struct CompressJob
+{
+    uint64_t* h;
+    const uint64_t* n;
+    const uint8_t* m;
+};
+
+/**
+ * @brief Run \p count independent jobs.
+ */
+using CompressFn = void ( * )( const CompressJob* jobs, size_t count );
+
+namespace generic
+{
+
+// One job at a time with lookup tables.
+void Compress( const CompressJob* jobs, size_t count ) noexcept;
+
+} // namespace generic
+
+#if defined( __x86_64__ )
+
+namespace x86_64
+{
+
+// Jobs byte-sliced in 64 byte lanes.
+void CompressAvx512( const CompressJob* jobs, size_t count ) noexcept;
+
+} // namespace x86_64
+
+#endif // __x86_64__
+
+cpu::Dispatcher< CompressFn >& CompressDispatcher() noexcept;
+
+} // namespace streebog
+
+} // namespace kernel
+
+} // namespace hash
+
+} // namespace core
+
+} // namespace crypt_gost
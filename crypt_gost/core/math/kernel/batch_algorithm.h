@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Lane-parallel algorithms shared by all batch kernels. Ops provides the vector type of
+// Ops::WIDTH lanes and the operations on it, the including file compiles the algorithms
+// for its own instruction set, so everything here has internal linkage.
+
+namespace
+{
+
+using crypt_gost::core::math::kernel::batch::MAX_LIMBS;
+using crypt_gost::core::math::kernel::batch::RADIX_MASK;
+
+template < typename Ops >
+inline size_t LaneCount( size_t lane, size_t lanes ) noexcept
+{
+    return lanes - lane < Ops::WIDTH ? lanes - lane : Ops::WIDTH;
+}
+
+// Propagate carries of accumulators into 52-bit limbs, return carry out of the top limb.
+template < typename Ops >
+inline typename Ops::Vec Normalize( typename Ops::Vec* acc, size_t limbs ) noexcept
+{
+    using Vec = typename Ops::Vec;
+    const Vec mask = Ops::Broadcast( RADIX_MASK );
+    Vec carry = Ops::Zero();
+    for( size_t j = 0; j < limbs; ++j )
+    {
+        Vec sum = Ops::Add( acc[ j ], carry );
+        acc[ j ] = Ops::And( sum, mask );
+        carry = Ops::template ShiftRight< 52 >( sum );
+    }
+    return carry;
+}
+
+template < typename Ops >
+void MulLanes( uint64_t* r,
+               const uint64_t* a,
+               const uint64_t* b,
+               size_t limbs,
+               size_t lanes ) noexcept
+{
+    using Vec = typename Ops::Vec;
+    for( size_t lane = 0; lane < lanes; lane += Ops::WIDTH )
+    {
+        size_t count = LaneCount< Ops >( lane, lanes );
+        Vec left[ MAX_LIMBS ];
+        // One extra accumulator receives high halves beyond the truncated product.
+        Vec acc[ MAX_LIMBS + 1 ];
+        for( size_t j = 0; j < limbs; ++j )
+        {
+            left[ j ] = Ops::Load( a + j * lanes + lane, count );
+            acc[ j ] = Ops::Zero();
+        }
+        acc[ limbs ] = Ops::Zero();
+
+        for( size_t i = 0; i < limbs; ++i )
+        {
+            Vec right = Ops::Load( b + i * lanes + lane, count );
+            for( size_t j = 0; j < limbs - i; ++j )
+            {
+                Ops::Madd52( acc[ i + j ], acc[ i + j + 1 ], left[ j ], right );
+            }
+        }
+
+        Normalize< Ops >( acc, limbs );
+        for( size_t j = 0; j < limbs; ++j )
+        {
+            Ops::Store( r + j * lanes + lane, acc[ j ], count );
+        }
+    }
+}
+
+// Coarsely integrated operand scanning Montgomery multiplication. Accumulators are not
+// normalized between iterations: each gains less than 4 * 2^52 per iteration, which
+// leaves enough headroom in 64-bit words for MAX_LIMBS iterations.
+template < typename Ops >
+void MontMulLanes( uint64_t* r,
+                   const uint64_t* a,
+                   const uint64_t* b,
+                   const uint64_t* p,
+                   uint64_t pInv,
+                   size_t limbs,
+                   size_t lanes ) noexcept
+{
+    using Vec = typename Ops::Vec;
+    const Vec mask = Ops::Broadcast( RADIX_MASK );
+    const Vec inverse = Ops::Broadcast( pInv );
+    Vec modulus[ MAX_LIMBS ];
+    for( size_t j = 0; j < limbs; ++j )
+    {
+        modulus[ j ] = Ops::Broadcast( p[ j ] );
+    }
+
+    for( size_t lane = 0; lane < lanes; lane += Ops::WIDTH )
+    {
+        size_t count = LaneCount< Ops >( lane, lanes );
+        Vec left[ MAX_LIMBS ];
+        Vec acc[ MAX_LIMBS + 1 ];
+        for( size_t j = 0; j < limbs; ++j )
+        {
+            left[ j ] = Ops::Load( a + j * lanes + lane, count );
+            acc[ j ] = Ops::Zero();
+        }
+        acc[ limbs ] = Ops::Zero();
+
+        for( size_t i = 0; i < limbs; ++i )
+        {
+            Vec right = Ops::Load( b + i * lanes + lane, count );
+            for( size_t j = 0; j < limbs; ++j )
+            {
+                Ops::Madd52( acc[ j ], acc[ j + 1 ], left[ j ], right );
+            }
+
+            Vec m = Ops::Zero();
+            Vec unused = Ops::Zero();
+            Ops::Madd52( m, unused, Ops::And( acc[ 0 ], mask ), inverse );
+            for( size_t j = 0; j < limbs; ++j )
+            {
+                Ops::Madd52( acc[ j ], acc[ j + 1 ], modulus[ j ], m );
+            }
+
+            // Lowest limb is now divisible by 2^52 and is shifted out.
+            acc[ 1 ] = Ops::Add( acc[ 1 ], Ops::template ShiftRight< 52 >( acc[ 0 ] ) );
+            for( size_t j = 0; j < limbs; ++j )
+            {
+                acc[ j ] = acc[ j + 1 ];
+            }
+            acc[ limbs ] = Ops::Zero();
+        }
+
+        // Result is below 2p, subtract p unless that borrows.
+        Vec top = Normalize< Ops >( acc, limbs );
+        Vec diff[ MAX_LIMBS ];
+        Vec borrow = Ops::Zero();
+        for( size_t j = 0; j < limbs; ++j )
+        {
+            Vec d = Ops::Sub( Ops::Sub( acc[ j ], modulus[ j ] ), borrow );
+            diff[ j ] = Ops::And( d, mask );
+            borrow = Ops::template ShiftRight< 63 >( d );
+        }
+        Vec negative = Ops::template ShiftRight< 63 >( Ops::Sub( top, borrow ) );
+        Vec keep = Ops::Sub( Ops::Zero(), negative );
+        for( size_t j = 0; j < limbs; ++j )
+        {
+            Vec res = Ops::Or( Ops::And( keep, acc[ j ] ), Ops::AndNot( keep, diff[ j ] ) );
+            Ops::Store( r + j * lanes + lane, res, count );
+        }
+    }
+}
+
+} // namespace
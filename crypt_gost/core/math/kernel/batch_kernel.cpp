@@ -0,0 +1,127 @@
+#include <core/math/batch_kernel.hpp>
+#include "batch_algorithm.h"
+#include "batch_kernel_x86_64.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::math::kernel;
+
+namespace
+{
+
+// Single lane in a general purpose register, 52-bit products via 128-bit multiplication.
+struct ScalarOps
+{
+    using Vec = uint64_t;
+    static constexpr size_t WIDTH = 1;
+
+    static inline Vec Load( const uint64_t* ptr, size_t ) noexcept
+    {
+        return *ptr;
+    }
+
+    static inline void Store( uint64_t* ptr, Vec value, size_t ) noexcept
+    {
+        *ptr = value;
+    }
+
+    static inline Vec Zero() noexcept
+    {
+        return 0;
+    }
+
+    static inline Vec Broadcast( uint64_t value ) noexcept
+    {
+        return value;
+    }
+
+    static inline Vec Add( Vec a, Vec b ) noexcept
+    {
+        return a + b;
+    }
+
+    static inline Vec Sub( Vec a, Vec b ) noexcept
+    {
+        return a - b;
+    }
+
+    static inline Vec And( Vec a, Vec b ) noexcept
+    {
+        return a & b;
+    }
+
+    static inline Vec Or( Vec a, Vec b ) noexcept
+    {
+        return a | b;
+    }
+
+    static inline Vec AndNot( Vec a, Vec b ) noexcept
+    {
+        return ~a & b;
+    }
+
+    template < int shift >
+    static inline Vec ShiftRight( Vec a ) noexcept
+    {
+        return a >> shift;
+    }
+
+    static inline void Madd52( Vec& low, Vec& high, Vec a, Vec b ) noexcept
+    {
+        unsigned __int128 product = static_cast< unsigned __int128 >( a & batch::RADIX_MASK )
+                                    * ( b & batch::RADIX_MASK );
+        low += static_cast< uint64_t >( product ) & batch::RADIX_MASK;
+        high += static_cast< uint64_t >( product >> batch::RADIX_BIT_SIZE );
+    }
+};
+
+} // namespace
+
+void batch::generic::Mul( uint64_t* r,
+                          const uint64_t* a,
+                          const uint64_t* b,
+                          size_t limbs,
+                          size_t lanes ) noexcept
+{
+    MulLanes< ScalarOps >( r, a, b, limbs, lanes );
+}
+
+void batch::generic::MontMul( uint64_t* r,
+                              const uint64_t* a,
+                              const uint64_t* b,
+                              const uint64_t* p,
+                              uint64_t pInv,
+                              size_t limbs,
+                              size_t lanes ) noexcept
+{
+    MontMulLanes< ScalarOps >( r, a, b, p, pInv, limbs, lanes );
+}
+
+cpu::Dispatcher< batch::MulFn >& crypt_gost::core::math::kernel::batch::MulDispatcher() noexcept
+{
+    static cpu::Dispatcher< MulFn > dispatcher( generic::Mul );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::MulAvx2, cpu::FEATURE_AVX2 );
+        dispatcher.Register( x86_64::MulIfma, cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512IFMA );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< batch::MontMulFn >&
+crypt_gost::core::math::kernel::batch::MontMulDispatcher() noexcept
+{
+    static cpu::Dispatcher< MontMulFn > dispatcher( generic::MontMul );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::MontMulAvx2, cpu::FEATURE_AVX2 );
+        dispatcher.Register( x86_64::MontMulIfma,
+                             cpu::FEATURE_AVX512F | cpu::FEATURE_AVX512IFMA );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
@@ -0,0 +1,118 @@
+#include <core/math/batch_kernel.hpp>
+#include "batch_kernel_x86_64.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx2" )
+
+#    include <immintrin.h>
+#    include "batch_algorithm.h"
+
+using namespace crypt_gost::core::math::kernel;
+
+namespace
+{
+
+// Four lanes. AVX2 only multiplies 32-bit halves of words, so each 52-bit operand is split
+// into 26-bit halves and the 104-bit product is assembled from four partial products.
+struct Avx2Ops
+{
+    using Vec = __m256i;
+    static constexpr size_t WIDTH = 4;
+
+    static inline Vec Load( const uint64_t* ptr, size_t ) noexcept
+    {
+        return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+    }
+
+    static inline void Store( uint64_t* ptr, Vec value, size_t ) noexcept
+    {
+        _mm256_storeu_si256( reinterpret_cast< __m256i* >( ptr ), value );
+    }
+
+    static inline Vec Zero() noexcept
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static inline Vec Broadcast( uint64_t value ) noexcept
+    {
+        return _mm256_set1_epi64x( static_cast< long long >( value ) );
+    }
+
+    static inline Vec Add( Vec a, Vec b ) noexcept
+    {
+        return _mm256_add_epi64( a, b );
+    }
+
+    static inline Vec Sub( Vec a, Vec b ) noexcept
+    {
+        return _mm256_sub_epi64( a, b );
+    }
+
+    static inline Vec And( Vec a, Vec b ) noexcept
+    {
+        return _mm256_and_si256( a, b );
+    }
+
+    static inline Vec Or( Vec a, Vec b ) noexcept
+    {
+        return _mm256_or_si256( a, b );
+    }
+
+    static inline Vec AndNot( Vec a, Vec b ) noexcept
+    {
+        return _mm256_andnot_si256( a, b );
+    }
+
+    template < int shift >
+    static inline Vec ShiftRight( Vec a ) noexcept
+    {
+        return _mm256_srli_epi64( a, shift );
+    }
+
+    // Operands must be below 2^52.
+    static inline void Madd52( Vec& low, Vec& high, Vec a, Vec b ) noexcept
+    {
+        const Vec mask26 = Broadcast( ( 1ull << 26 ) - 1 );
+        Vec a0 = And( a, mask26 );
+        Vec a1 = ShiftRight< 26 >( a );
+        Vec b0 = And( b, mask26 );
+        Vec b1 = ShiftRight< 26 >( b );
+
+        Vec p00 = _mm256_mul_epu32( a0, b0 );
+        Vec p11 = _mm256_mul_epu32( a1, b1 );
+        Vec middle = Add( _mm256_mul_epu32( a0, b1 ), _mm256_mul_epu32( a1, b0 ) );
+        Vec sum = Add( p00, _mm256_slli_epi64( And( middle, mask26 ), 26 ) );
+
+        low = Add( low, And( sum, Broadcast( batch::RADIX_MASK ) ) );
+        high = Add( high, Add( Add( p11, ShiftRight< 26 >( middle ) ), ShiftRight< 52 >( sum ) ) );
+    }
+};
+
+} // namespace
+
+void batch::x86_64::MulAvx2( uint64_t* r,
+                             const uint64_t* a,
+                             const uint64_t* b,
+                             size_t limbs,
+                             size_t lanes ) noexcept
+{
+    MulLanes< Avx2Ops >( r, a, b, limbs, lanes );
+}
+
+void batch::x86_64::MontMulAvx2( uint64_t* r,
+                                 const uint64_t* a,
+                                 const uint64_t* b,
+                                 const uint64_t* p,
+                                 uint64_t pInv,
+                                 size_t limbs,
+                                 size_t lanes ) noexcept
+{
+    MontMulLanes< Avx2Ops >( r, a, b, p, pInv, limbs, lanes );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
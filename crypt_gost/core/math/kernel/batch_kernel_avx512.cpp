@@ -0,0 +1,114 @@
+#include <core/math/batch_kernel.hpp>
+#include "batch_kernel_x86_64.h"
+
+#if defined( __x86_64__ )
+
+#    pragma GCC push_options
+#    pragma GCC target( "avx512f,avx512ifma" )
+// Some AVX-512 intrinsics pass a deliberately undefined source operand, which GCC
+// reports as maybe uninitialized once they are inlined.
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#    include <immintrin.h>
+#    include "batch_algorithm.h"
+
+using namespace crypt_gost::core::math::kernel;
+
+namespace
+{
+
+// Eight lanes, VPMADD52LUQ/VPMADD52HUQ add the low and high halves of 52-bit products
+// directly. Lane counts not divisible by 8 are handled with masked loads and stores.
+struct IfmaOps
+{
+    using Vec = __m512i;
+    static constexpr size_t WIDTH = 8;
+
+    static inline __mmask8 LaneMask( size_t count ) noexcept
+    {
+        return static_cast< __mmask8 >( ( 1u << count ) - 1 );
+    }
+
+    static inline Vec Load( const uint64_t* ptr, size_t count ) noexcept
+    {
+        return _mm512_maskz_loadu_epi64( LaneMask( count ), ptr );
+    }
+
+    static inline void Store( uint64_t* ptr, Vec value, size_t count ) noexcept
+    {
+        _mm512_mask_storeu_epi64( ptr, LaneMask( count ), value );
+    }
+
+    static inline Vec Zero() noexcept
+    {
+        return _mm512_setzero_si512();
+    }
+
+    static inline Vec Broadcast( uint64_t value ) noexcept
+    {
+        return _mm512_set1_epi64( static_cast< long long >( value ) );
+    }
+
+    static inline Vec Add( Vec a, Vec b ) noexcept
+    {
+        return _mm512_add_epi64( a, b );
+    }
+
+    static inline Vec Sub( Vec a, Vec b ) noexcept
+    {
+        return _mm512_sub_epi64( a, b );
+    }
+
+    static inline Vec And( Vec a, Vec b ) noexcept
+    {
+        return _mm512_and_si512( a, b );
+    }
+
+    static inline Vec Or( Vec a, Vec b ) noexcept
+    {
+        return _mm512_or_si512( a, b );
+    }
+
+    static inline Vec AndNot( Vec a, Vec b ) noexcept
+    {
+        return _mm512_andnot_si512( a, b );
+    }
+
+    template < int shift >
+    static inline Vec ShiftRight( Vec a ) noexcept
+    {
+        return _mm512_srli_epi64( a, shift );
+    }
+
+    static inline void Madd52( Vec& low, Vec& high, Vec a, Vec b ) noexcept
+    {
+        low = _mm512_madd52lo_epu64( low, a, b );
+        high = _mm512_madd52hi_epu64( high, a, b );
+    }
+};
+
+} // namespace
+
+void batch::x86_64::MulIfma( uint64_t* r,
+                             const uint64_t* a,
+                             const uint64_t* b,
+                             size_t limbs,
+                             size_t lanes ) noexcept
+{
+    MulLanes< IfmaOps >( r, a, b, limbs, lanes );
+}
+
+void batch::x86_64::MontMulIfma( uint64_t* r,
+                                 const uint64_t* a,
+                                 const uint64_t* b,
+                                 const uint64_t* p,
+                                 uint64_t pInv,
+                                 size_t limbs,
+                                 size_t lanes ) noexcept
+{
+    MontMulLanes< IfmaOps >( r, a, b, p, pInv, limbs, lanes );
+}
+
+#    pragma GCC pop_options
+
+#endif // __x86_64__
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined( __x86_64__ )
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+namespace kernel
+{
+
+namespace batch
+{
+
+namespace x86_64
+{
+
+void MulAvx2( uint64_t* r,
+              const uint64_t* a,
+              const uint64_t* b,
+              size_t limbs,
+              size_t lanes ) noexcept;
+
+void MontMulAvx2( uint64_t* r,
+                  const uint64_t* a,
+                  const uint64_t* b,
+                  const uint64_t* p,
+                  uint64_t pInv,
+                  size_t limbs,
+                  size_t lanes ) noexcept;
+
+void MulIfma( uint64_t* r,
+              const uint64_t* a,
+              const uint64_t* b,
+              size_t limbs,
+              size_t lanes ) noexcept;
+
+void MontMulIfma( uint64_t* r,
+                  const uint64_t* a,
+                  const uint64_t* b,
+                  const uint64_t* p,
+                  uint64_t pInv,
+                  size_t limbs,
+                  size_t lanes ) noexcept;
+
+} // namespace x86_64
+
+} // namespace batch
+
+} // namespace kernel
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
+
+#endif // __x86_64__
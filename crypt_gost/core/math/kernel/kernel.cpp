@@ -0,0 +1,70 @@
+#include <core/math/kernel.hpp>
+#include "kernel_x86_64.h"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::math::kernel;
+
+cpu::Dispatcher< AddFn >& crypt_gost::core::math::kernel::AddDispatcher() noexcept
+{
+    static cpu::Dispatcher< AddFn > dispatcher( generic::Add< uint64_t > );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::AddAdc, 0 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< SubFn >& crypt_gost::core::math::kernel::SubDispatcher() noexcept
+{
+    static cpu::Dispatcher< SubFn > dispatcher( generic::Sub< uint64_t > );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::SubSbb, 0 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< ShiftFn >& crypt_gost::core::math::kernel::ShiftLeftDispatcher() noexcept
+{
+    static cpu::Dispatcher< ShiftFn > dispatcher( generic::ShiftLeft< uint64_t > );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::ShiftLeftBmi2, cpu::FEATURE_BMI2 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< ShiftFn >& crypt_gost::core::math::kernel::ShiftRightDispatcher() noexcept
+{
+    static cpu::Dispatcher< ShiftFn > dispatcher( generic::ShiftRight< uint64_t > );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::ShiftRightBmi2, cpu::FEATURE_BMI2 );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
+
+cpu::Dispatcher< AddMul1Fn >& crypt_gost::core::math::kernel::AddMul1Dispatcher() noexcept
+{
+    static cpu::Dispatcher< AddMul1Fn > dispatcher( generic::AddMul1< uint64_t > );
+    static const bool registered = [] {
+#if defined( __x86_64__ )
+        dispatcher.Register( x86_64::AddMul1MulxAdx, cpu::FEATURE_BMI2 | cpu::FEATURE_ADX );
+#endif
+        return true;
+    }();
+    ( void )registered;
+    return dispatcher;
+}
@@ -0,0 +1,116 @@
+#include "kernel_x86_64.h"
+
+#if defined( __x86_64__ )
+
+#    include <immintrin.h>
+
+using namespace crypt_gost::core::math::kernel;
+
+// Carry chains via ADC/SBB are part of the x86-64 baseline, unlike compare-and-branch
+// detection of carry they keep the flag in the register between words.
+uint64_t x86_64::AddAdc( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept
+{
+    unsigned char carry = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        unsigned long long res;
+        carry = _addcarry_u64( carry, a[ i ], b[ i ], &res );
+        r[ i ] = res;
+    }
+    return carry;
+}
+
+uint64_t x86_64::SubSbb( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept
+{
+    unsigned char borrow = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        unsigned long long res;
+        borrow = _subborrow_u64( borrow, a[ i ], b[ i ], &res );
+        r[ i ] = res;
+    }
+    return borrow;
+}
+
+// Word and bit shifts are done in a single pass. Compiled for BMI2, variable shifts become
+// SHLX/SHRX, which take the count from any register and do not touch flags.
+__attribute__( ( target( "bmi2" ) ) ) void
+x86_64::ShiftLeftBmi2( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept
+{
+    size_t words = shift / 64;
+    unsigned int bits = shift % 64;
+
+    if( bits == 0 )
+    {
+        for( size_t i = n - 1; i >= words + 1; --i )
+        {
+            r[ i ] = a[ i - words ];
+        }
+    }
+    else
+    {
+        unsigned int backBits = 64 - bits;
+        for( size_t i = n - 1; i >= words + 1; --i )
+        {
+            r[ i ] = ( a[ i - words ] << bits ) | ( a[ i - words - 1 ] >> backBits );
+        }
+    }
+    r[ words ] = a[ 0 ] << bits;
+    for( size_t i = 0; i < words; ++i )
+    {
+        r[ i ] = 0;
+    }
+}
+
+__attribute__( ( target( "bmi2" ) ) ) void
+x86_64::ShiftRightBmi2( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept
+{
+    size_t words = shift / 64;
+    unsigned int bits = shift % 64;
+    size_t last = n - words - 1;
+
+    if( bits == 0 )
+    {
+        for( size_t i = 0; i <= last; ++i )
+        {
+            r[ i ] = a[ i + words ];
+        }
+    }
+    else
+    {
+        unsigned int backBits = 64 - bits;
+        for( size_t i = 0; i < last; ++i )
+        {
+            r[ i ] = ( a[ i + words ] >> bits ) | ( a[ i + words + 1 ] << backBits );
+        }
+        r[ last ] = a[ n - 1 ] >> bits;
+    }
+    for( size_t i = last + 1; i < n; ++i )
+    {
+        r[ i ] = 0;
+    }
+}
+
+// MULX leaves flags intact, and the product words and the result words are summed in two
+// separate carry variables. _addcarryx_u64 lets the compiler emit ADCX or ADOX, but does not
+// guarantee that the two chains go to different flags, so they may be serialized through CF.
+__attribute__( ( target( "bmi2,adx" ) ) ) uint64_t
+x86_64::AddMul1MulxAdx( uint64_t* r, const uint64_t* a, size_t n, uint64_t b ) noexcept
+{
+    unsigned long long high = 0;
+    unsigned char carryLow = 0;
+    unsigned char carryRes = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        unsigned long long nextHigh;
+        unsigned long long low = _mulx_u64( a[ i ], b, &nextHigh );
+        unsigned long long sum;
+        carryLow = _addcarryx_u64( carryLow, low, high, &sum );
+        carryRes = _addcarryx_u64( carryRes, sum, r[ i ], &sum );
+        r[ i ] = sum;
+        high = nextHigh;
+    }
+    return high + carryLow + carryRes;
+}
+
+#endif // __x86_64__
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined( __x86_64__ )
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+namespace kernel
+{
+
+namespace x86_64
+{
+
+uint64_t AddAdc( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept;
+
+uint64_t SubSbb( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept;
+
+void ShiftLeftBmi2( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept;
+
+void ShiftRightBmi2( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept;
+
+uint64_t AddMul1MulxAdx( uint64_t* r, const uint64_t* a, size_t n, uint64_t b ) noexcept;
+
+} // namespace x86_64
+
+} // namespace kernel
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
+
+#endif // __x86_64__
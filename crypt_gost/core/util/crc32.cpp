@@ -0,0 +1,39 @@
+#include <array>
+#include <core/util/crc32.hpp>
+
+using namespace crypt_gost::core;
+
+namespace
+{
+
+constexpr uint32_t POLYNOMIAL = 0xEDB88320;
+
+constexpr std::array< uint32_t, 256 > MakeTable() noexcept
+{
+    std::array< uint32_t, 256 > table{};
+    for( uint32_t i = 0; i < 256; ++i )
+    {
+        uint32_t value = i;
+        for( int bit = 0; bit < 8; ++bit )
+        {
+            value = ( value >> 1 ) ^ ( ( value & 1 ) != 0 ? POLYNOMIAL : 0 );
+        }
+        table[ i ] = value;
+    }
+    return table;
+}
+
+constexpr std::array< uint32_t, 256 > TABLE = MakeTable();
+
+} // namespace
+
+uint32_t util::Crc32( const void* data, size_t size, uint32_t crc ) noexcept
+{
+    const uint8_t* bytes = static_cast< const uint8_t* >( data );
+    crc = ~crc;
+    for( size_t i = 0; i < size; ++i )
+    {
+        crc = ( crc >> 8 ) ^ TABLE[ ( crc ^ bytes[ i ] ) & 0xFF ];
+    }
+    return ~crc;
+}
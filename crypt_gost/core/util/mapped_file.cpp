@@ -0,0 +1,112 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <core/util/mapped_file.hpp>
+
+using namespace crypt_gost::core::util;
+
+MappedFile::MappedFile( const char* path )
+{
+    int fd = open( path, O_RDONLY | O_CLOEXEC );
+    [[unlikely]] if( fd < 0 )
+    {
+        throw std::runtime_error( "Failed to open file" );
+    }
+    struct stat info;
+    [[unlikely]] if( fstat( fd, &info ) != 0 || info.st_size <= 0 )
+    {
+        close( fd );
+        throw std::runtime_error( "Failed to map file" );
+    }
+    size_t size = static_cast< size_t >( info.st_size );
+    void* data = mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+    // Mapping stays valid after the descriptor is closed.
+    close( fd );
+    [[unlikely]] if( data == MAP_FAILED )
+    {
+        throw std::runtime_error( "Failed to map file" );
+    }
+    data_ = static_cast< const uint8_t* >( data );
+    size_ = size;
+}
+
+MappedFile::MappedFile( MappedFile&& other ) noexcept
+    : data_( other.data_ )
+    , size_( other.size_ )
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept
+{
+    if( this != &other )
+    {
+        Unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    Unmap();
+}
+
+void MappedFile::Unmap() noexcept
+{
+    if( data_ != nullptr )
+    {
+        munmap( const_cast< uint8_t* >( data_ ), size_ );
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void crypt_gost::core::util::ReplaceFile( const char* path,
+                                          const ConstSegment* segments,
+                                          size_t count )
+{
+    std::string temporary = std::string( path ) + ".XXXXXX";
+    int fd = mkstemp( temporary.data() );
+    [[unlikely]] if( fd < 0 )
+    {
+        throw std::runtime_error( "Failed to create file" );
+    }
+    // mkstemp creates the file readable by the owner only.
+    bool ok = fchmod( fd, 0644 ) == 0;
+    for( size_t i = 0; ok && i < count; ++i )
+    {
+        const uint8_t* data = segments[ i ].data;
+        size_t left = segments[ i ].size;
+        while( ok && left > 0 )
+        {
+            ssize_t written = write( fd, data, left );
+            if( written > 0 )
+            {
+                data += written;
+                left -= static_cast< size_t >( written );
+            }
+            else
+            {
+                ok = written < 0 && errno == EINTR;
+            }
+        }
+    }
+    ok = fsync( fd ) == 0 && ok;
+    ok = close( fd ) == 0 && ok;
+    [[unlikely]] if( !ok || std::rename( temporary.c_str(), path ) != 0 )
+    {
+        unlink( temporary.c_str() );
+        throw std::runtime_error( "Failed to write file" );
+    }
+}
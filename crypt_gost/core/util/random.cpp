@@ -0,0 +1,24 @@
+#include <cerrno>
+#include <stdexcept>
+#include <sys/random.h>
+#include <core/util/random.hpp>
+
+using namespace crypt_gost::core::util;
+
+void random::Fill( uint8_t* data, size_t size )
+{
+    while( size > 0 )
+    {
+        ssize_t read = getrandom( data, size, 0 );
+        if( read < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+            throw std::runtime_error( "Random number generator failure" );
+        }
+        data += read;
+        size -= static_cast< size_t >( read );
+    }
+}
@@ -0,0 +1,103 @@
+#include <stdexcept>
+#include <core/util/thread_pool.hpp>
+
+using namespace crypt_gost::core::util;
+
+ThreadPool::ThreadPool( size_t threadCount )
+{
+    if( threadCount == 0 )
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    try
+    {
+        for( size_t i = 1; i < threadCount; ++i )
+        {
+            workers_.emplace_back( [ this ] { WorkerLoop(); } );
+        }
+    }
+    catch( const std::exception& )
+    {
+        Stop();
+        throw std::runtime_error( "Failed to start thread" );
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    Stop();
+}
+
+void ThreadPool::Stop() noexcept
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        stop_ = true;
+    }
+    start_.notify_all();
+    for( std::thread& worker : workers_ )
+    {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void ThreadPool::Run( size_t count, TaskFn fn, const void* context ) noexcept
+{
+    if( workers_.empty() || count <= 1 )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            fn( context, i );
+        }
+        return;
+    }
+
+    std::lock_guard< std::mutex > run( runMutex_ );
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        fn_ = fn;
+        context_ = context;
+        count_ = count;
+        next_.store( 0, std::memory_order_relaxed );
+        busy_ = workers_.size();
+        ++generation_;
+    }
+    start_.notify_all();
+    Work();
+
+    // Every worker checks in, so none of them still reads the task of this call.
+    std::unique_lock< std::mutex > lock( mutex_ );
+    done_.wait( lock, [ this ] { return busy_ == 0; } );
+}
+
+void ThreadPool::Work() noexcept
+{
+    for( size_t i = next_.fetch_add( 1, std::memory_order_relaxed ); i < count_;
+         i = next_.fetch_add( 1, std::memory_order_relaxed ) )
+    {
+        fn_( context_, i );
+    }
+}
+
+void ThreadPool::WorkerLoop() noexcept
+{
+    size_t seen = 0;
+    std::unique_lock< std::mutex > lock( mutex_ );
+    for( ;; )
+    {
+        start_.wait( lock, [ this, seen ] { return stop_ || generation_ != seen; } );
+        if( stop_ )
+        {
+            return;
+        }
+        seen = generation_;
+        lock.unlock();
+        Work();
+        lock.lock();
+        if( --busy_ == 0 )
+        {
+            done_.notify_one();
+        }
+    }
+}
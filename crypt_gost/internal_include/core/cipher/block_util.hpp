@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <core/util/thread_pool.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+namespace block
+{
+
+/**
+ * @brief out = in ^ gamma, \p in and \p out may be the same.
+ *
+ * Words are used since a byte loop over possibly overlapping buffers is not vectorized.
+ */
+inline void Xor( const uint8_t* in, const uint8_t* gamma, uint8_t* out, size_t size ) noexcept
+{
+    size_t i = 0;
+    for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+    {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy( &a, in + i, sizeof( a ) );
+        std::memcpy( &b, gamma + i, sizeof( b ) );
+        a ^= b;
+        std::memcpy( out + i, &a, sizeof( a ) );
+    }
+    for( ; i < size; ++i )
+    {
+        out[ i ] = in[ i ] ^ gamma[ i ];
+    }
+}
+
+/**
+ * @brief Shift \p size bytes of \p data into the register of \p registerSize bytes from the
+ * end, so it keeps the last \p registerSize bytes of the register followed by \p data.
+ */
+inline void Shift( uint8_t* reg, size_t registerSize, const uint8_t* data, size_t size ) noexcept
+{
+    if( size >= registerSize )
+    {
+        std::memcpy( reg, data + size - registerSize, registerSize );
+        return;
+    }
+    std::memmove( reg, reg + size, registerSize - size );
+    std::memcpy( reg + registerSize - size, data, size );
+}
+
+inline uint32_t LoadBigEndian32( const uint8_t* data ) noexcept
+{
+    return static_cast< uint32_t >( data[ 0 ] ) << 24 | static_cast< uint32_t >( data[ 1 ] ) << 16
+           | static_cast< uint32_t >( data[ 2 ] ) << 8 | static_cast< uint32_t >( data[ 3 ] );
+}
+
+inline uint64_t LoadBigEndian64( const uint8_t* data ) noexcept
+{
+    return static_cast< uint64_t >( LoadBigEndian32( data ) ) << 32 | LoadBigEndian32( data + 4 );
+}
+
+inline void StoreBigEndian32( uint8_t* data, uint32_t value ) noexcept
+{
+    data[ 0 ] = static_cast< uint8_t >( value >> 24 );
+    data[ 1 ] = static_cast< uint8_t >( value >> 16 );
+    data[ 2 ] = static_cast< uint8_t >( value >> 8 );
+    data[ 3 ] = static_cast< uint8_t >( value );
+}
+
+inline void StoreBigEndian64( uint8_t* data, uint64_t value ) noexcept
+{
+    StoreBigEndian32( data, static_cast< uint32_t >( value >> 32 ) );
+    StoreBigEndian32( data + 4, static_cast< uint32_t >( value ) );
+}
+
+/**
+ * @brief Size of the stack buffers of the modes, long inputs are processed in chunks of it.
+ */
+constexpr size_t CHUNK_SIZE = 4096;
+
+/**
+ * @brief Minimum size of a task when a mode splits its input between threads.
+ */
+constexpr size_t MIN_TASK_SIZE = 64 * 1024;
+
+/**
+ * @brief Whether \p size bytes are split between threads of \p pool, which may be nullptr.
+ */
+inline bool IsParallel( const util::ThreadPool* pool, size_t size ) noexcept
+{
+    return pool != nullptr && pool->GetThreadCount() > 1 && size >= 2 * MIN_TASK_SIZE;
+}
+
+/**
+ * @brief Blocks split into consecutive tasks, one per thread but of at least MIN_TASK_SIZE
+ * bytes each.
+ */
+struct TaskSplit
+{
+    // Blocks of each task but the last one, which may be shorter.
+    size_t taskBlocks;
+    size_t taskCount;
+};
+
+inline TaskSplit SplitTasks( const util::ThreadPool& pool, size_t count, size_t blockSize ) noexcept
+{
+    size_t threads = pool.GetThreadCount();
+    size_t taskBlocks = ( count + threads - 1 ) / threads;
+    if( taskBlocks < MIN_TASK_SIZE / blockSize )
+    {
+        taskBlocks = MIN_TASK_SIZE / blockSize;
+    }
+    return { taskBlocks, ( count + taskBlocks - 1 ) / taskBlocks };
+}
+
+/**
+ * @brief Run task( t, first, n ) on \p pool for every task t of \p split of \p count blocks,
+ * which covers blocks first .. first + n - 1.
+ */
+template < typename Task >
+void RunTasks( util::ThreadPool& pool, const TaskSplit& split, size_t count, const Task& task )
+{
+    pool.Run( split.taskCount, [ & ]( size_t t ) {
+        size_t first = t * split.taskBlocks;
+        size_t n = count - first < split.taskBlocks ? count - first : split.taskBlocks;
+        task( t, first, n );
+    } );
+}
+
+/**
+ * @brief Decrypt \p count blocks on \p pool in a mode where a block depends on the preceding
+ * ciphertext only through the shift register \p reg, as CBC and CFB, and advance \p reg.
+ *
+ * Every task starts from the register filled with the ciphertext that precedes it. The
+ * registers are taken before any output is written, since \p out may be \p in.
+ *
+ * @param[in] decryptRange Called as decryptRange( reg, in, out, n ) to decrypt n blocks with
+ * a task register, which it advances.
+ */
+template < typename DecryptRange >
+void DecryptChained( util::ThreadPool& pool,
+                     uint8_t* reg,
+                     size_t registerSize,
+                     size_t blockSize,
+                     const uint8_t* in,
+                     uint8_t* out,
+                     size_t count,
+                     const DecryptRange& decryptRange )
+{
+    TaskSplit split = SplitTasks( pool, count, blockSize );
+    std::vector< uint8_t > registers( split.taskCount * registerSize );
+    for( size_t t = 0; t < split.taskCount; ++t )
+    {
+        uint8_t* taskReg = registers.data() + t * registerSize;
+        std::memcpy( taskReg, reg, registerSize );
+        Shift( taskReg, registerSize, in, t * split.taskBlocks * blockSize );
+    }
+    Shift( reg, registerSize, in, count * blockSize );
+
+    RunTasks( pool, split, count, [ & ]( size_t t, size_t first, size_t n ) {
+        decryptRange( registers.data() + t * registerSize,
+                      in + first * blockSize,
+                      out + first * blockSize,
+                      n );
+    } );
+}
+
+} // namespace block
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
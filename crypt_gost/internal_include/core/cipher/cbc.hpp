@@ -0,0 +1,258 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <core/cipher/block_util.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Cipher block chaining mode, GOST R 34.13-2015, for Kuznyechik or Magma.
+ *
+ * The IV of z blocks fills a shift register, and block i is encrypted as
+ * C_i = E_K( P_i ^ C_i-z ), where C_-z .. C_-1 is the IV. Data thus forms z interleaved
+ * chains, so encryption passes z blocks to every EncryptBlocks call.
+ *
+ * Decryption P_i = D_K( C_i ) ^ C_i-z depends on ciphertext only, runs of blocks are
+ * decrypted by one DecryptBlocks call, and given a thread pool long inputs are split into
+ * tasks of at least block::MIN_TASK_SIZE bytes, each starting from the ciphertext that precedes it.
+ *
+ * Padding is left to the caller, Encrypt and Decrypt take whole blocks and may be called
+ * any number of times. Segments may split blocks, only those blocks are gathered into a
+ * buffer and written back. A context is used in one direction.
+ */
+template < typename Cipher >
+class Cbc final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = Cipher::BLOCK_SIZE;
+    static constexpr size_t KEY_SIZE = Cipher::KEY_SIZE;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     * @param[in] iv \p ivSize bytes.
+     * @param[in] ivSize A nonzero multiple of BLOCK_SIZE.
+     *
+     * @throw std::runtime_error If IV size is not supported, or the cipher cannot be created.
+     */
+    Cbc( const uint8_t* key, const uint8_t* iv, size_t ivSize = BLOCK_SIZE )
+        : cipher_( key )
+        , register_()
+    {
+        [[unlikely]] if( ivSize == 0 || ivSize % BLOCK_SIZE != 0 )
+        {
+            throw std::runtime_error( "Invalid IV size" );
+        }
+        register_.assign( iv, iv + ivSize );
+    }
+
+    Cbc( const Cbc& ) = delete;
+    Cbc& operator=( const Cbc& ) = delete;
+
+    /**
+     * @brief Encrypt next \p size bytes, \p in and \p out may be the same.
+     *
+     * @throw std::runtime_error If size is not a multiple of BLOCK_SIZE.
+     */
+    void Encrypt( const uint8_t* in, uint8_t* out, size_t size )
+    {
+        CheckSize( size );
+        EncryptBlocks( in, out, size / BLOCK_SIZE );
+    }
+
+    /**
+     * @brief Decrypt next \p size bytes, \p in and \p out may be the same.
+     *
+     * @param[in] pool Threads for long inputs, or nullptr to run in the calling thread.
+     *
+     * @throw std::runtime_error If size is not a multiple of BLOCK_SIZE.
+     */
+    void Decrypt( const uint8_t* in, uint8_t* out, size_t size, util::ThreadPool* pool = nullptr )
+    {
+        CheckSize( size );
+        DecryptBlocks( in, out, size / BLOCK_SIZE, pool );
+    }
+
+    /**
+     * @brief Encrypt \p count segments in place.
+     *
+     * @throw std::runtime_error If total size is not a multiple of BLOCK_SIZE.
+     */
+    void Encrypt( const util::Segment* segments, size_t count )
+    {
+        ProcessSegments< true >( segments, count, nullptr );
+    }
+
+    /**
+     * @brief Decrypt \p count segments in place.
+     *
+     * @param[in] pool Threads for long segments, or nullptr to run in the calling thread.
+     *
+     * @throw std::runtime_error If total size is not a multiple of BLOCK_SIZE.
+     */
+    void Decrypt( const util::Segment* segments, size_t count, util::ThreadPool* pool = nullptr )
+    {
+        ProcessSegments< false >( segments, count, pool );
+    }
+
+private:
+    // Blocks decrypted at once, and the buffer on the stack.
+    static constexpr size_t CHUNK_BLOCKS = block::CHUNK_SIZE / BLOCK_SIZE;
+
+    static inline void CheckSize( size_t size )
+    {
+        [[unlikely]] if( size % BLOCK_SIZE != 0 )
+        {
+            throw std::runtime_error( "Invalid data size" );
+        }
+    }
+
+    void EncryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) noexcept
+    {
+        size_t chains = register_.size() / BLOCK_SIZE;
+        while( count != 0 )
+        {
+            size_t n = count < chains ? count : chains;
+            n = n < CHUNK_BLOCKS ? n : CHUNK_BLOCKS;
+            block::Xor( in, register_.data(), out, n * BLOCK_SIZE );
+            cipher_.EncryptBlocks( out, out, n );
+            block::Shift( register_.data(), register_.size(), out, n * BLOCK_SIZE );
+            in += n * BLOCK_SIZE;
+            out += n * BLOCK_SIZE;
+            count -= n;
+        }
+    }
+
+    void DecryptBlocks( const uint8_t* in, uint8_t* out, size_t count, util::ThreadPool* pool )
+    {
+        if( block::IsParallel( pool, count * BLOCK_SIZE ) )
+        {
+            auto decrypt = [ this ]( uint8_t* reg, const uint8_t* from, uint8_t* to, size_t n ) {
+                DecryptRange( reg, from, to, n );
+            };
+            block::DecryptChained( *pool,
+                                   register_.data(),
+                                   register_.size(),
+                                   BLOCK_SIZE,
+                                   in,
+                                   out,
+                                   count,
+                                   decrypt );
+        }
+        else
+        {
+            DecryptRange( register_.data(), in, out, count );
+        }
+    }
+
+    // Whole blocks of a segment are processed where they are, a block split between segments
+    // is gathered from its pieces, processed and scattered back.
+    template < bool encrypt >
+    void ProcessSegments( const util::Segment* segments, size_t count, util::ThreadPool* pool )
+    {
+        CheckSize( util::TotalSize( segments, count ) );
+        uint8_t gathered[ BLOCK_SIZE ];
+        util::Segment pieces[ BLOCK_SIZE ];
+        size_t pieceCount = 0;
+        size_t used = 0;
+        for( size_t i = 0; i < count; ++i )
+        {
+            uint8_t* data = segments[ i ].data;
+            size_t size = segments[ i ].size;
+            if( used != 0 && size != 0 )
+            {
+                size_t n = size < BLOCK_SIZE - used ? size : BLOCK_SIZE - used;
+                std::memcpy( gathered + used, data, n );
+                pieces[ pieceCount++ ] = { data, n };
+                used += n;
+                data += n;
+                size -= n;
+                if( used == BLOCK_SIZE )
+                {
+                    if constexpr( encrypt )
+                    {
+                        EncryptBlocks( gathered, gathered, 1 );
+                    }
+                    else
+                    {
+                        DecryptRange( register_.data(), gathered, gathered, 1 );
+                    }
+                    for( size_t p = 0, offset = 0; p < pieceCount; offset += pieces[ p++ ].size )
+                    {
+                        std::memcpy( pieces[ p ].data, gathered + offset, pieces[ p ].size );
+                    }
+                    pieceCount = 0;
+                    used = 0;
+                }
+            }
+            if( used != 0 )
+            {
+                continue;
+            }
+            size_t blocks = size / BLOCK_SIZE;
+            if constexpr( encrypt )
+            {
+                EncryptBlocks( data, data, blocks );
+            }
+            else
+            {
+                DecryptBlocks( data, data, blocks, pool );
+            }
+            used = size % BLOCK_SIZE;
+            if( used != 0 )
+            {
+                data += blocks * BLOCK_SIZE;
+                std::memcpy( gathered, data, used );
+                pieces[ pieceCount++ ] = { data, used };
+            }
+        }
+        util::SecureZero( gathered, sizeof( gathered ) );
+    }
+
+    // Decrypt with the shift register \p reg, which is advanced past \p count blocks.
+    void DecryptRange( uint8_t* reg, const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+    {
+        const size_t registerSize = register_.size();
+        uint8_t work[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            size_t n = count < CHUNK_BLOCKS ? count : CHUNK_BLOCKS;
+            size_t size = n * BLOCK_SIZE;
+            size_t head = size < registerSize ? size : registerSize;
+            cipher_.DecryptBlocks( in, work, n );
+            block::Xor( work, reg, work, head );
+            block::Xor( work + head, in, work + head, size - head );
+            block::Shift( reg, registerSize, in, size );
+            std::memcpy( out, work, size );
+            in += size;
+            out += size;
+            count -= n;
+        }
+        util::SecureZero( work, sizeof( work ) );
+    }
+
+    Cipher cipher_;
+    // Last z blocks of ciphertext, the oldest first.
+    std::vector< uint8_t > register_;
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
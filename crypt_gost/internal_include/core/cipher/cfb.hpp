@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <core/cipher/block_util.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Cipher feedback mode, GOST R 34.13-2015, with segments of a whole block, for
+ * Kuznyechik or Magma.
+ *
+ * The IV of z blocks fills a shift register, and block i is encrypted as
+ * C_i = P_i ^ E_K( C_i-z ), where C_-z .. C_-1 is the IV. Data thus forms z interleaved
+ * chains, so encryption passes z blocks to every EncryptBlocks call.
+ *
+ * Decryption P_i = C_i ^ E_K( C_i-z ) depends on ciphertext only, gamma of a run of blocks is
+ * produced by one EncryptBlocks call, and given a thread pool long inputs are split into
+ * tasks of at least block::MIN_TASK_SIZE bytes, each starting from the ciphertext that precedes it.
+ *
+ * Encrypt and Decrypt may be called any number of times with data of any size, the last
+ * segment of a message may be partial. A context is used in one direction.
+ */
+template < typename Cipher >
+class Cfb final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = Cipher::BLOCK_SIZE;
+    static constexpr size_t KEY_SIZE = Cipher::KEY_SIZE;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     * @param[in] iv \p ivSize bytes.
+     * @param[in] ivSize A nonzero multiple of BLOCK_SIZE.
+     *
+     * @throw std::runtime_error If IV size is not supported, or the cipher cannot be created.
+     */
+    Cfb( const uint8_t* key, const uint8_t* iv, size_t ivSize = BLOCK_SIZE )
+        : cipher_( key )
+        , register_()
+        , used_( 0 )
+        , gamma_()
+        , segment_()
+    {
+        [[unlikely]] if( ivSize == 0 || ivSize % BLOCK_SIZE != 0 )
+        {
+            throw std::runtime_error( "Invalid IV size" );
+        }
+        register_.assign( iv, iv + ivSize );
+    }
+
+    Cfb( const Cfb& ) = delete;
+    Cfb& operator=( const Cfb& ) = delete;
+
+    ~Cfb() noexcept
+    {
+        util::SecureZero( gamma_, sizeof( gamma_ ) );
+    }
+
+    /**
+     * @brief Encrypt next \p size bytes, \p in and \p out may be the same.
+     */
+    void Encrypt( const uint8_t* in, uint8_t* out, size_t size )
+    {
+        Process< true >( in, out, size, nullptr );
+    }
+
+    /**
+     * @brief Decrypt next \p size bytes, \p in and \p out may be the same.
+     *
+     * @param[in] pool Threads for long inputs, or nullptr to run in the calling thread.
+     */
+    void Decrypt( const uint8_t* in, uint8_t* out, size_t size, util::ThreadPool* pool = nullptr )
+    {
+        Process< false >( in, out, size, pool );
+    }
+
+    /**
+     * @brief Encrypt \p count segments in place, continuing the stream.
+     *
+     * A block split between segments uses the gamma and ciphertext kept between calls, so no
+     * data is copied.
+     */
+    void Encrypt( const util::Segment* segments, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            Process< true >( segments[ i ].data, segments[ i ].data, segments[ i ].size, nullptr );
+        }
+    }
+
+    /**
+     * @brief Decrypt \p count segments in place, continuing the stream.
+     *
+     * @param[in] pool Threads for long segments, or nullptr to run in the calling thread.
+     */
+    void Decrypt( const util::Segment* segments, size_t count, util::ThreadPool* pool = nullptr )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            Process< false >( segments[ i ].data, segments[ i ].data, segments[ i ].size, pool );
+        }
+    }
+
+private:
+    // Blocks processed at once, and the buffer on the stack.
+    static constexpr size_t CHUNK_BLOCKS = block::CHUNK_SIZE / BLOCK_SIZE;
+
+    // Up to the end of the current block, collecting its ciphertext.
+    template < bool encrypt >
+    inline void ProcessPartial( const uint8_t* in, uint8_t* out, size_t size ) noexcept
+    {
+        if constexpr( encrypt )
+        {
+            block::Xor( in, gamma_ + used_, out, size );
+            std::memcpy( segment_ + used_, out, size );
+        }
+        else
+        {
+            std::memcpy( segment_ + used_, in, size );
+            block::Xor( in, gamma_ + used_, out, size );
+        }
+        used_ += size;
+        if( used_ == BLOCK_SIZE )
+        {
+            block::Shift( register_.data(), register_.size(), segment_, BLOCK_SIZE );
+            used_ = 0;
+        }
+    }
+
+    template < bool encrypt >
+    void Process( const uint8_t* in, uint8_t* out, size_t size, util::ThreadPool* pool )
+    {
+        if( used_ != 0 )
+        {
+            size_t n = size < BLOCK_SIZE - used_ ? size : BLOCK_SIZE - used_;
+            ProcessPartial< encrypt >( in, out, n );
+            in += n;
+            out += n;
+            size -= n;
+        }
+
+        size_t blocks = size / BLOCK_SIZE;
+        if constexpr( encrypt )
+        {
+            EncryptRange( in, out, blocks );
+        }
+        else if( block::IsParallel( pool, blocks * BLOCK_SIZE ) )
+        {
+            auto decrypt = [ this ]( uint8_t* reg, const uint8_t* from, uint8_t* to, size_t n ) {
+                DecryptRange( reg, from, to, n );
+            };
+            block::DecryptChained( *pool,
+                                   register_.data(),
+                                   register_.size(),
+                                   BLOCK_SIZE,
+                                   in,
+                                   out,
+                                   blocks,
+                                   decrypt );
+        }
+        else
+        {
+            DecryptRange( register_.data(), in, out, blocks );
+        }
+        in += blocks * BLOCK_SIZE;
+        out += blocks * BLOCK_SIZE;
+        size -= blocks * BLOCK_SIZE;
+
+        if( size != 0 )
+        {
+            cipher_.EncryptBlock( register_.data(), gamma_ );
+            ProcessPartial< encrypt >( in, out, size );
+        }
+    }
+
+    void EncryptRange( const uint8_t* in, uint8_t* out, size_t count ) noexcept
+    {
+        size_t chains = register_.size() / BLOCK_SIZE;
+        uint8_t gamma[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            size_t n = count < chains ? count : chains;
+            n = n < CHUNK_BLOCKS ? n : CHUNK_BLOCKS;
+            cipher_.EncryptBlocks( register_.data(), gamma, n );
+            block::Xor( in, gamma, out, n * BLOCK_SIZE );
+            block::Shift( register_.data(), register_.size(), out, n * BLOCK_SIZE );
+            in += n * BLOCK_SIZE;
+            out += n * BLOCK_SIZE;
+            count -= n;
+        }
+        util::SecureZero( gamma, sizeof( gamma ) );
+    }
+
+    // Decrypt with the shift register \p reg, which is advanced past \p count blocks.
+    void DecryptRange( uint8_t* reg, const uint8_t* in, uint8_t* out, size_t count ) const noexcept
+    {
+        const size_t registerSize = register_.size();
+        uint8_t gamma[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            size_t n = count < CHUNK_BLOCKS ? count : CHUNK_BLOCKS;
+            size_t size = n * BLOCK_SIZE;
+            size_t head = size < registerSize ? size : registerSize;
+            std::memcpy( gamma, reg, head );
+            std::memcpy( gamma + head, in, size - head );
+            cipher_.EncryptBlocks( gamma, gamma, n );
+            block::Shift( reg, registerSize, in, size );
+            block::Xor( in, gamma, out, size );
+            in += size;
+            out += size;
+            count -= n;
+        }
+        util::SecureZero( gamma, sizeof( gamma ) );
+    }
+
+    Cipher cipher_;
+    // Last z blocks of ciphertext, the oldest first.
+    std::vector< uint8_t > register_;
+    // Bytes of the current block processed, whose gamma and ciphertext are kept.
+    size_t used_;
+    uint8_t gamma_[ BLOCK_SIZE ];
+    uint8_t segment_[ BLOCK_SIZE ];
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
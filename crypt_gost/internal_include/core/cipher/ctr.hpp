@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <core/cipher/block_util.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Counter mode, GOST R 34.13-2015, and CTR-ACPKM with key meshing, R 1323565.1.017-2018
+ * (RFC 8645), for Kuznyechik or Magma.
+ *
+ * Counter starts as the IV followed by zero bytes and is incremented as a big-endian number
+ * of BLOCK_SIZE bytes. Gamma is produced by encrypting runs of counters with EncryptBlocks,
+ * so the vector kernels of the cipher apply.
+ *
+ * In CTR-ACPKM the data is split into sections of sectionSize bytes, and every section after
+ * the first is encrypted with the key K' = E_K( D_1 | ... ) of the previous section, where D
+ * is the bytes 0x80 .. 0x9F. The counter is not reset between sections.
+ *
+ * Process may be called any number of times, encryption and decryption are the same. Given a
+ * thread pool, long inputs are split by counter offset into tasks of at least block::MIN_TASK_SIZE
+ * bytes. Section keys form a chain which is walked once in the calling thread to find the key
+ * of every task start, tasks derive keys of their further sections themselves.
+ *
+ * ProcessMany encrypts independent CTR messages, each under its own key, in one pass.
+ */
+template < typename Cipher >
+class Ctr final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = Cipher::BLOCK_SIZE;
+    static constexpr size_t KEY_SIZE = Cipher::KEY_SIZE;
+    static constexpr size_t IV_SIZE = BLOCK_SIZE / 2;
+
+    /**
+     * @brief Completion status of a job of ProcessMany.
+     */
+    enum class JobStatus
+    {
+        COMPLETED,
+        INVALID_ARGUMENTS
+    };
+
+    /**
+     * @brief Message for ProcessMany, encrypted or decrypted in place from the start of a CTR
+     * stream under its own key.
+     */
+    struct Job
+    {
+        // Cipher holding the key of the message.
+        const Cipher* cipher;
+        // IV_SIZE bytes.
+        const uint8_t* iv;
+        uint8_t* data;
+        size_t size;
+        // Set by ProcessMany.
+        JobStatus status;
+    };
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     * @param[in] iv IV_SIZE bytes.
+     * @param[in] sectionSize Section size of CTR-ACPKM in bytes, a multiple of BLOCK_SIZE, or
+     * 0 for CTR.
+     *
+     * @throw std::runtime_error If section size is not a multiple of block size, or the
+     * cipher cannot be created.
+     */
+    Ctr( const uint8_t* key, const uint8_t* iv, size_t sectionSize = 0 )
+        : cipher_( key )
+        , sectionBlocks_( sectionSize / BLOCK_SIZE )
+        , section_( 0 )
+        , position_( 0 )
+        , initialCounter_()
+        , gamma_()
+    {
+        [[unlikely]] if( sectionSize % BLOCK_SIZE != 0 )
+        {
+            throw std::runtime_error( "Invalid section size" );
+        }
+        std::memcpy( initialCounter_, iv, IV_SIZE );
+    }
+
+    Ctr( const Ctr& ) = delete;
+    Ctr& operator=( const Ctr& ) = delete;
+
+    ~Ctr() noexcept
+    {
+        util::SecureZero( gamma_, sizeof( gamma_ ) );
+    }
+
+    /**
+     * @brief Encrypt or decrypt next \p size bytes, \p in and \p out may be the same.
+     *
+     * @param[in] pool Threads for long inputs, or nullptr to run in the calling thread.
+     */
+    void Process( const uint8_t* in, uint8_t* out, size_t size, util::ThreadPool* pool = nullptr )
+    {
+        size_t used = position_ % BLOCK_SIZE;
+        if( used != 0 )
+        {
+            size_t n = size < BLOCK_SIZE - used ? size : BLOCK_SIZE - used;
+            block::Xor( in, gamma_ + used, out, n );
+            in += n;
+            out += n;
+            size -= n;
+            position_ += n;
+        }
+
+        size_t blocks = size / BLOCK_SIZE;
+        if( blocks != 0 )
+        {
+            uint64_t index = position_ / BLOCK_SIZE;
+            if( block::IsParallel( pool, blocks * BLOCK_SIZE ) )
+            {
+                ProcessParallel( *pool, index, in, out, blocks );
+            }
+            else
+            {
+                ProcessRange( cipher_, section_, index, in, out, blocks );
+            }
+            in += blocks * BLOCK_SIZE;
+            out += blocks * BLOCK_SIZE;
+            size -= blocks * BLOCK_SIZE;
+            position_ += blocks * BLOCK_SIZE;
+        }
+
+        if( size != 0 )
+        {
+            const uint8_t zero[ BLOCK_SIZE ] = {};
+            ProcessRange( cipher_, section_, position_ / BLOCK_SIZE, zero, gamma_, 1 );
+            block::Xor( in, gamma_, out, size );
+            position_ += size;
+        }
+    }
+
+    /**
+     * @brief Encrypt or decrypt \p count segments in place, continuing the stream.
+     *
+     * A block split between segments uses the gamma kept between calls, so no data is copied.
+     *
+     * @param[in] pool Threads for long segments, or nullptr to run in the calling thread.
+     */
+    void Process( const util::Segment* segments, size_t count, util::ThreadPool* pool = nullptr )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            Process( segments[ i ].data, segments[ i ].data, segments[ i ].size, pool );
+        }
+    }
+
+    /**
+     * @brief Encrypt or decrypt independent messages, each with its own key and IV, e.g. the
+     * records of many sessions.
+     *
+     * Counters of consecutive jobs are collected into one buffer and encrypted by
+     * Cipher::EncryptBlocksMultiKey with the key of each block, so messages of a few blocks
+     * under different keys fill the vector lanes together. A job whose cipher or IV is null,
+     * or whose data is null but not empty, is left unchanged and reported as
+     * INVALID_ARGUMENTS, the others as COMPLETED. Data of different jobs must not overlap.
+     *
+     * @param[in,out] jobs Jobs, their status is set.
+     * @param[in] count Number of jobs.
+     */
+    static void ProcessMany( Job* jobs, size_t count ) noexcept
+    {
+        uint8_t gamma[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        const Cipher* ciphers[ CHUNK_BLOCKS ];
+        // Data of the buffered blocks, every piece starts a block.
+        util::Segment pieces[ CHUNK_BLOCKS ];
+        size_t pieceCount = 0;
+        size_t blocks = 0;
+        auto flush = [ & ]() {
+            Cipher::EncryptBlocksMultiKey( ciphers, gamma, gamma, blocks );
+            for( size_t p = 0, offset = 0; p < pieceCount; ++p )
+            {
+                block::Xor( pieces[ p ].data, gamma + offset, pieces[ p ].data, pieces[ p ].size );
+                offset += ( pieces[ p ].size + BLOCK_SIZE - 1 ) / BLOCK_SIZE * BLOCK_SIZE;
+            }
+            pieceCount = 0;
+            blocks = 0;
+        };
+
+        for( size_t j = 0; j < count; ++j )
+        {
+            Job& job = jobs[ j ];
+            [[unlikely]] if( job.cipher == nullptr || job.iv == nullptr
+                             || ( job.data == nullptr && job.size != 0 ) )
+            {
+                job.status = JobStatus::INVALID_ARGUMENTS;
+                continue;
+            }
+            uint8_t initial[ BLOCK_SIZE ] = {};
+            std::memcpy( initial, job.iv, IV_SIZE );
+            uint64_t index = 0;
+            for( size_t offset = 0; offset < job.size; )
+            {
+                size_t n = ( job.size - offset + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+                n = n < CHUNK_BLOCKS - blocks ? n : CHUNK_BLOCKS - blocks;
+                size_t size = job.size - offset < n * BLOCK_SIZE ? job.size - offset
+                                                                 : n * BLOCK_SIZE;
+                FillCounters( initial, index, gamma + blocks * BLOCK_SIZE, n );
+                for( size_t i = 0; i < n; ++i )
+                {
+                    ciphers[ blocks + i ] = job.cipher;
+                }
+                pieces[ pieceCount++ ] = { job.data + offset, size };
+                blocks += n;
+                index += n;
+                offset += size;
+                if( blocks == CHUNK_BLOCKS )
+                {
+                    flush();
+                }
+            }
+            job.status = JobStatus::COMPLETED;
+        }
+        if( blocks != 0 )
+        {
+            flush();
+        }
+        util::SecureZero( gamma, sizeof( gamma ) );
+    }
+
+private:
+    // Counters encrypted at once, and the gamma buffer on the stack.
+    static constexpr size_t CHUNK_BLOCKS = block::CHUNK_SIZE / BLOCK_SIZE;
+
+    // Carry out of the low word into the rest of the counter.
+    static inline void IncrementHigh( uint8_t* counter ) noexcept
+    {
+        for( size_t i = BLOCK_SIZE - sizeof( uint64_t ); i > 0; --i )
+        {
+            if( ++counter[ i - 1 ] != 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    // Initial counter plus \p index.
+    static inline void CounterAt( const uint8_t* initial,
+                                  uint64_t index,
+                                  uint8_t* counter ) noexcept
+    {
+        uint64_t carry = 0;
+        for( size_t i = BLOCK_SIZE; i > 0; --i )
+        {
+            uint64_t sum = initial[ i - 1 ] + ( index & 0xff ) + carry;
+            counter[ i - 1 ] = static_cast< uint8_t >( sum );
+            carry = sum >> 8;
+            index >>= 8;
+        }
+    }
+
+    // \p count consecutive counters starting at block \p index.
+    static void FillCounters( const uint8_t* initial,
+                              uint64_t index,
+                              uint8_t* counters,
+                              size_t count ) noexcept
+    {
+        CounterAt( initial, index, counters );
+        constexpr size_t HIGH_SIZE = BLOCK_SIZE - sizeof( uint64_t );
+        uint64_t low = block::LoadBigEndian64( counters + HIGH_SIZE );
+        for( size_t i = 1; i < count; ++i )
+        {
+            uint8_t* counter = counters + i * BLOCK_SIZE;
+            std::memcpy( counter, counter - BLOCK_SIZE, HIGH_SIZE );
+            block::StoreBigEndian64( counter + HIGH_SIZE, ++low );
+            [[unlikely]] if( low == 0 )
+            {
+                IncrementHigh( counter );
+            }
+        }
+    }
+
+    // K' = E_K( D_1 | ... ), truncated to KEY_SIZE bytes.
+    static void NextKey( Cipher& cipher ) noexcept
+    {
+        uint8_t d[ KEY_SIZE ];
+        for( size_t i = 0; i < KEY_SIZE; ++i )
+        {
+            d[ i ] = static_cast< uint8_t >( 0x80 + i );
+        }
+        uint8_t key[ KEY_SIZE ];
+        cipher.EncryptBlocks( d, key, KEY_SIZE / BLOCK_SIZE );
+        cipher.SetKey( key );
+        util::SecureZero( key, sizeof( key ) );
+    }
+
+    // Advance \p cipher holding the key of \p section to the section of block \p index.
+    inline void SeekSection( Cipher& cipher, uint64_t& section, uint64_t index ) const noexcept
+    {
+        if( sectionBlocks_ == 0 )
+        {
+            return;
+        }
+        for( ; section < index / sectionBlocks_; ++section )
+        {
+            NextKey( cipher );
+        }
+    }
+
+    void ProcessRange( Cipher& cipher,
+                       uint64_t& section,
+                       uint64_t index,
+                       const uint8_t* in,
+                       uint8_t* out,
+                       size_t count ) const noexcept
+    {
+        uint8_t gamma[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            SeekSection( cipher, section, index );
+            size_t n = count < CHUNK_BLOCKS ? count : CHUNK_BLOCKS;
+            if( sectionBlocks_ != 0 && n > sectionBlocks_ - index % sectionBlocks_ )
+            {
+                n = sectionBlocks_ - index % sectionBlocks_;
+            }
+            FillCounters( initialCounter_, index, gamma, n );
+            cipher.EncryptBlocks( gamma, gamma, n );
+            block::Xor( in, gamma, out, n * BLOCK_SIZE );
+            in += n * BLOCK_SIZE;
+            out += n * BLOCK_SIZE;
+            index += n;
+            count -= n;
+        }
+        util::SecureZero( gamma, sizeof( gamma ) );
+    }
+
+    void ProcessParallel( util::ThreadPool& pool,
+                          uint64_t index,
+                          const uint8_t* in,
+                          uint8_t* out,
+                          size_t count )
+    {
+        block::TaskSplit split = block::SplitTasks( pool, count, BLOCK_SIZE );
+        std::vector< Cipher > ciphers;
+        std::vector< uint64_t > sections;
+        ciphers.reserve( split.taskCount );
+        sections.reserve( split.taskCount );
+        for( size_t t = 0; t < split.taskCount; ++t )
+        {
+            SeekSection( cipher_, section_, index + t * split.taskBlocks );
+            ciphers.push_back( cipher_ );
+            sections.push_back( section_ );
+        }
+        block::RunTasks( pool, split, count, [ & ]( size_t t, size_t first, size_t n ) {
+            ProcessRange( ciphers[ t ],
+                          sections[ t ],
+                          index + first,
+                          in + first * BLOCK_SIZE,
+                          out + first * BLOCK_SIZE,
+                          n );
+        } );
+    }
+
+    Cipher cipher_;
+    size_t sectionBlocks_;
+    // Section whose key cipher_ holds, it is advanced when a later block is processed.
+    uint64_t section_;
+    uint64_t position_;
+    uint8_t initialCounter_[ BLOCK_SIZE ];
+    // Gamma of the block containing position_, when it is not at a block boundary.
+    uint8_t gamma_[ BLOCK_SIZE ];
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Kuznyechik block cipher, GOST R 34.12-2015, with 128-bit block and 256-bit key.
+ *
+ * Blocks and keys are byte strings in the order of the standard test vectors, i.e. the most
+ * significant byte first.
+ *
+ * A round S-box substitution followed by linear transformation L is computed with lookup
+ * tables: L is linear over GF(2), so L( S( x ) ) is XOR of 16 table entries, one per byte
+ * of x. Decryption uses tables of L^-1( S^-1( x ) ) the same way, with round keys
+ * transformed by L^-1. Tables take 128 KiB, are built once per process and shared by all
+ * objects. EncryptBlocks and DecryptBlocks use byte-sliced vector kernels when the CPU has
+ * AVX2 and GFNI.
+ *
+ * An object holds the expanded key, and may be reused for another key with SetKey.
+ */
+class Kuznyechik final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 16;
+    static constexpr size_t KEY_SIZE = 32;
+    static constexpr size_t ROUND_KEY_COUNT = 10;
+
+    /**
+     * @brief 128-bit block as two words in memory order of the block bytes.
+     */
+    struct alignas( 16 ) Block
+    {
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    /**
+     * @brief Create context and expand key.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     *
+     * @throw std::runtime_error If lookup tables cannot be allocated.
+     */
+    explicit Kuznyechik( const uint8_t* key );
+
+    ~Kuznyechik() noexcept;
+
+    /**
+     * @brief Expand another key.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     */
+    void SetKey( const uint8_t* key ) noexcept;
+
+    /**
+     * @brief Encrypt single block, \p in and \p out may be the same.
+     */
+    void EncryptBlock( const uint8_t* in, uint8_t* out ) const noexcept;
+
+    /**
+     * @brief Decrypt single block, \p in and \p out may be the same.
+     */
+    void DecryptBlock( const uint8_t* in, uint8_t* out ) const noexcept;
+
+    /**
+     * @brief Encrypt \p count consecutive blocks.
+     */
+    void EncryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept;
+
+    /**
+     * @brief Decrypt \p count consecutive blocks.
+     */
+    void DecryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept;
+
+    /**
+     * @brief Encrypt \p count consecutive blocks, block i with the key of \p ciphers[ i ].
+     *
+     * Blocks under different keys share the vector kernels, each lane adding its own round
+     * keys.
+     */
+    static void EncryptBlocksMultiKey( const Kuznyechik* const* ciphers,
+                                       const uint8_t* in,
+                                       uint8_t* out,
+                                       size_t count ) noexcept;
+
+private:
+    Block encryptKeys_[ ROUND_KEY_COUNT ];
+    Block decryptKeys_[ ROUND_KEY_COUNT ];
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Magma block cipher, GOST R 34.12-2015 (GOST 28147-89 with the id-tc26-gost-28147-param-Z
+ * S-box), with 64-bit block and 256-bit key.
+ *
+ * Blocks and keys are byte strings in the order of the standard test vectors, i.e. the most
+ * significant byte first.
+ *
+ * Round function g[ k ]( a ) = ( S( a + k ) ) <<< 11 is computed with four lookup tables of
+ * 256 words: adjacent 4-bit S-boxes are merged into one 8-bit substitution, and the
+ * rotation is applied to the table entries, so g is XOR of four lookups. Decryption is
+ * encryption with round keys in reverse order.
+ *
+ * An object holds the expanded key, and may be reused for another key with SetKey.
+ */
+class Magma final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 8;
+    static constexpr size_t KEY_SIZE = 32;
+    static constexpr size_t ROUND_COUNT = 32;
+
+    /**
+     * @brief Create context and expand key.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     */
+    explicit Magma( const uint8_t* key ) noexcept;
+
+    ~Magma() noexcept;
+
+    /**
+     * @brief Expand another key.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     */
+    void SetKey( const uint8_t* key ) noexcept;
+
+    /**
+     * @brief Encrypt single block, \p in and \p out may be the same.
+     */
+    void EncryptBlock( const uint8_t* in, uint8_t* out ) const noexcept;
+
+    /**
+     * @brief Decrypt single block, \p in and \p out may be the same.
+     */
+    void DecryptBlock( const uint8_t* in, uint8_t* out ) const noexcept;
+
+    /**
+     * @brief Encrypt \p count consecutive blocks.
+     */
+    void EncryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept;
+
+    /**
+     * @brief Decrypt \p count consecutive blocks.
+     */
+    void DecryptBlocks( const uint8_t* in, uint8_t* out, size_t count ) const noexcept;
+
+    /**
+     * @brief Encrypt \p count consecutive blocks, block i with the key of \p ciphers[ i ].
+     *
+     * Runs of blocks under the same key are encrypted together.
+     */
+    static void EncryptBlocksMultiKey( const Magma* const* ciphers,
+                                       const uint8_t* in,
+                                       uint8_t* out,
+                                       size_t count ) noexcept;
+
+private:
+    uint32_t encryptKeys_[ ROUND_COUNT ];
+    uint32_t decryptKeys_[ ROUND_COUNT ];
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,485 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <core/cipher/block_util.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/segment.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+namespace mgm
+{
+
+/**
+ * @brief sum ^= h_0 * x_0 ^ ... ^ h_count-1 * x_count-1 in GF(2^128) of MGM, where \p sum,
+ * \p h and \p x are big-endian 16-byte blocks.
+ *
+ * Products are summed unreduced and reduced once. Uses PCLMULQDQ when available, and
+ * multiples of h by 4-bit polynomials otherwise.
+ */
+void MultiplySum128( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept;
+
+/**
+ * @brief The same as MultiplySum128 in GF(2^64) with 8-byte blocks.
+ */
+void MultiplySum64( uint8_t* sum, const uint8_t* h, const uint8_t* x, size_t count ) noexcept;
+
+} // namespace mgm
+
+/**
+ * @brief Multilinear Galois Mode, R 1323565.1.026-2019 (RFC 9058), authenticated encryption
+ * with Kuznyechik or Magma.
+ *
+ * Payload block i is encrypted with gamma E_K( Y_i ), and the tag is E_K of the sum of
+ * products H_j * A_j, H_j * C_j and H * ( len( A ) | len( C ) ) in GF(2^n), where
+ * H_j = E_K( Z_j ). Counters Y and Z start from E_K of the nonce with the most significant
+ * bit cleared and set, and are incremented in the right and the left half respectively.
+ *
+ * A message is Start, any number of UpdateAad calls, any number of Encrypt or Decrypt calls,
+ * and Final or Verify. Data of any size may be passed in every call. Runs of whole blocks are
+ * processed in chunks: counters Y and Z of a chunk are encrypted with one EncryptBlocks call,
+ * and products of the chunk are summed with a single reduction.
+ *
+ * Decrypt releases plaintext before the tag is checked, it must be discarded if Verify fails.
+ */
+template < typename Cipher >
+class Mgm final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = Cipher::BLOCK_SIZE;
+    static constexpr size_t KEY_SIZE = Cipher::KEY_SIZE;
+    static constexpr size_t NONCE_SIZE = BLOCK_SIZE;
+    static constexpr size_t TAG_SIZE = BLOCK_SIZE;
+    // Bit length of A plus C is limited to n / 2 bits.
+    static constexpr uint64_t MAX_SIZE = ( ~uint64_t( 0 ) >> ( 64 - 4 * BLOCK_SIZE ) ) / 8;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     *
+     * @throw std::runtime_error If the cipher cannot be created.
+     */
+    explicit Mgm( const uint8_t* key )
+        : cipher_( key )
+        , y_()
+        , z_()
+        , sum_()
+        , buffer_()
+        , gamma_()
+        , bufferSize_( 0 )
+        , aadSize_( 0 )
+        , dataSize_( 0 )
+    {
+    }
+
+    Mgm( const Mgm& ) = delete;
+    Mgm& operator=( const Mgm& ) = delete;
+
+    ~Mgm() noexcept
+    {
+        Wipe();
+    }
+
+    /**
+     * @brief Use another key from the next Start.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     */
+    void SetKey( const uint8_t* key ) noexcept
+    {
+        cipher_.SetKey( key );
+    }
+
+    /**
+     * @brief Start new message.
+     *
+     * @param[in] nonce NONCE_SIZE bytes, the most significant bit is ignored.
+     */
+    void Start( const uint8_t* nonce ) noexcept
+    {
+        Wipe();
+        std::memcpy( y_, nonce, NONCE_SIZE );
+        y_[ 0 ] &= 0x7f;
+        std::memcpy( z_, nonce, NONCE_SIZE );
+        z_[ 0 ] |= 0x80;
+        cipher_.EncryptBlock( y_, y_ );
+        cipher_.EncryptBlock( z_, z_ );
+        bufferSize_ = 0;
+        aadSize_ = 0;
+        dataSize_ = 0;
+    }
+
+    /**
+     * @brief Authenticate next \p size bytes of associated data.
+     *
+     * @throw std::runtime_error If payload was already passed, or the message is too long.
+     */
+    void UpdateAad( const uint8_t* data, size_t size )
+    {
+        [[unlikely]] if( dataSize_ != 0 )
+        {
+            throw std::runtime_error( "Associated data after payload" );
+        }
+        CheckSize( size );
+        aadSize_ += size;
+        if( bufferSize_ != 0 )
+        {
+            size_t n = size < BLOCK_SIZE - bufferSize_ ? size : BLOCK_SIZE - bufferSize_;
+            std::memcpy( buffer_ + bufferSize_, data, n );
+            data += n;
+            size -= n;
+            bufferSize_ += n;
+            if( bufferSize_ < BLOCK_SIZE )
+            {
+                return;
+            }
+            HashBlocks( buffer_, 1 );
+            bufferSize_ = 0;
+        }
+        HashBlocks( data, size / BLOCK_SIZE );
+        data += size / BLOCK_SIZE * BLOCK_SIZE;
+        bufferSize_ = size % BLOCK_SIZE;
+        std::memcpy( buffer_, data, bufferSize_ );
+    }
+
+    /**
+     * @brief Encrypt next \p size bytes of payload, \p in and \p out may be the same.
+     *
+     * @throw std::runtime_error If the message is too long.
+     */
+    void Encrypt( const uint8_t* in, uint8_t* out, size_t size )
+    {
+        Process< true >( in, out, size );
+    }
+
+    /**
+     * @brief Decrypt next \p size bytes of payload, \p in and \p out may be the same.
+     *
+     * @throw std::runtime_error If the message is too long.
+     */
+    void Decrypt( const uint8_t* in, uint8_t* out, size_t size )
+    {
+        Process< false >( in, out, size );
+    }
+
+    /**
+     * @brief Authenticate \p count segments of associated data.
+     *
+     * @throw std::runtime_error If payload was already passed, or the message is too long.
+     */
+    void UpdateAad( const util::ConstSegment* segments, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            UpdateAad( segments[ i ].data, segments[ i ].size );
+        }
+    }
+
+    /**
+     * @brief Encrypt \p count segments of payload in place.
+     *
+     * A block split between segments uses the gamma and ciphertext kept between calls, so no
+     * data is copied.
+     *
+     * @throw std::runtime_error If the message is too long.
+     */
+    void Encrypt( const util::Segment* segments, size_t count )
+    {
+        CheckSize( util::TotalSize( segments, count ) );
+        for( size_t i = 0; i < count; ++i )
+        {
+            Process< true >( segments[ i ].data, segments[ i ].data, segments[ i ].size );
+        }
+    }
+
+    /**
+     * @brief Decrypt \p count segments of payload in place.
+     *
+     * @throw std::runtime_error If the message is too long.
+     */
+    void Decrypt( const util::Segment* segments, size_t count )
+    {
+        CheckSize( util::TotalSize( segments, count ) );
+        for( size_t i = 0; i < count; ++i )
+        {
+            Process< false >( segments[ i ].data, segments[ i ].data, segments[ i ].size );
+        }
+    }
+
+    /**
+     * @brief Finish message.
+     *
+     * @param[out] tag \p tagSize most significant bytes of the tag.
+     * @param[in] tagSize From 1 to TAG_SIZE.
+     *
+     * @throw std::runtime_error If tag size is not supported.
+     */
+    void Final( uint8_t* tag, size_t tagSize = TAG_SIZE )
+    {
+        [[unlikely]] if( tagSize == 0 || tagSize > TAG_SIZE )
+        {
+            throw std::runtime_error( "Unsupported tag size" );
+        }
+        if( bufferSize_ != 0 )
+        {
+            std::memset( buffer_ + bufferSize_, 0, BLOCK_SIZE - bufferSize_ );
+            HashBlocks( buffer_, 1 );
+            bufferSize_ = 0;
+        }
+        uint8_t lengths[ BLOCK_SIZE ];
+        StoreHalf( lengths, aadSize_ * 8 );
+        StoreHalf( lengths + HALF_SIZE, dataSize_ * 8 );
+        HashBlocks( lengths, 1 );
+
+        uint8_t full[ TAG_SIZE ];
+        cipher_.EncryptBlock( sum_, full );
+        std::memcpy( tag, full, tagSize );
+        util::SecureZero( full, sizeof( full ) );
+        Wipe();
+    }
+
+    /**
+     * @brief Finish message and compare the tag in constant time.
+     *
+     * @throw std::runtime_error If tag size is not supported.
+     */
+    bool Verify( const uint8_t* tag, size_t tagSize = TAG_SIZE )
+    {
+        uint8_t expected[ TAG_SIZE ];
+        Final( expected, tagSize );
+        uint8_t diff = 0;
+        for( size_t i = 0; i < tagSize; ++i )
+        {
+            diff |= expected[ i ] ^ tag[ i ];
+        }
+        util::SecureZero( expected, sizeof( expected ) );
+        return diff == 0;
+    }
+
+private:
+    static constexpr size_t HALF_SIZE = BLOCK_SIZE / 2;
+    // Blocks of a chunk, the Y and Z counters of a chunk take twice as much.
+    static constexpr size_t CHUNK_BLOCKS = 1024 / BLOCK_SIZE;
+
+    static inline uint64_t LoadHalf( const uint8_t* data ) noexcept
+    {
+        if constexpr( HALF_SIZE == 8 )
+        {
+            return block::LoadBigEndian64( data );
+        }
+        else
+        {
+            return block::LoadBigEndian32( data );
+        }
+    }
+
+    // Modulo 2^( n / 2 ).
+    static inline void StoreHalf( uint8_t* data, uint64_t value ) noexcept
+    {
+        if constexpr( HALF_SIZE == 8 )
+        {
+            block::StoreBigEndian64( data, value );
+        }
+        else
+        {
+            block::StoreBigEndian32( data, static_cast< uint32_t >( value ) );
+        }
+    }
+
+    static inline void MultiplySum( uint8_t* sum,
+                                    const uint8_t* h,
+                                    const uint8_t* x,
+                                    size_t count ) noexcept
+    {
+        if constexpr( BLOCK_SIZE == 16 )
+        {
+            mgm::MultiplySum128( sum, h, x, count );
+        }
+        else
+        {
+            mgm::MultiplySum64( sum, h, x, count );
+        }
+    }
+
+    // Next \p count values of Y, incremented in the right half.
+    inline void NextY( uint8_t* counters, size_t count ) noexcept
+    {
+        uint64_t right = LoadHalf( y_ + HALF_SIZE );
+        for( size_t i = 0; i < count; ++i, counters += BLOCK_SIZE )
+        {
+            std::memcpy( counters, y_, HALF_SIZE );
+            StoreHalf( counters + HALF_SIZE, right + i );
+        }
+        StoreHalf( y_ + HALF_SIZE, right + count );
+    }
+
+    // Next \p count values of Z, incremented in the left half.
+    inline void NextZ( uint8_t* counters, size_t count ) noexcept
+    {
+        uint64_t left = LoadHalf( z_ );
+        for( size_t i = 0; i < count; ++i, counters += BLOCK_SIZE )
+        {
+            StoreHalf( counters, left + i );
+            std::memcpy( counters + HALF_SIZE, z_ + HALF_SIZE, HALF_SIZE );
+        }
+        StoreHalf( z_, left + count );
+    }
+
+    inline void CheckSize( size_t size ) const
+    {
+        [[unlikely]] if( size > MAX_SIZE - aadSize_ - dataSize_ )
+        {
+            throw std::runtime_error( "Message too long" );
+        }
+    }
+
+    // Add \p count blocks of A or C to the sum.
+    void HashBlocks( const uint8_t* blocks, size_t count ) noexcept
+    {
+        uint8_t h[ CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            size_t n = count < CHUNK_BLOCKS ? count : CHUNK_BLOCKS;
+            NextZ( h, n );
+            cipher_.EncryptBlocks( h, h, n );
+            MultiplySum( sum_, h, blocks, n );
+            blocks += n * BLOCK_SIZE;
+            count -= n;
+        }
+        util::SecureZero( h, sizeof( h ) );
+    }
+
+    // Whole blocks, gamma and H of a chunk are encrypted together.
+    template < bool encrypt >
+    void ProcessBlocks( const uint8_t* in, uint8_t* out, size_t count ) noexcept
+    {
+        uint8_t work[ 2 * CHUNK_BLOCKS * BLOCK_SIZE ];
+        while( count != 0 )
+        {
+            size_t n = count < CHUNK_BLOCKS ? count : CHUNK_BLOCKS;
+            uint8_t* gamma = work;
+            uint8_t* h = work + n * BLOCK_SIZE;
+            NextY( gamma, n );
+            NextZ( h, n );
+            cipher_.EncryptBlocks( work, work, 2 * n );
+            if constexpr( encrypt )
+            {
+                block::Xor( in, gamma, out, n * BLOCK_SIZE );
+                MultiplySum( sum_, h, out, n );
+            }
+            else
+            {
+                MultiplySum( sum_, h, in, n );
+                block::Xor( in, gamma, out, n * BLOCK_SIZE );
+            }
+            in += n * BLOCK_SIZE;
+            out += n * BLOCK_SIZE;
+            count -= n;
+        }
+        util::SecureZero( work, sizeof( work ) );
+    }
+
+    // A partial block of payload keeps its gamma and the ciphertext collected so far.
+    template < bool encrypt >
+    void Process( const uint8_t* in, uint8_t* out, size_t size )
+    {
+        if( size == 0 )
+        {
+            return;
+        }
+        CheckSize( size );
+        if( dataSize_ == 0 && bufferSize_ != 0 )
+        {
+            std::memset( buffer_ + bufferSize_, 0, BLOCK_SIZE - bufferSize_ );
+            HashBlocks( buffer_, 1 );
+            bufferSize_ = 0;
+        }
+        dataSize_ += size;
+
+        if( bufferSize_ != 0 )
+        {
+            size_t n = size < BLOCK_SIZE - bufferSize_ ? size : BLOCK_SIZE - bufferSize_;
+            if constexpr( encrypt )
+            {
+                block::Xor( in, gamma_ + bufferSize_, out, n );
+                std::memcpy( buffer_ + bufferSize_, out, n );
+            }
+            else
+            {
+                std::memcpy( buffer_ + bufferSize_, in, n );
+                block::Xor( in, gamma_ + bufferSize_, out, n );
+            }
+            in += n;
+            out += n;
+            size -= n;
+            bufferSize_ += n;
+            if( bufferSize_ < BLOCK_SIZE )
+            {
+                return;
+            }
+            HashBlocks( buffer_, 1 );
+            bufferSize_ = 0;
+        }
+
+        size_t blocks = size / BLOCK_SIZE;
+        ProcessBlocks< encrypt >( in, out, blocks );
+        in += blocks * BLOCK_SIZE;
+        out += blocks * BLOCK_SIZE;
+        size -= blocks * BLOCK_SIZE;
+
+        if( size != 0 )
+        {
+            NextY( gamma_, 1 );
+            cipher_.EncryptBlock( gamma_, gamma_ );
+            if constexpr( encrypt )
+            {
+                block::Xor( in, gamma_, out, size );
+                std::memcpy( buffer_, out, size );
+            }
+            else
+            {
+                std::memcpy( buffer_, in, size );
+                block::Xor( in, gamma_, out, size );
+            }
+            bufferSize_ = size;
+        }
+    }
+
+    void Wipe() noexcept
+    {
+        util::SecureZero( y_, sizeof( y_ ) );
+        util::SecureZero( z_, sizeof( z_ ) );
+        util::SecureZero( sum_, sizeof( sum_ ) );
+        util::SecureZero( buffer_, sizeof( buffer_ ) );
+        util::SecureZero( gamma_, sizeof( gamma_ ) );
+    }
+
+    Cipher cipher_;
+    uint8_t y_[ BLOCK_SIZE ];
+    uint8_t z_[ BLOCK_SIZE ];
+    uint8_t sum_[ BLOCK_SIZE ];
+    // Partial block of associated data or ciphertext.
+    uint8_t buffer_[ BLOCK_SIZE ];
+    // Gamma of the partial block of payload.
+    uint8_t gamma_[ BLOCK_SIZE ];
+    size_t bufferSize_;
+    uint64_t aadSize_;
+    uint64_t dataSize_;
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
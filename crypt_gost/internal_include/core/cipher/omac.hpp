@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <core/cipher/block_util.hpp>
+#include <core/util/secure_zero.hpp>
+#include <core/util/segment.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cipher
+{
+
+/**
+ * @brief Message authentication code OMAC (CMAC), GOST R 34.13-2015, with Kuznyechik or
+ * Magma.
+ *
+ * Blocks are chained as C_i = E_K( C_i-1 ^ P_i ). The last block is added with key K1 if it is
+ * whole, and with K2 after padding by 10..0 otherwise, where K1 and K2 are E_K( 0 ) doubled
+ * once and twice in GF(2^n).
+ *
+ * The chain of one message is serial. MacMany authenticates independent messages together:
+ * every EncryptBlocks call takes the next block of each message that has not reached its last
+ * block, so short messages are authenticated at the throughput of the vector kernels.
+ */
+template < typename Cipher >
+class Omac final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = Cipher::BLOCK_SIZE;
+    static constexpr size_t KEY_SIZE = Cipher::KEY_SIZE;
+    static constexpr size_t TAG_SIZE = BLOCK_SIZE;
+
+    /**
+     * @brief Message for MacMany.
+     */
+    struct Message
+    {
+        const uint8_t* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     *
+     * @throw std::runtime_error If the cipher cannot be created.
+     */
+    explicit Omac( const uint8_t* key )
+        : cipher_( key )
+        , k1_()
+        , k2_()
+        , state_()
+        , buffer_()
+        , bufferSize_( 0 )
+    {
+        DeriveKeys();
+    }
+
+    Omac( const Omac& ) = delete;
+    Omac& operator=( const Omac& ) = delete;
+
+    ~Omac() noexcept
+    {
+        Init();
+        util::SecureZero( k1_, sizeof( k1_ ) );
+        util::SecureZero( k2_, sizeof( k2_ ) );
+    }
+
+    /**
+     * @brief Use another key, and start new message.
+     *
+     * @param[in] key KEY_SIZE bytes.
+     */
+    void SetKey( const uint8_t* key ) noexcept
+    {
+        cipher_.SetKey( key );
+        DeriveKeys();
+        Init();
+    }
+
+    /**
+     * @brief Start new message.
+     */
+    void Init() noexcept
+    {
+        util::SecureZero( state_, sizeof( state_ ) );
+        util::SecureZero( buffer_, sizeof( buffer_ ) );
+        bufferSize_ = 0;
+    }
+
+    /**
+     * @brief Authenticate next \p size bytes of the message.
+     *
+     * The last block is kept until the next call or Final, since it is added differently.
+     */
+    void Update( const uint8_t* data, size_t size ) noexcept
+    {
+        size_t n = size < BLOCK_SIZE - bufferSize_ ? size : BLOCK_SIZE - bufferSize_;
+        std::memcpy( buffer_ + bufferSize_, data, n );
+        bufferSize_ += n;
+        data += n;
+        size -= n;
+        if( size == 0 )
+        {
+            return;
+        }
+        // The buffer is full and more data follows.
+        Absorb( buffer_ );
+        for( ; size > BLOCK_SIZE; size -= BLOCK_SIZE, data += BLOCK_SIZE )
+        {
+            Absorb( data );
+        }
+        std::memcpy( buffer_, data, size );
+        bufferSize_ = size;
+    }
+
+    /**
+     * @brief Authenticate \p count segments of the message.
+     */
+    void Update( const util::ConstSegment* segments, size_t count ) noexcept
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            Update( segments[ i ].data, segments[ i ].size );
+        }
+    }
+
+    /**
+     * @brief Finish message and start the next one.
+     *
+     * @param[out] tag \p tagSize most significant bytes of the MAC.
+     * @param[in] tagSize From 1 to TAG_SIZE.
+     *
+     * @throw std::runtime_error If tag size is not supported.
+     */
+    void Final( uint8_t* tag, size_t tagSize = TAG_SIZE )
+    {
+        CheckTagSize( tagSize );
+        uint8_t last[ BLOCK_SIZE ];
+        LastBlock( buffer_, bufferSize_, last );
+        block::Xor( last, state_, last, BLOCK_SIZE );
+        cipher_.EncryptBlock( last, last );
+        std::memcpy( tag, last, tagSize );
+        util::SecureZero( last, sizeof( last ) );
+        Init();
+    }
+
+    /**
+     * @brief Finish message, start the next one and compare the MAC in constant time.
+     *
+     * @throw std::runtime_error If tag size is not supported.
+     */
+    bool Verify( const uint8_t* tag, size_t tagSize = TAG_SIZE )
+    {
+        uint8_t expected[ TAG_SIZE ];
+        Final( expected, tagSize );
+        uint8_t diff = 0;
+        for( size_t i = 0; i < tagSize; ++i )
+        {
+            diff |= expected[ i ] ^ tag[ i ];
+        }
+        util::SecureZero( expected, sizeof( expected ) );
+        return diff == 0;
+    }
+
+    /**
+     * @brief Authenticate independent messages, the current message is not affected.
+     *
+     * @param[in] messages Messages.
+     * @param[in] count Number of messages.
+     * @param[out] tags \p count MACs of \p tagSize bytes, in the order of messages.
+     * @param[in] tagSize From 1 to TAG_SIZE.
+     *
+     * @throw std::runtime_error If tag size is not supported.
+     */
+    void MacMany( const Message* messages,
+                  size_t count,
+                  uint8_t* tags,
+                  size_t tagSize = TAG_SIZE ) const
+    {
+        CheckTagSize( tagSize );
+        uint8_t state[ GROUP_SIZE * BLOCK_SIZE ];
+        uint8_t work[ GROUP_SIZE * BLOCK_SIZE ];
+        size_t lanes[ GROUP_SIZE ];
+        for( size_t first = 0; first < count; first += GROUP_SIZE )
+        {
+            const Message* group = messages + first;
+            size_t n = count - first < GROUP_SIZE ? count - first : GROUP_SIZE;
+            std::memset( state, 0, n * BLOCK_SIZE );
+            // Messages which have not reached their last block are gathered for each step.
+            for( size_t index = 0;; ++index )
+            {
+                size_t active = 0;
+                for( size_t j = 0; j < n; ++j )
+                {
+                    if( index < LeadingBlocks( group[ j ].size ) )
+                    {
+                        block::Xor( state + j * BLOCK_SIZE,
+                                    group[ j ].data + index * BLOCK_SIZE,
+                                    work + active * BLOCK_SIZE,
+                                    BLOCK_SIZE );
+                        lanes[ active++ ] = j;
+                    }
+                }
+                if( active == 0 )
+                {
+                    break;
+                }
+                cipher_.EncryptBlocks( work, work, active );
+                for( size_t a = 0; a < active; ++a )
+                {
+                    uint8_t* lane = state + lanes[ a ] * BLOCK_SIZE;
+                    std::memcpy( lane, work + a * BLOCK_SIZE, BLOCK_SIZE );
+                }
+            }
+            for( size_t j = 0; j < n; ++j )
+            {
+                size_t offset = LeadingBlocks( group[ j ].size ) * BLOCK_SIZE;
+                uint8_t* last = work + j * BLOCK_SIZE;
+                LastBlock( group[ j ].data + offset, group[ j ].size - offset, last );
+                block::Xor( last, state + j * BLOCK_SIZE, last, BLOCK_SIZE );
+            }
+            cipher_.EncryptBlocks( work, work, n );
+            for( size_t j = 0; j < n; ++j )
+            {
+                std::memcpy( tags + ( first + j ) * tagSize, work + j * BLOCK_SIZE, tagSize );
+            }
+        }
+        util::SecureZero( state, sizeof( state ) );
+        util::SecureZero( work, sizeof( work ) );
+    }
+
+private:
+    // Messages of MacMany processed together, enough to fill the widest cipher kernel.
+    static constexpr size_t GROUP_SIZE = 64;
+
+    static inline void CheckTagSize( size_t tagSize )
+    {
+        [[unlikely]] if( tagSize == 0 || tagSize > TAG_SIZE )
+        {
+            throw std::runtime_error( "Unsupported tag size" );
+        }
+    }
+
+    // Blocks before the last one, which is whole or partial but exists for any size.
+    static inline size_t LeadingBlocks( size_t size ) noexcept
+    {
+        return size == 0 ? 0 : ( size - 1 ) / BLOCK_SIZE;
+    }
+
+    // x * 2 modulo x^128 + x^7 + x^2 + x + 1 or x^64 + x^4 + x^3 + x + 1.
+    static inline void Double( const uint8_t* in, uint8_t* out ) noexcept
+    {
+        constexpr uint8_t REDUCTION = BLOCK_SIZE == 16 ? 0x87 : 0x1b;
+        uint8_t carry = static_cast< uint8_t >( 0 - ( in[ 0 ] >> 7 ) );
+        for( size_t i = 0; i + 1 < BLOCK_SIZE; ++i )
+        {
+            out[ i ] = static_cast< uint8_t >( in[ i ] << 1 | in[ i + 1 ] >> 7 );
+        }
+        out[ BLOCK_SIZE - 1 ] =
+            static_cast< uint8_t >( in[ BLOCK_SIZE - 1 ] << 1 ^ ( carry & REDUCTION ) );
+    }
+
+    void DeriveKeys() noexcept
+    {
+        uint8_t r[ BLOCK_SIZE ] = {};
+        cipher_.EncryptBlock( r, r );
+        Double( r, k1_ );
+        Double( k1_, k2_ );
+        util::SecureZero( r, sizeof( r ) );
+    }
+
+    // The last \p size bytes of a message, padded if partial, plus K1 or K2.
+    inline void LastBlock( const uint8_t* data, size_t size, uint8_t* out ) const noexcept
+    {
+        if( size == BLOCK_SIZE )
+        {
+            block::Xor( data, k1_, out, BLOCK_SIZE );
+            return;
+        }
+        std::memcpy( out, data, size );
+        out[ size ] = 0x80;
+        std::memset( out + size + 1, 0, BLOCK_SIZE - size - 1 );
+        block::Xor( out, k2_, out, BLOCK_SIZE );
+    }
+
+    inline void Absorb( const uint8_t* data ) noexcept
+    {
+        block::Xor( state_, data, state_, BLOCK_SIZE );
+        cipher_.EncryptBlock( state_, state_ );
+    }
+
+    Cipher cipher_;
+    uint8_t k1_[ BLOCK_SIZE ];
+    uint8_t k2_[ BLOCK_SIZE ];
+    uint8_t state_[ BLOCK_SIZE ];
+    // Last block of the message so far, whole or partial.
+    uint8_t buffer_[ BLOCK_SIZE ];
+    size_t bufferSize_;
+};
+
+} // namespace cipher
+
+} // namespace core
+
+} // namespace crypt_gost
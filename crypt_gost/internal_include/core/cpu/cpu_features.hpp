@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cpu
+{
+
+/**
+ * @brief Instruction set extensions, which kernels may require.
+ *
+ */
+enum Feature : uint32_t
+{
+    FEATURE_SSSE3 = 1u << 0,
+    FEATURE_SSE41 = 1u << 1,
+    FEATURE_PCLMUL = 1u << 2,
+    FEATURE_AVX2 = 1u << 3,
+    FEATURE_BMI2 = 1u << 4,
+    FEATURE_ADX = 1u << 5,
+    FEATURE_AVX512F = 1u << 6,
+    FEATURE_AVX512BW = 1u << 7,
+    FEATURE_AVX512VL = 1u << 8,
+    FEATURE_AVX512IFMA = 1u << 9,
+    FEATURE_AVX512VBMI = 1u << 10,
+    FEATURE_GFNI = 1u << 11,
+    FEATURE_VPCLMULQDQ = 1u << 12,
+};
+
+/**
+ * @brief Get features supported by both the processor and the operating system.
+ *
+ * CPUID is queried once, the result is cached.
+ *
+ * @return uint32_t Bitwise OR of Feature values.
+ */
+uint32_t DetectFeatures() noexcept;
+
+/**
+ * @brief Get features, which kernels are allowed to use.
+ *
+ * @return uint32_t Detected features restricted by the feature mask.
+ */
+uint32_t GetFeatures() noexcept;
+
+/**
+ * @brief Restrict features, which kernels are allowed to use.
+ *
+ * Intended for testing and benchmarking of fallback kernels. Kernels are reselected
+ * on next use.
+ *
+ * @param[in] mask Allowed features, ~0u to allow all detected ones.
+ */
+void SetFeatureMask( uint32_t mask ) noexcept;
+
+/**
+ * @brief Get counter, which is changed every time the feature mask is changed.
+ *
+ * @return uint32_t Generation of kernel selection.
+ */
+uint32_t GetGeneration() noexcept;
+
+inline bool HasFeatures( uint32_t features ) noexcept
+{
+    return ( GetFeatures() & features ) == features;
+}
+
+} // namespace cpu
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <core/cpu/cpu_features.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace cpu
+{
+
+/**
+ * @brief Runtime selection of a kernel implementation.
+ *
+ * Implementations are registered together with the features they require, the most
+ * recently registered implementation whose features are available is selected. The
+ * portable fallback given on construction is used when nothing else fits.
+ *
+ * Registration is expected to happen while the dispatcher is being constructed as
+ * a function-local static, selection is lock-free and thread-safe.
+ *
+ * @tparam Fn Kernel function pointer type.
+ */
+template < typename Fn >
+class Dispatcher final
+{
+public:
+    static constexpr size_t MAX_CANDIDATES = 8;
+
+    explicit Dispatcher( Fn fallback ) noexcept
+        : candidates_()
+        , count_( 0 )
+        , selected_( fallback )
+        , generation_( GENERATION_NONE )
+    {
+        Register( fallback, 0 );
+    }
+
+    Dispatcher( const Dispatcher& ) = delete;
+    Dispatcher& operator=( const Dispatcher& ) = delete;
+
+    /**
+     * @brief Register implementation.
+     *
+     * @param[in] fn Implementation.
+     * @param[in] features Features required by the implementation.
+     *
+     * @return Dispatcher& *this to chain registrations.
+     */
+    Dispatcher& Register( Fn fn, uint32_t features ) noexcept
+    {
+        if( count_ < MAX_CANDIDATES )
+        {
+            candidates_[ count_++ ] = Candidate{ fn, features };
+            generation_.store( GENERATION_NONE, std::memory_order_release );
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Get best implementation for features currently allowed.
+     *
+     * @return Fn Implementation.
+     */
+    inline Fn Get() noexcept
+    {
+        uint32_t generation = GetGeneration();
+        [[unlikely]] if( generation_.load( std::memory_order_acquire ) != generation )
+        {
+            selected_.store( Select(), std::memory_order_relaxed );
+            generation_.store( generation, std::memory_order_release );
+        }
+        return selected_.load( std::memory_order_relaxed );
+    }
+
+private:
+    static constexpr uint32_t GENERATION_NONE = ~0u;
+
+    struct Candidate
+    {
+        Fn fn;
+        uint32_t features;
+    };
+
+    Fn Select() const noexcept
+    {
+        for( size_t i = count_; i > 0; --i )
+        {
+            if( HasFeatures( candidates_[ i - 1 ].features ) )
+            {
+                return candidates_[ i - 1 ].fn;
+            }
+        }
+        return candidates_[ 0 ].fn;
+    }
+
+    std::array< Candidate, MAX_CANDIDATES > candidates_;
+    size_t count_;
+    std::atomic< Fn > selected_;
+    std::atomic< uint32_t > generation_;
+};
+
+} // namespace cpu
+
+} // namespace core
+
+} // namespace crypt_gost
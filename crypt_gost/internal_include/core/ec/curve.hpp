@@ -0,0 +1,948 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <core/ec/params.hpp>
+#include <core/math/sqrt.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+#ifdef CRYPT_GOST_EC_COUNTERS
+/**
+ * @brief Numbers of group operations by code path, counted per thread.
+ *
+ * Compiled in only with CRYPT_GOST_EC_COUNTERS defined, for tests that check a computation
+ * takes the same path for any scalar.
+ */
+struct OperationCounters
+{
+    size_t doublings = 0;
+    size_t additions = 0;  // full addition formulas
+    size_t shortcuts = 0;  // additions of the neutral, equal or opposite points
+    size_t tableScans = 0; // rows scanned by FixedBaseTable
+};
+
+inline thread_local OperationCounters operationCounters;
+
+#    define CRYPT_GOST_EC_COUNT( counter ) ( ++::crypt_gost::core::ec::operationCounters.counter )
+#else
+#    define CRYPT_GOST_EC_COUNT( counter ) static_cast< void >( 0 )
+#endif
+
+/**
+ * @brief Elliptic curve y^2 = x^3 + ax + b over prime field, see CurveParams.
+ *
+ * Field elements are kept in Montgomery form of the field context. Group operations work
+ * on projective points and need no inversion, a projective point is converted to affine
+ * once at the end of a computation.
+ *
+ * Curves with a twisted Edwards form eu^2 + v^2 = 1 + du^2v^2 are computed in that form
+ * with extended coordinates, which have unified formulas for addition and doubling. Other
+ * curves use Jacobian coordinates, with a cheaper doubling for a = -3. Conversion between
+ * forms happens only in FromAffine and ToAffine.
+ */
+template < size_t bitSize >
+class Curve final
+{
+public:
+    using Number = math::LongNumber< bitSize >;
+    using Field = math::MontgomeryContext< bitSize >;
+
+    enum Model
+    {
+        WEIERSTRASS,
+        WEIERSTRASS_A_MINUS_3,
+        TWISTED_EDWARDS
+    };
+
+    /**
+     * @brief Affine point of the curve model, coordinates in Montgomery form.
+     *
+     * For twisted Edwards model x and y are u and v.
+     */
+    struct Point
+    {
+        Number x;
+        Number y;
+        bool infinity = true;
+    };
+
+    /**
+     * @brief Projective point, coordinates in Montgomery form.
+     *
+     * Jacobian ( X : Y : Z ) stands for ( X / Z^2, Y / Z^3 ), and Z = 0 for infinity,
+     * t is unused. Extended ( X : Y : T : Z ) stands for ( X / Z, Y / Z ) with T = XY / Z.
+     */
+    struct Projective
+    {
+        Number x;
+        Number y;
+        Number z;
+        Number t;
+    };
+
+    /**
+     * @brief Create curve from parameter set.
+     *
+     * @throw std::runtime_error If parameter set is for another bit size, or base point is
+     * not on the curve.
+     */
+    explicit Curve( const CurveParams& params )
+        : field_( Parse( params.p, params ) )
+        , model_( WEIERSTRASS )
+        , a_( field_.ToMont( Parse( params.a, params ) ) )
+        , b_( field_.ToMont( Parse( params.b, params ) ) )
+        , e_()
+        , d_()
+        , s_()
+        , t_()
+        , sqrt_( field_.Modulus() )
+        , order_( Parse( params.q, params ) )
+        , cofactor_( params.cofactor )
+        , base_()
+    {
+        Number three = field_.Add( field_.Add( field_.One(), field_.One() ), field_.One() );
+        if( params.e != nullptr && params.d != nullptr )
+        {
+            // Weierstrass x = s( 1 + v ) / ( 1 - v ) + t, y = s( 1 + v ) / ( ( 1 - v )u ),
+            // where s = ( e - d ) / 4, t = ( e + d ) / 6.
+            model_ = TWISTED_EDWARDS;
+            e_ = field_.ToMont( Parse( params.e, params ) );
+            d_ = field_.ToMont( Parse( params.d, params ) );
+            Number two = field_.Add( field_.One(), field_.One() );
+            s_ = field_.Mul( field_.Sub( e_, d_ ), field_.Inverse( field_.Add( two, two ) ) );
+            t_ = field_.Mul( field_.Add( e_, d_ ),
+                             field_.Inverse( field_.Add( three, three ) ) );
+        }
+        else if( field_.Add( a_, three ).IsZero() )
+        {
+            model_ = WEIERSTRASS_A_MINUS_3;
+        }
+        base_ = FromAffine( Parse( params.x, params ), Parse( params.y, params ) );
+    }
+
+    inline const Field& GetField() const noexcept
+    {
+        return field_;
+    }
+
+    inline Model GetModel() const noexcept
+    {
+        return model_;
+    }
+
+    /**
+     * @brief Order q of the base point subgroup.
+     */
+    inline const Number& Order() const noexcept
+    {
+        return order_;
+    }
+
+    inline unsigned Cofactor() const noexcept
+    {
+        return cofactor_;
+    }
+
+    inline const Point& Base() const noexcept
+    {
+        return base_;
+    }
+
+    /**
+     * @brief Create point from ordinary Weierstrass coordinates.
+     *
+     * @throw std::runtime_error If coordinates are not reduced, point is not on the curve,
+     * or is one of the few points of low order without twisted Edwards counterpart.
+     */
+    Point FromAffine( const Number& x, const Number& y ) const
+    {
+        [[unlikely]] if( x >= field_.Modulus() || y >= field_.Modulus() )
+        {
+            throw std::runtime_error( "Point is not on the curve" );
+        }
+        Number montX = field_.ToMont( x );
+        Number montY = field_.ToMont( y );
+        Number left = field_.Sqr( montY );
+        Number right = field_.Add( field_.Sqr( montX ), a_ );
+        field_.Mul( right, montX, right );
+        field_.Add( right, b_, right );
+        [[unlikely]] if( left != right )
+        {
+            throw std::runtime_error( "Point is not on the curve" );
+        }
+        if( model_ != TWISTED_EDWARDS )
+        {
+            return Point{ montX, montY, false };
+        }
+
+        // u = ( x - t ) / y, v = ( x - t - s ) / ( x - t + s ).
+        Number shifted = field_.Sub( montX, t_ );
+        Number denominator = field_.Add( shifted, s_ );
+        [[unlikely]] if( denominator.IsZero() || ( montY.IsZero() && !shifted.IsZero() ) )
+        {
+            throw std::runtime_error( "Point has no twisted Edwards form" );
+        }
+        if( montY.IsZero() )
+        {
+            return Point{ Number( 0 ), field_.Sub( Number( 0 ), field_.One() ), false };
+        }
+        Point ret;
+        ret.infinity = false;
+        field_.Mul( shifted, field_.Inverse( montY ), ret.x );
+        field_.Mul( field_.Sub( shifted, s_ ), field_.Inverse( denominator ), ret.y );
+        return ret;
+    }
+
+    /**
+     * @brief Find point by ordinary Weierstrass x coordinate and parity of y.
+     *
+     * @param[in] x Coordinate x.
+     * @param[in] odd Whether ordinary y is odd.
+     * @param[out] out Point.
+     *
+     * @return false If x is not a coordinate of a curve point.
+     */
+    bool Lift( const Number& x, bool odd, Point& out ) const
+    {
+        if( x >= field_.Modulus() )
+        {
+            return false;
+        }
+        Number montX = field_.ToMont( x );
+        Number square = field_.Add( field_.Sqr( montX ), a_ );
+        field_.Mul( square, montX, square );
+        field_.Add( square, b_, square );
+        Number root;
+        if( !sqrt_.Sqrt( square, root ) )
+        {
+            return false;
+        }
+        Number y = field_.FromMont( root );
+        if( ( ( y.Limbs()[ 0 ] & 1 ) != 0 ) != odd && !y.IsZero() )
+        {
+            y = field_.Modulus() - y;
+        }
+        out = FromAffine( x, y );
+        return true;
+    }
+
+    /**
+     * @brief Size of compressed point: prefix byte and x.
+     */
+    static constexpr size_t COMPRESSED_SIZE = bitSize / 8 + 1;
+
+    /**
+     * @brief Encode finite point as 0x02 for even or 0x03 for odd ordinary y, followed by
+     * big-endian ordinary x, as in SEC 1.
+     *
+     * @param[in] point Finite point.
+     * @param[out] out COMPRESSED_SIZE bytes.
+     *
+     * @throw std::runtime_error If point is at infinity.
+     */
+    void Compress( const Point& point, uint8_t* out ) const
+    {
+        Number x;
+        Number y;
+        ToAffine( point, x, y );
+        out[ 0 ] = static_cast< uint8_t >( 0x02 | ( y.Limbs()[ 0 ] & 1 ) );
+        x.ExportBE( out + 1, COMPRESSED_SIZE - 1 );
+    }
+
+    /**
+     * @brief Decode point encoded by Compress.
+     *
+     * @param[in] data COMPRESSED_SIZE bytes.
+     *
+     * @throw std::runtime_error If data is not an encoding of a curve point.
+     */
+    Point Decompress( const uint8_t* data ) const
+    {
+        [[unlikely]] if( ( data[ 0 ] & ~1 ) != 0x02 )
+        {
+            throw std::runtime_error( "Invalid compressed point" );
+        }
+        Number x;
+        x.ImportBE( data + 1, COMPRESSED_SIZE - 1 );
+        Point ret;
+        [[unlikely]] if( !Lift( x, data[ 0 ] == 0x03, ret ) )
+        {
+            throw std::runtime_error( "Invalid compressed point" );
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Ordinary Weierstrass coordinates of a finite point.
+     *
+     * @throw std::runtime_error If point is at infinity.
+     */
+    void ToAffine( const Point& point, Number& x, Number& y ) const
+    {
+        [[unlikely]] if( point.infinity )
+        {
+            throw std::runtime_error( "Point at infinity has no affine coordinates" );
+        }
+        if( model_ != TWISTED_EDWARDS )
+        {
+            x = field_.FromMont( point.x );
+            y = field_.FromMont( point.y );
+            return;
+        }
+
+        // ( 0, -1 ) is the point of order 2, ( t, 0 ).
+        if( point.x.IsZero() )
+        {
+            x = field_.FromMont( t_ );
+            y = 0;
+            return;
+        }
+        Number w = field_.Mul( field_.Add( field_.One(), point.y ),
+                               field_.Inverse( field_.Sub( field_.One(), point.y ) ) );
+        field_.Mul( s_, w, w );
+        x = field_.FromMont( field_.Add( w, t_ ) );
+        y = field_.FromMont( field_.Mul( w, field_.Inverse( point.x ) ) );
+    }
+
+    bool IsOnCurve( const Point& point ) const
+    {
+        if( point.infinity )
+        {
+            return true;
+        }
+        if( model_ == TWISTED_EDWARDS )
+        {
+            Number uu = field_.Sqr( point.x );
+            Number vv = field_.Sqr( point.y );
+            Number left = field_.Add( field_.Mul( e_, uu ), vv );
+            Number right = field_.Add( field_.One(), field_.Mul( d_, field_.Mul( uu, vv ) ) );
+            return left == right;
+        }
+        Number left = field_.Sqr( point.y );
+        Number right = field_.Add( field_.Sqr( point.x ), a_ );
+        field_.Mul( right, point.x, right );
+        field_.Add( right, b_, right );
+        return left == right;
+    }
+
+    Point Negate( const Point& point ) const
+    {
+        Point ret = point;
+        if( !point.infinity )
+        {
+            Number& coordinate = model_ == TWISTED_EDWARDS ? ret.x : ret.y;
+            field_.Sub( Number( 0 ), coordinate, coordinate );
+        }
+        return ret;
+    }
+
+    Point Add( const Point& left, const Point& right ) const
+    {
+        if( right.infinity )
+        {
+            return left;
+        }
+        Projective sum;
+        AddMixed( sum, ToProjective( left ), right );
+        return Normalize( sum );
+    }
+
+    Point Double( const Point& point ) const
+    {
+        Projective ret;
+        Double( ret, ToProjective( point ) );
+        return Normalize( ret );
+    }
+
+    /**
+     * @brief k * point by double-and-add with a single inversion. Running time depends
+     * on k, use only for public scalars.
+     */
+    Point Mul( const Point& point, const Number& k ) const
+    {
+        Projective acc = Neutral();
+        if( point.infinity )
+        {
+            return Point();
+        }
+        for( size_t i = k.BitLength(); i > 0; --i )
+        {
+            Double( acc, acc );
+            size_t bit = i - 1;
+            if( ( ( k.Limbs()[ bit / 64 ] >> ( bit % 64 ) ) & 1 ) != 0 )
+            {
+                AddMixed( acc, acc, point );
+            }
+        }
+        return Normalize( acc );
+    }
+
+    /**
+     * @brief Projective representation of the neutral element.
+     */
+    Projective Neutral() const
+    {
+        if( model_ == TWISTED_EDWARDS )
+        {
+            return Projective{ Number( 0 ), field_.One(), field_.One(), Number( 0 ) };
+        }
+        return Projective{ field_.One(), field_.One(), Number( 0 ), Number( 0 ) };
+    }
+
+    Projective ToProjective( const Point& point ) const
+    {
+        if( point.infinity )
+        {
+            return Neutral();
+        }
+        Projective ret{ point.x, point.y, field_.One(), Number( 0 ) };
+        if( model_ == TWISTED_EDWARDS )
+        {
+            field_.Mul( point.x, point.y, ret.t );
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Convert projective point to affine with one inversion.
+     */
+    Point Normalize( const Projective& point ) const
+    {
+        Point ret;
+        if( model_ == TWISTED_EDWARDS )
+        {
+            Number inverse = field_.Inverse( point.z );
+            field_.Mul( point.x, inverse, ret.x );
+            field_.Mul( point.y, inverse, ret.y );
+            ret.infinity = ret.x.IsZero() && ret.y == field_.One();
+            return ret;
+        }
+        if( point.z.IsZero() )
+        {
+            return ret;
+        }
+        Number inverse = field_.Inverse( point.z );
+        Number square = field_.Sqr( inverse );
+        field_.Mul( point.x, square, ret.x );
+        field_.Mul( square, inverse, square );
+        field_.Mul( point.y, square, ret.y );
+        ret.infinity = false;
+        return ret;
+    }
+
+    /**
+     * @brief Convert projective points to affine with one inversion in total.
+     *
+     * @param[in] points Points, none at infinity for Weierstrass models.
+     * @param[out] out Affine points, may not alias \p points.
+     * @param[in] count Count of points.
+     */
+    void NormalizeBatch( const Projective* points, Point* out, size_t count ) const
+    {
+        math::LongNumberArray< bitSize > inverses( count );
+        for( size_t i = 0; i < count; ++i )
+        {
+            inverses.Set( i, points[ i ].z );
+        }
+        field_.BatchInverse( inverses );
+
+        Number inverse;
+        for( size_t i = 0; i < count; ++i )
+        {
+            inverses.Get( i, inverse );
+            Point& ret = out[ i ];
+            if( model_ == TWISTED_EDWARDS )
+            {
+                field_.Mul( points[ i ].x, inverse, ret.x );
+                field_.Mul( points[ i ].y, inverse, ret.y );
+                ret.infinity = ret.x.IsZero() && ret.y == field_.One();
+                continue;
+            }
+            Number square = field_.Sqr( inverse );
+            field_.Mul( points[ i ].x, square, ret.x );
+            field_.Mul( square, inverse, square );
+            field_.Mul( points[ i ].y, square, ret.y );
+            ret.infinity = false;
+        }
+    }
+
+    /**
+     * @brief Whether projective \p a is the finite affine point \p b, without inversion.
+     */
+    bool Equals( const Projective& a, const Point& b ) const
+    {
+        uint64_t x[ LIMB_COUNT ];
+        uint64_t y[ LIMB_COUNT ];
+        if( model_ == TWISTED_EDWARDS )
+        {
+            // x = X / Z, y = Y / Z.
+            field_.MulLimbs( x, b.x.Limbs(), a.z.Limbs() );
+            field_.MulLimbs( y, b.y.Limbs(), a.z.Limbs() );
+        }
+        else
+        {
+            // x = X / Z^2, y = Y / Z^3, zero Z is the point at infinity.
+            if( a.z.IsZero() )
+            {
+                return false;
+            }
+            field_.MulLimbs( x, a.z.Limbs(), a.z.Limbs() );
+            field_.MulLimbs( y, x, a.z.Limbs() );
+            field_.MulLimbs( x, b.x.Limbs(), x );
+            field_.MulLimbs( y, b.y.Limbs(), y );
+        }
+        return std::memcmp( x, a.x.Limbs(), sizeof( x ) ) == 0
+               && std::memcmp( y, a.y.Limbs(), sizeof( y ) ) == 0;
+    }
+
+    /**
+     * @brief r = 2a. Output may alias input.
+     */
+    void Double( Projective& r, const Projective& a ) const
+    {
+        switch( model_ )
+        {
+        case TWISTED_EDWARDS:
+            DoubleExtended( r, a );
+            break;
+        case WEIERSTRASS_A_MINUS_3:
+            DoubleJacobianAMinus3( r, a );
+            break;
+        default:
+            DoubleJacobian( r, a );
+            break;
+        }
+    }
+
+    /**
+     * @brief r = a + b. Output may alias inputs.
+     */
+    void Add( Projective& r, const Projective& a, const Projective& b ) const
+    {
+        if( model_ == TWISTED_EDWARDS )
+        {
+            AddExtended( r, a, b.x.Limbs(), b.y.Limbs(), b.t.Limbs(), b.z.Limbs() );
+            return;
+        }
+        AddJacobian( r, a, b );
+    }
+
+    /**
+     * @brief r = a + b for affine b, cheaper than Add. Output may alias input.
+     */
+    void AddMixed( Projective& r, const Projective& a, const Point& b ) const
+    {
+        if( b.infinity )
+        {
+            CRYPT_GOST_EC_COUNT( shortcuts );
+            r = a;
+            return;
+        }
+        if( model_ == TWISTED_EDWARDS )
+        {
+            uint64_t bt[ LIMB_COUNT ];
+            field_.MulLimbs( bt, b.x.Limbs(), b.y.Limbs() );
+            AddExtended( r, a, b.x.Limbs(), b.y.Limbs(), bt, field_.One().Limbs() );
+            return;
+        }
+        AddMixedJacobian( r, a, b );
+    }
+
+    /**
+     * @brief r = mask ? a : b with no branch on mask, which is all ones or zero.
+     */
+    static void Select( Number& r, const Number& a, const Number& b, uint64_t mask )
+    {
+        uint64_t limbs[ Number::LIMB_COUNT ];
+        for( size_t i = 0; i < Number::LIMB_COUNT; ++i )
+        {
+            limbs[ i ] = ( a.Limbs()[ i ] & mask ) | ( b.Limbs()[ i ] & ~mask );
+        }
+        r.AssignLimbs( limbs );
+    }
+
+    static void Select( Projective& r, const Projective& a, const Projective& b, uint64_t mask )
+    {
+        Select( r.x, a.x, b.x, mask );
+        Select( r.y, a.y, b.y, mask );
+        Select( r.z, a.z, b.z, mask );
+        Select( r.t, a.t, b.t, mask );
+    }
+
+    /**
+     * @brief Negate finite point if mask is all ones, with no branch on mask.
+     */
+    void NegateIf( Point& point, uint64_t mask ) const
+    {
+        Number& coordinate = model_ == TWISTED_EDWARDS ? point.x : point.y;
+        Select( coordinate, field_.Sub( Number( 0 ), coordinate ), coordinate, mask );
+    }
+
+private:
+    static Number Parse( const char* hex, const CurveParams& params )
+    {
+        [[unlikely]] if( params.bitSize != bitSize )
+        {
+            throw std::runtime_error( "Parameter set bit size mismatch" );
+        }
+        Number ret;
+        ret.FromHex( hex );
+        return ret;
+    }
+
+    static constexpr size_t LIMB_COUNT = Number::LIMB_COUNT;
+
+    // Formulas below keep temporaries in stack buffers and use the limb operations of the
+    // field, so that a point operation makes no allocations. Result is stored after all
+    // inputs are read, so output may alias inputs.
+
+    static bool IsZero( const uint64_t* a ) noexcept
+    {
+        uint64_t bits = 0;
+        for( size_t i = 0; i < LIMB_COUNT; ++i )
+        {
+            bits |= a[ i ];
+        }
+        return bits == 0;
+    }
+
+    static void Store( Projective& r, const uint64_t* x, const uint64_t* y, const uint64_t* z )
+    {
+        r.x.AssignLimbs( x );
+        r.y.AssignLimbs( y );
+        r.z.AssignLimbs( z );
+    }
+
+    // dbl-2007-bl.
+    void DoubleJacobian( Projective& r, const Projective& a ) const
+    {
+        CRYPT_GOST_EC_COUNT( doublings );
+        uint64_t xx[ LIMB_COUNT ];
+        uint64_t yy[ LIMB_COUNT ];
+        uint64_t yyyy[ LIMB_COUNT ];
+        uint64_t zz[ LIMB_COUNT ];
+        uint64_t s[ LIMB_COUNT ];
+        uint64_t m[ LIMB_COUNT ];
+        uint64_t tmp[ LIMB_COUNT ];
+        uint64_t x3[ LIMB_COUNT ];
+        uint64_t y3[ LIMB_COUNT ];
+        uint64_t z3[ LIMB_COUNT ];
+        field_.MulLimbs( xx, a.x.Limbs(), a.x.Limbs() );
+        field_.MulLimbs( yy, a.y.Limbs(), a.y.Limbs() );
+        field_.MulLimbs( yyyy, yy, yy );
+        field_.MulLimbs( zz, a.z.Limbs(), a.z.Limbs() );
+        // s = 2( ( x + yy )^2 - xx - yyyy ).
+        field_.AddLimbs( s, a.x.Limbs(), yy );
+        field_.MulLimbs( s, s, s );
+        field_.SubLimbs( s, s, xx );
+        field_.SubLimbs( s, s, yyyy );
+        field_.AddLimbs( s, s, s );
+        // m = 3xx + a * zz^2.
+        field_.AddLimbs( m, xx, xx );
+        field_.AddLimbs( m, m, xx );
+        field_.MulLimbs( tmp, zz, zz );
+        field_.MulLimbs( tmp, a_.Limbs(), tmp );
+        field_.AddLimbs( m, m, tmp );
+        // z3 = ( y + z )^2 - yy - zz.
+        field_.AddLimbs( z3, a.y.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( z3, z3, z3 );
+        field_.SubLimbs( z3, z3, yy );
+        field_.SubLimbs( z3, z3, zz );
+        // x3 = m^2 - 2s, y3 = m( s - x3 ) - 8yyyy.
+        field_.MulLimbs( x3, m, m );
+        field_.AddLimbs( tmp, s, s );
+        field_.SubLimbs( x3, x3, tmp );
+        field_.SubLimbs( y3, s, x3 );
+        field_.MulLimbs( y3, m, y3 );
+        field_.AddLimbs( yyyy, yyyy, yyyy );
+        field_.AddLimbs( yyyy, yyyy, yyyy );
+        field_.AddLimbs( yyyy, yyyy, yyyy );
+        field_.SubLimbs( y3, y3, yyyy );
+        Store( r, x3, y3, z3 );
+    }
+
+    // dbl-2001-b.
+    void DoubleJacobianAMinus3( Projective& r, const Projective& a ) const
+    {
+        CRYPT_GOST_EC_COUNT( doublings );
+        uint64_t delta[ LIMB_COUNT ];
+        uint64_t gamma[ LIMB_COUNT ];
+        uint64_t beta[ LIMB_COUNT ];
+        uint64_t alpha[ LIMB_COUNT ];
+        uint64_t tmp[ LIMB_COUNT ];
+        uint64_t x3[ LIMB_COUNT ];
+        uint64_t y3[ LIMB_COUNT ];
+        uint64_t z3[ LIMB_COUNT ];
+        field_.MulLimbs( delta, a.z.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( gamma, a.y.Limbs(), a.y.Limbs() );
+        field_.MulLimbs( beta, a.x.Limbs(), gamma );
+        // alpha = 3( x - delta )( x + delta ).
+        field_.SubLimbs( alpha, a.x.Limbs(), delta );
+        field_.AddLimbs( tmp, a.x.Limbs(), delta );
+        field_.MulLimbs( alpha, alpha, tmp );
+        field_.AddLimbs( tmp, alpha, alpha );
+        field_.AddLimbs( alpha, tmp, alpha );
+        // z3 = ( y + z )^2 - gamma - delta.
+        field_.AddLimbs( z3, a.y.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( z3, z3, z3 );
+        field_.SubLimbs( z3, z3, gamma );
+        field_.SubLimbs( z3, z3, delta );
+        // x3 = alpha^2 - 8beta, y3 = alpha( 4beta - x3 ) - 8gamma^2.
+        field_.AddLimbs( beta, beta, beta );
+        field_.AddLimbs( beta, beta, beta );
+        field_.MulLimbs( x3, alpha, alpha );
+        field_.AddLimbs( tmp, beta, beta );
+        field_.SubLimbs( x3, x3, tmp );
+        field_.SubLimbs( y3, beta, x3 );
+        field_.MulLimbs( y3, alpha, y3 );
+        field_.MulLimbs( gamma, gamma, gamma );
+        field_.AddLimbs( gamma, gamma, gamma );
+        field_.AddLimbs( gamma, gamma, gamma );
+        field_.AddLimbs( gamma, gamma, gamma );
+        field_.SubLimbs( y3, y3, gamma );
+        Store( r, x3, y3, z3 );
+    }
+
+    // add-2007-bl, with doubling and infinity handled separately.
+    void AddJacobian( Projective& r, const Projective& a, const Projective& b ) const
+    {
+        if( a.z.IsZero() || b.z.IsZero() )
+        {
+            CRYPT_GOST_EC_COUNT( shortcuts );
+            r = a.z.IsZero() ? b : a;
+            return;
+        }
+        uint64_t z1z1[ LIMB_COUNT ];
+        uint64_t z2z2[ LIMB_COUNT ];
+        uint64_t u1[ LIMB_COUNT ];
+        uint64_t s1[ LIMB_COUNT ];
+        uint64_t h[ LIMB_COUNT ];
+        uint64_t rr[ LIMB_COUNT ];
+        field_.MulLimbs( z1z1, a.z.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( z2z2, b.z.Limbs(), b.z.Limbs() );
+        field_.MulLimbs( u1, a.x.Limbs(), z2z2 );
+        field_.MulLimbs( h, b.x.Limbs(), z1z1 );
+        field_.SubLimbs( h, h, u1 );
+        field_.MulLimbs( s1, a.y.Limbs(), b.z.Limbs() );
+        field_.MulLimbs( s1, s1, z2z2 );
+        field_.MulLimbs( rr, b.y.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( rr, rr, z1z1 );
+        field_.SubLimbs( rr, rr, s1 );
+        if( IsZero( h ) )
+        {
+            CRYPT_GOST_EC_COUNT( shortcuts );
+            if( IsZero( rr ) )
+            {
+                Double( r, a );
+            }
+            else
+            {
+                r = Neutral();
+            }
+            return;
+        }
+        CRYPT_GOST_EC_COUNT( additions );
+        field_.AddLimbs( rr, rr, rr );
+        // i = ( 2h )^2, j = hi, v = u1 * i.
+        uint64_t i[ LIMB_COUNT ];
+        uint64_t j[ LIMB_COUNT ];
+        uint64_t v[ LIMB_COUNT ];
+        field_.AddLimbs( i, h, h );
+        field_.MulLimbs( i, i, i );
+        field_.MulLimbs( j, h, i );
+        field_.MulLimbs( v, u1, i );
+        // z3 = ( ( z1 + z2 )^2 - z1z1 - z2z2 )h.
+        uint64_t x3[ LIMB_COUNT ];
+        uint64_t y3[ LIMB_COUNT ];
+        uint64_t z3[ LIMB_COUNT ];
+        field_.AddLimbs( z3, a.z.Limbs(), b.z.Limbs() );
+        field_.MulLimbs( z3, z3, z3 );
+        field_.SubLimbs( z3, z3, z1z1 );
+        field_.SubLimbs( z3, z3, z2z2 );
+        field_.MulLimbs( z3, z3, h );
+        // x3 = rr^2 - j - 2v, y3 = rr( v - x3 ) - 2 * s1 * j.
+        field_.MulLimbs( x3, rr, rr );
+        field_.SubLimbs( x3, x3, j );
+        field_.SubLimbs( x3, x3, v );
+        field_.SubLimbs( x3, x3, v );
+        field_.MulLimbs( s1, s1, j );
+        field_.SubLimbs( y3, v, x3 );
+        field_.MulLimbs( y3, rr, y3 );
+        field_.SubLimbs( y3, y3, s1 );
+        field_.SubLimbs( y3, y3, s1 );
+        Store( r, x3, y3, z3 );
+    }
+
+    // madd-2007-bl, with doubling and infinity handled separately.
+    void AddMixedJacobian( Projective& r, const Projective& a, const Point& b ) const
+    {
+        if( a.z.IsZero() )
+        {
+            CRYPT_GOST_EC_COUNT( shortcuts );
+            r = ToProjective( b );
+            return;
+        }
+        uint64_t z1z1[ LIMB_COUNT ];
+        uint64_t h[ LIMB_COUNT ];
+        uint64_t rr[ LIMB_COUNT ];
+        field_.MulLimbs( z1z1, a.z.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( h, b.x.Limbs(), z1z1 );
+        field_.SubLimbs( h, h, a.x.Limbs() );
+        field_.MulLimbs( rr, b.y.Limbs(), a.z.Limbs() );
+        field_.MulLimbs( rr, rr, z1z1 );
+        field_.SubLimbs( rr, rr, a.y.Limbs() );
+        if( IsZero( h ) )
+        {
+            CRYPT_GOST_EC_COUNT( shortcuts );
+            if( IsZero( rr ) )
+            {
+                Double( r, a );
+            }
+            else
+            {
+                r = Neutral();
+            }
+            return;
+        }
+        CRYPT_GOST_EC_COUNT( additions );
+        field_.AddLimbs( rr, rr, rr );
+        // hh = h^2, i = 4hh, j = hi, v = x1 * i.
+        uint64_t hh[ LIMB_COUNT ];
+        uint64_t i[ LIMB_COUNT ];
+        uint64_t j[ LIMB_COUNT ];
+        uint64_t v[ LIMB_COUNT ];
+        field_.MulLimbs( hh, h, h );
+        field_.AddLimbs( i, hh, hh );
+        field_.AddLimbs( i, i, i );
+        field_.MulLimbs( j, h, i );
+        field_.MulLimbs( v, a.x.Limbs(), i );
+        // z3 = ( z1 + h )^2 - z1z1 - hh.
+        uint64_t x3[ LIMB_COUNT ];
+        uint64_t y3[ LIMB_COUNT ];
+        uint64_t z3[ LIMB_COUNT ];
+        field_.AddLimbs( z3, a.z.Limbs(), h );
+        field_.MulLimbs( z3, z3, z3 );
+        field_.SubLimbs( z3, z3, z1z1 );
+        field_.SubLimbs( z3, z3, hh );
+        // x3 = rr^2 - j - 2v, y3 = rr( v - x3 ) - 2 * y1 * j.
+        field_.MulLimbs( x3, rr, rr );
+        field_.SubLimbs( x3, x3, j );
+        field_.SubLimbs( x3, x3, v );
+        field_.SubLimbs( x3, x3, v );
+        field_.MulLimbs( j, a.y.Limbs(), j );
+        field_.SubLimbs( y3, v, x3 );
+        field_.MulLimbs( y3, rr, y3 );
+        field_.SubLimbs( y3, y3, j );
+        field_.SubLimbs( y3, y3, j );
+        Store( r, x3, y3, z3 );
+    }
+
+    // dbl-2008-hwcd.
+    void DoubleExtended( Projective& r, const Projective& a ) const
+    {
+        CRYPT_GOST_EC_COUNT( doublings );
+        uint64_t aa[ LIMB_COUNT ];
+        uint64_t bb[ LIMB_COUNT ];
+        uint64_t cc[ LIMB_COUNT ];
+        uint64_t dd[ LIMB_COUNT ];
+        uint64_t ee[ LIMB_COUNT ];
+        uint64_t f[ LIMB_COUNT ];
+        uint64_t g[ LIMB_COUNT ];
+        uint64_t h[ LIMB_COUNT ];
+        field_.MulLimbs( aa, a.x.Limbs(), a.x.Limbs() );
+        field_.MulLimbs( bb, a.y.Limbs(), a.y.Limbs() );
+        field_.MulLimbs( cc, a.z.Limbs(), a.z.Limbs() );
+        field_.AddLimbs( cc, cc, cc );
+        field_.MulLimbs( dd, e_.Limbs(), aa );
+        // ee = ( x + y )^2 - aa - bb.
+        field_.AddLimbs( ee, a.x.Limbs(), a.y.Limbs() );
+        field_.MulLimbs( ee, ee, ee );
+        field_.SubLimbs( ee, ee, aa );
+        field_.SubLimbs( ee, ee, bb );
+        field_.AddLimbs( g, dd, bb );
+        field_.SubLimbs( f, g, cc );
+        field_.SubLimbs( h, dd, bb );
+        StoreExtended( r, ee, f, g, h );
+    }
+
+    // add-2008-hwcd, unified: valid for doubling as well. Coordinates of b are given
+    // separately, so that affine b passes One() as bz.
+    void AddExtended( Projective& r,
+                      const Projective& a,
+                      const uint64_t* bx,
+                      const uint64_t* by,
+                      const uint64_t* bt,
+                      const uint64_t* bz ) const
+    {
+        CRYPT_GOST_EC_COUNT( additions );
+        uint64_t aa[ LIMB_COUNT ];
+        uint64_t bb[ LIMB_COUNT ];
+        uint64_t cc[ LIMB_COUNT ];
+        uint64_t dd[ LIMB_COUNT ];
+        uint64_t ee[ LIMB_COUNT ];
+        uint64_t f[ LIMB_COUNT ];
+        uint64_t g[ LIMB_COUNT ];
+        uint64_t h[ LIMB_COUNT ];
+        field_.MulLimbs( aa, a.x.Limbs(), bx );
+        field_.MulLimbs( bb, a.y.Limbs(), by );
+        field_.MulLimbs( cc, d_.Limbs(), a.t.Limbs() );
+        field_.MulLimbs( cc, cc, bt );
+        field_.MulLimbs( dd, a.z.Limbs(), bz );
+        // ee = ( x1 + y1 )( x2 + y2 ) - aa - bb.
+        field_.AddLimbs( ee, a.x.Limbs(), a.y.Limbs() );
+        field_.AddLimbs( h, bx, by );
+        field_.MulLimbs( ee, ee, h );
+        field_.SubLimbs( ee, ee, aa );
+        field_.SubLimbs( ee, ee, bb );
+        field_.SubLimbs( f, dd, cc );
+        field_.AddLimbs( g, dd, cc );
+        field_.MulLimbs( h, e_.Limbs(), aa );
+        field_.SubLimbs( h, bb, h );
+        StoreExtended( r, ee, f, g, h );
+    }
+
+    // x3 = ef, y3 = gh, t3 = eh, z3 = fg.
+    void StoreExtended( Projective& r,
+                        const uint64_t* e,
+                        const uint64_t* f,
+                        const uint64_t* g,
+                        const uint64_t* h ) const
+    {
+        uint64_t product[ LIMB_COUNT ];
+        field_.MulLimbs( product, e, f );
+        r.x.AssignLimbs( product );
+        field_.MulLimbs( product, g, h );
+        r.y.AssignLimbs( product );
+        field_.MulLimbs( product, e, h );
+        r.t.AssignLimbs( product );
+        field_.MulLimbs( product, f, g );
+        r.z.AssignLimbs( product );
+    }
+
+    Field field_;
+    Model model_;
+    Number a_;
+    Number b_;
+    Number e_;
+    Number d_;
+    Number s_;
+    Number t_;
+    math::SqrtContext< bitSize > sqrt_;
+    Number order_;
+    unsigned cofactor_;
+    Point base_;
+};
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include <core/ec/curve.hpp>
+#include <core/util/crc32.hpp>
+#include <core/util/mapped_file.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+/**
+ * @brief Precomputed multiples of a fixed point for fast scalar multiplication.
+ *
+ * Scalar is split into 4-bit windows k = sum( k_i * 16^i ). Table row i holds
+ * j * 16^i * P for j = 1..15 in affine form, so k * P is the sum of one entry per window,
+ * accumulated with mixed additions, and needs no doublings. Entries are read with a full
+ * scan of the row, which does not reveal the window value through memory access pattern.
+ * The sum starts from a fixed offset point, whose logarithm is unknown, and the offset is
+ * subtracted at the end, so Jacobian additions never meet the neutral element and take the
+ * same path for every k. On curves with twisted Edwards form the additions are unified and
+ * have no branches.
+ *
+ * A table may be saved to a file and loaded back with a read-only memory mapping, which
+ * is shared by all processes using the same file and saves building the table at start.
+ * File layout, all integers in host byte order:
+ *
+ * | Offset | Size | Field                                                      |
+ * |--------|------|------------------------------------------------------------|
+ * | 0      | 8    | magic "CGFBTAB\0"                                          |
+ * | 8      | 4    | format version, FILE_VERSION                               |
+ * | 12     | 4    | byte order mark 0x01020304                                 |
+ * | 16     | 4    | bitSize                                                    |
+ * | 20     | 4    | WINDOW_BIT_SIZE                                            |
+ * | 24     | 4    | curve model                                                |
+ * | 28     | 4    | CRC-32 of the whole file, computed with this field zeroed  |
+ * | 32     | 8    | count of windows                                           |
+ * | 40     | 8    | offset of entries, a multiple of 64                        |
+ * | 48     | 8    | size of entries                                            |
+ * | 56     | *    | field modulus, bitSize / 64 words, least significant first |
+ *
+ * Entries follow padding up to their offset. Entry of window i and multiple j is at
+ * index i * ROW_SIZE + j - 1 and consists of x and y, each bitSize / 64 words of
+ * Montgomery form, least significant first.
+ */
+template < size_t bitSize >
+class FixedBaseTable final
+{
+public:
+    using CurveType = Curve< bitSize >;
+    using Number = typename CurveType::Number;
+    using Point = typename CurveType::Point;
+
+    static constexpr size_t WINDOW_BIT_SIZE = 4;
+    static constexpr size_t ROW_SIZE = ( 1 << WINDOW_BIT_SIZE ) - 1;
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    /**
+     * @brief Build table of multiples of \p point.
+     *
+     * @param[in] curve Curve, must outlive the table.
+     * @param[in] point Finite point of order q.
+     */
+    FixedBaseTable( const CurveType& curve, const Point& point )
+        : curve_( curve )
+        , windows_( WindowCount( curve ) )
+        , owned_( windows_ * ROW_SIZE * ENTRY_LIMB_COUNT )
+        , file_()
+        , entries_( owned_.data() )
+        , offset_( OffsetPoint( curve, point ) )
+        , negatedOffset_( curve.Negate( offset_ ) )
+    {
+        // Row i is j * B for j = 1..16, where B = 16^i * P is the last entry of the
+        // previous row. Each row is normalized with a single inversion.
+        typename CurveType::Projective multiples[ ROW_SIZE + 1 ];
+        Point row[ ROW_SIZE + 1 ];
+        Point rowBase = point;
+        for( size_t i = 0; i < windows_; ++i )
+        {
+            multiples[ 0 ] = curve_.ToProjective( rowBase );
+            for( size_t j = 1; j <= ROW_SIZE; ++j )
+            {
+                curve_.AddMixed( multiples[ j ], multiples[ j - 1 ], rowBase );
+            }
+            curve_.NormalizeBatch( multiples, row, ROW_SIZE + 1 );
+            for( size_t j = 0; j < ROW_SIZE; ++j )
+            {
+                uint64_t* entry = owned_.data() + ( i * ROW_SIZE + j ) * ENTRY_LIMB_COUNT;
+                std::memcpy( entry, row[ j ].x.Limbs(), LIMB_BYTE_SIZE );
+                std::memcpy( entry + LIMB_COUNT, row[ j ].y.Limbs(), LIMB_BYTE_SIZE );
+            }
+            rowBase = row[ ROW_SIZE ];
+        }
+    }
+
+    /**
+     * @brief Map table saved by Save.
+     *
+     * Every entry is checked to be the sum of the previous entry and the first entry of its
+     * row, starting from \p point, with one mixed addition per entry and no inversion. The
+     * check is done once, so the file must be writable only by trusted users: the mapping
+     * is shared, and later changes of the file are seen by the table.
+     *
+     * @param[in] curve Curve, must outlive the table.
+     * @param[in] point Point the table was built for.
+     * @param[in] path Path of the file.
+     *
+     * @throw std::runtime_error If the file cannot be mapped, is damaged, has another
+     * format version, or was built for another curve or point.
+     */
+    static FixedBaseTable Load( const CurveType& curve, const Point& point, const char* path )
+    {
+        return FixedBaseTable( curve, point, util::MappedFile( path ) );
+    }
+
+    /**
+     * @brief Save table to file, see Load and util::ReplaceFile.
+     *
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void Save( const char* path ) const
+    {
+        FileHeader header = MakeHeader( curve_, windows_ );
+        const uint8_t padding[ DATA_OFFSET - sizeof( FileHeader ) ] = {};
+        uint32_t crc = util::Crc32( &header, sizeof( header ) );
+        crc = util::Crc32( padding, sizeof( padding ), crc );
+        crc = util::Crc32( entries_, DataSize( windows_ ), crc );
+        header.checksum = crc;
+
+        const util::ConstSegment segments[] = {
+            { reinterpret_cast< const uint8_t* >( &header ), sizeof( header ) },
+            { padding, sizeof( padding ) },
+            { reinterpret_cast< const uint8_t* >( entries_ ), DataSize( windows_ ) },
+        };
+        util::ReplaceFile( path, segments, std::size( segments ) );
+    }
+
+    /**
+     * @brief Whether entries are read from a mapped file.
+     */
+    inline bool IsMapped() const noexcept
+    {
+        return file_.Data() != nullptr;
+    }
+
+    /**
+     * @brief k * P for 0 <= k < q.
+     */
+    Point Mul( const Number& k ) const
+    {
+        constexpr size_t WORD_BIT_SIZE = 64;
+        typename CurveType::Projective acc = curve_.ToProjective( offset_ );
+        typename CurveType::Projective sum;
+        Point entry;
+        entry.infinity = false;
+        for( size_t i = 0; i < windows_; ++i )
+        {
+            size_t bit = i * WINDOW_BIT_SIZE;
+            uint64_t window =
+                ( k.Limbs()[ bit / WORD_BIT_SIZE ] >> ( bit % WORD_BIT_SIZE ) ) & ROW_SIZE;
+            Select( entry, i, window );
+
+            // Addition is performed for zero windows as well, with entry 1 * 16^i * P, and
+            // its result is discarded.
+            curve_.AddMixed( sum, acc, entry );
+            uint64_t keep = static_cast< uint64_t >( 0 ) - static_cast< uint64_t >( window == 0 );
+            CurveType::Select( acc, acc, sum, keep );
+        }
+        curve_.AddMixed( acc, acc, negatedOffset_ );
+        return curve_.Normalize( acc );
+    }
+
+private:
+    static constexpr size_t LIMB_COUNT = Number::LIMB_COUNT;
+    static constexpr size_t LIMB_BYTE_SIZE = LIMB_COUNT * sizeof( uint64_t );
+    static constexpr size_t ENTRY_LIMB_COUNT = 2 * LIMB_COUNT;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr char MAGIC[ 8 ] = { 'C', 'G', 'F', 'B', 'T', 'A', 'B', '\0' };
+
+    struct FileHeader
+    {
+        char magic[ 8 ];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t numberBitSize;
+        uint32_t windowBitSize;
+        uint32_t model;
+        uint32_t checksum;
+        uint64_t windows;
+        uint64_t dataOffset;
+        uint64_t dataSize;
+        uint64_t modulus[ LIMB_COUNT ];
+    };
+
+    static constexpr size_t DATA_OFFSET = ( sizeof( FileHeader ) + 63 ) / 64 * 64;
+
+    FixedBaseTable( const CurveType& curve, const Point& point, util::MappedFile&& file )
+        : curve_( curve )
+        , windows_( WindowCount( curve ) )
+        , owned_()
+        , file_( std::move( file ) )
+        , entries_( nullptr )
+        , offset_( OffsetPoint( curve, point ) )
+        , negatedOffset_( curve.Negate( offset_ ) )
+    {
+        FileHeader header;
+        [[unlikely]] if( file_.Size() < DATA_OFFSET )
+        {
+            throw std::runtime_error( "Invalid table file" );
+        }
+        std::memcpy( &header, file_.Data(), sizeof( header ) );
+        [[unlikely]] if( std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0
+                         || header.byteOrder != BYTE_ORDER_MARK )
+        {
+            throw std::runtime_error( "Invalid table file" );
+        }
+        [[unlikely]] if( header.version != FILE_VERSION )
+        {
+            throw std::runtime_error( "Unsupported table file version" );
+        }
+
+        uint32_t checksum = header.checksum;
+        header.checksum = 0;
+        uint32_t crc = util::Crc32( &header, sizeof( header ) );
+        crc = util::Crc32( file_.Data() + sizeof( header ), file_.Size() - sizeof( header ), crc );
+        [[unlikely]] if( crc != checksum )
+        {
+            throw std::runtime_error( "Table file checksum mismatch" );
+        }
+
+        FileHeader expected = MakeHeader( curve_, windows_ );
+        [[unlikely]] if( std::memcmp( &header, &expected, sizeof( header ) ) != 0
+                         || file_.Size() != DATA_OFFSET + DataSize( windows_ ) )
+        {
+            throw std::runtime_error( "Table file does not match the curve" );
+        }
+        entries_ = reinterpret_cast< const uint64_t* >( file_.Data() + DATA_OFFSET );
+        [[unlikely]] if( point.infinity || !IsValid( point ) )
+        {
+            throw std::runtime_error( "Table file does not match the point" );
+        }
+    }
+
+    // Entry of window i and multiple j is j * B for B = 16^i * P, so it is the previous
+    // entry plus B, and B of the next window is 15 * B + B. Each entry is checked against
+    // a sum of entries checked before it, starting from the point itself.
+    bool IsValid( const Point& point ) const
+    {
+        Point rowBase = Entry( 0 );
+        [[unlikely]] if( rowBase.x != point.x || rowBase.y != point.y )
+        {
+            return false;
+        }
+        typename CurveType::Projective sum = curve_.ToProjective( rowBase );
+        for( size_t index = 1; index < windows_ * ROW_SIZE; ++index )
+        {
+            curve_.AddMixed( sum, sum, rowBase );
+            Point entry = Entry( index );
+            [[unlikely]] if( !curve_.Equals( sum, entry ) )
+            {
+                return false;
+            }
+            if( index % ROW_SIZE == 0 )
+            {
+                rowBase = entry;
+                sum = curve_.ToProjective( rowBase );
+            }
+        }
+        return true;
+    }
+
+    Point Entry( size_t index ) const
+    {
+        Point ret;
+        ret.x.AssignLimbs( entries_ + index * ENTRY_LIMB_COUNT );
+        ret.y.AssignLimbs( entries_ + index * ENTRY_LIMB_COUNT + LIMB_COUNT );
+        ret.infinity = false;
+        return ret;
+    }
+
+    // Point with the least x = 1, 2, ..., skipping x of the table point: base points of some
+    // parameter sets have x = 1, and a multiple of the table point would make the additions
+    // in Mul exceptional for some scalars.
+    static Point OffsetPoint( const CurveType& curve, const Point& point )
+    {
+        Point ret;
+        for( Number x( 1 );; x += Number( 1 ) )
+        {
+            try
+            {
+                if( curve.Lift( x, false, ret ) && ret.x != point.x )
+                {
+                    return ret;
+                }
+            }
+            catch( const std::runtime_error& )
+            {
+                // Low order point without twisted Edwards form.
+            }
+        }
+    }
+
+    static size_t WindowCount( const CurveType& curve ) noexcept
+    {
+        return ( curve.Order().BitLength() + WINDOW_BIT_SIZE - 1 ) / WINDOW_BIT_SIZE;
+    }
+
+    static size_t DataSize( size_t windows ) noexcept
+    {
+        return windows * ROW_SIZE * ENTRY_LIMB_COUNT * sizeof( uint64_t );
+    }
+
+    // Header with zero checksum.
+    static FileHeader MakeHeader( const CurveType& curve, size_t windows ) noexcept
+    {
+        FileHeader header;
+        std::memset( &header, 0, sizeof( header ) );
+        std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+        header.version = FILE_VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.numberBitSize = bitSize;
+        header.windowBitSize = WINDOW_BIT_SIZE;
+        header.model = static_cast< uint32_t >( curve.GetModel() );
+        header.windows = windows;
+        header.dataOffset = DATA_OFFSET;
+        header.dataSize = DataSize( windows );
+        std::memcpy( header.modulus, curve.GetField().Modulus().Limbs(), LIMB_BYTE_SIZE );
+        return header;
+    }
+
+    // entry = row[ window - 1 ], or row[ 0 ] for zero window.
+    void Select( Point& entry, size_t row, uint64_t window ) const
+    {
+        CRYPT_GOST_EC_COUNT( tableScans );
+        uint64_t x[ LIMB_COUNT ] = {};
+        uint64_t y[ LIMB_COUNT ] = {};
+        uint64_t target = window | static_cast< uint64_t >( window == 0 );
+        const uint64_t* rowEntries = entries_ + row * ROW_SIZE * ENTRY_LIMB_COUNT;
+        for( size_t j = 0; j < ROW_SIZE; ++j )
+        {
+            uint64_t mask = static_cast< uint64_t >( 0 )
+                            - static_cast< uint64_t >( ( target ^ ( j + 1 ) ) == 0 );
+            const uint64_t* candidate = rowEntries + j * ENTRY_LIMB_COUNT;
+            for( size_t l = 0; l < LIMB_COUNT; ++l )
+            {
+                x[ l ] |= candidate[ l ] & mask;
+                y[ l ] |= candidate[ LIMB_COUNT + l ] & mask;
+            }
+        }
+        entry.x.AssignLimbs( x );
+        entry.y.AssignLimbs( y );
+    }
+
+    const CurveType& curve_;
+    size_t windows_;
+    std::vector< uint64_t > owned_;
+    util::MappedFile file_;
+    const uint64_t* entries_;
+    Point offset_;
+    Point negatedOffset_;
+};
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
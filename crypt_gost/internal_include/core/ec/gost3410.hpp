@@ -0,0 +1,486 @@
+#pragma once
+
+#include <vector>
+#include <core/ec/fixed_base.hpp>
+#include <core/ec/msm.hpp>
+#include <core/ec/point_table.hpp>
+#include <core/util/random.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+/**
+ * @brief GOST R 34.10-2012 digital signature.
+ *
+ * Multiples of the base point for key generation and signing come from a precomputed
+ * FixedBaseTable built once per object. Hash of the message is passed as number alpha,
+ * whose binary representation is the hash vector.
+ *
+ * Signatures with random nonces are canonical: nonce k is replaced by q - k when needed,
+ * so that point kP has even y. Such signatures are valid for any verifier and allow
+ * VerifyBatch to recover kP from r, if the caller knows that all items are canonical.
+ */
+template < size_t bitSize >
+class Gost3410 final
+{
+public:
+    using CurveType = Curve< bitSize >;
+    using Number = typename CurveType::Number;
+
+    struct PublicKey
+    {
+        Number x;
+        Number y;
+    };
+
+    struct Signature
+    {
+        Number r;
+        Number s;
+    };
+
+    /**
+     * @brief Signed hash with public key for VerifyBatch.
+     */
+    struct VerificationItem
+    {
+        Number alpha;
+        Signature signature;
+        PublicKey key;
+    };
+
+    explicit Gost3410( const CurveParams& params )
+        : curve_( params )
+        , order_( curve_.Order() )
+        , scalar_( curve_.Order() )
+        , baseTable_( curve_, curve_.Base() )
+    {
+    }
+
+    /**
+     * @brief Use base point table saved by FixedBaseTable::Save instead of building it.
+     *
+     * @throw std::runtime_error If the table file cannot be loaded, see FixedBaseTable::Load.
+     */
+    Gost3410( const CurveParams& params, const char* tablePath )
+        : curve_( params )
+        , order_( curve_.Order() )
+        , scalar_( curve_.Order() )
+        , baseTable_( FixedBaseTable< bitSize >::Load( curve_, curve_.Base(), tablePath ) )
+    {
+    }
+
+    // Base table refers to the curve of this object.
+    Gost3410( const Gost3410& ) = delete;
+    Gost3410& operator=( const Gost3410& ) = delete;
+
+    inline const CurveType& GetCurve() const noexcept
+    {
+        return curve_;
+    }
+
+    inline const FixedBaseTable< bitSize >& BaseTable() const noexcept
+    {
+        return baseTable_;
+    }
+
+    /**
+     * @brief Random private key 0 < d < q.
+     */
+    Number GeneratePrivateKey() const
+    {
+        return RandomScalar();
+    }
+
+    /**
+     * @brief Public key Q = dP.
+     *
+     * @throw std::runtime_error If d is not in range 0 < d < q.
+     */
+    PublicKey DerivePublicKey( const Number& d ) const
+    {
+        CheckScalar( d );
+        PublicKey ret;
+        curve_.ToAffine( baseTable_.Mul( d ), ret.x, ret.y );
+        return ret;
+    }
+
+    /**
+     * @brief Public key in CurveType::COMPRESSED_SIZE bytes, see Curve::Compress.
+     *
+     * @throw std::runtime_error If key is not a curve point.
+     */
+    void CompressPublicKey( const PublicKey& key, uint8_t* out ) const
+    {
+        curve_.Compress( curve_.FromAffine( key.x, key.y ), out );
+    }
+
+    /**
+     * @brief Public key from encoding made by CompressPublicKey.
+     *
+     * @throw std::runtime_error If data is not an encoding of a curve point.
+     */
+    PublicKey DecompressPublicKey( const uint8_t* data ) const
+    {
+        PublicKey ret;
+        curve_.ToAffine( curve_.Decompress( data ), ret.x, ret.y );
+        return ret;
+    }
+
+    /**
+     * @brief Sign hash with a random nonce.
+     *
+     * Signature is canonical: the nonce is k or q - k, whichever gives kP with even y. The
+     * choice does not change r and takes no branch on the secret.
+     *
+     * @param[in] alpha Hash of the message as number.
+     * @param[in] d Private key.
+     */
+    Signature Sign( const Number& alpha, const Number& d ) const
+    {
+        CheckScalar( d );
+        Signature ret;
+        while( !TrySign( alpha, d, RandomScalar(), true, ret ) )
+        {
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Sign hash with the given nonce, e.g. for known answer tests.
+     *
+     * Nonce is used as is, so the signature is canonical only if kP has even y.
+     *
+     * @throw std::runtime_error If d or k is not in range ( 0, q ), or nonce k yields zero
+     * signature component.
+     */
+    Signature Sign( const Number& alpha, const Number& d, const Number& k ) const
+    {
+        CheckScalar( d );
+        CheckScalar( k );
+        Signature ret;
+        [[unlikely]] if( !TrySign( alpha, d, k, false, ret ) )
+        {
+            throw std::runtime_error( "Nonce is not suitable" );
+        }
+        return ret;
+    }
+
+    /**
+     * @brief Verify signature of hash.
+     *
+     * @throw std::runtime_error If public key is not a point of the curve.
+     */
+    bool Verify( const Number& alpha, const Signature& signature, const PublicKey& key ) const
+    {
+        if( !InRange( signature.r ) || !InRange( signature.s ) )
+        {
+            return false;
+        }
+        typename CurveType::Point publicPoint = curve_.FromAffine( key.x, key.y );
+
+        // v = e^-1, z1 = sv, z2 = -rv, C = z1 * P + z2 * Q.
+        const auto& field = scalar_;
+        Number v = field.FromMont( field.Inverse( field.ToMont( Digest( alpha ) ) ) );
+        Number z1 = order_.Mul( signature.s, v );
+        Number z2 = order_.Sub( Number( 0 ), order_.Mul( signature.r, v ) );
+        typename CurveType::Point c =
+            curve_.Add( baseTable_.Mul( z1 ), curve_.Mul( publicPoint, z2 ) );
+        if( c.infinity )
+        {
+            return false;
+        }
+
+        Number x;
+        Number y;
+        curve_.ToAffine( c, x, y );
+        return order_.Reduce( x ) == signature.r;
+    }
+
+    /**
+     * @brief Verify several signatures at once.
+     *
+     * Signature gives only x of R = z1 * P + z2 * Q, so the sign of R is known only for
+     * canonical signatures, see Sign. With \p canonical set, for random 128-bit weights
+     * w_i, sum( w_i * ( z1_i * P + z2_i * Q_i - R_i ) ) = O is checked with one multi-scalar
+     * multiplication, where R_i is the point with x = r_i and even y. If the check fails,
+     * every item is verified individually, which identifies invalid signatures: a single
+     * valid signature with odd y of R_i makes the batch cost more than verification of
+     * each item. Without \p canonical, and on curves where R_i cannot be recovered, items
+     * are verified individually.
+     *
+     * @param[in] items Items to verify.
+     * @param[in] count Count of items.
+     * @param[out] results Result for every item. Item with a public key which is not a
+     * point of the curve fails.
+     * @param[in] canonical All signatures are known to be made by Sign with a random nonce.
+     * Result does not depend on it, only the cost.
+     *
+     * @return true If all signatures are valid.
+     */
+    bool VerifyBatch( const VerificationItem* items,
+                      size_t count,
+                      bool* results,
+                      bool canonical ) const
+    {
+        const Number& p = curve_.GetField().Modulus();
+        const Number& q = order_.Modulus();
+        std::vector< BatchEntry > entries;
+        entries.reserve( count );
+        for( size_t i = 0; i < count; ++i )
+        {
+            results[ i ] = false;
+            const Signature& signature = items[ i ].signature;
+            if( !InRange( signature.r ) || !InRange( signature.s ) )
+            {
+                continue;
+            }
+            BatchEntry entry;
+            entry.index = i;
+            try
+            {
+                entry.key = curve_.FromAffine( items[ i ].key.x, items[ i ].key.y );
+            }
+            catch( const std::runtime_error& )
+            {
+                continue;
+            }
+            // x of R is r unless r + q is below p too, then there are several candidates.
+            bool unique = curve_.Cofactor() == 1 && ( q >= p || signature.r >= p - q );
+            if( !canonical || !unique || !curve_.Lift( signature.r, false, entry.negR ) )
+            {
+                results[ i ] = Verify( items[ i ].alpha, signature, items[ i ].key );
+                continue;
+            }
+            entry.negR = curve_.Negate( entry.negR );
+            entries.push_back( entry );
+        }
+
+        // z1 = sv, z2 = -rv for v = e^-1, with a single inversion for all entries.
+        math::LongNumberArray< bitSize > inverses( entries.size() );
+        for( size_t i = 0; i < entries.size(); ++i )
+        {
+            const VerificationItem& item = items[ entries[ i ].index ];
+            inverses.Set( i, scalar_.ToMont( Digest( item.alpha ) ) );
+        }
+        scalar_.BatchInverse( inverses );
+        for( size_t i = 0; i < entries.size(); ++i )
+        {
+            const Signature& signature = items[ entries[ i ].index ].signature;
+            Number v = scalar_.FromMont( inverses.Get( i ) );
+            entries[ i ].z1 = order_.Mul( signature.s, v );
+            entries[ i ].z2 = order_.Sub( Number( 0 ), order_.Mul( signature.r, v ) );
+        }
+        VerifyEntries( items, entries.data(), entries.size(), results );
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            if( !results[ i ] )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Multiples table of peer public key for repeated key agreement.
+     *
+     * Table refers to the curve of this object and must not outlive it.
+     *
+     * @throw std::runtime_error If public key is not a point of the curve.
+     */
+    PointTable< bitSize > MakePeerTable( const PublicKey& peer ) const
+    {
+        return PointTable< bitSize >( curve_, curve_.FromAffine( peer.x, peer.y ) );
+    }
+
+    /**
+     * @brief VKO shared point K = ( cofactor * ukm * d mod q ) * Q of R 1323565.1.020-2018,
+     * computed in time independent of d.
+     *
+     * @param[in] d Own private key.
+     * @param[in] peer Public key Q of the peer.
+     * @param[in] ukm User keying material, zero is replaced by 1.
+     *
+     * @throw std::runtime_error If d is out of range, or peer key is not a point of the
+     * curve or yields point at infinity.
+     */
+    PublicKey Agree( const Number& d, const PublicKey& peer, const Number& ukm ) const
+    {
+        return Agree( d, MakePeerTable( peer ), ukm );
+    }
+
+    /**
+     * @brief VKO shared point with a cached table of the peer key, see MakePeerTable.
+     */
+    PublicKey Agree( const Number& d, const PointTable< bitSize >& peer, const Number& ukm ) const
+    {
+        CheckScalar( d );
+        Number factor = order_.Reduce( ukm );
+        if( factor.IsZero() )
+        {
+            factor = Number( 1 );
+        }
+        factor = order_.Mul( factor, order_.Reduce( Number( curve_.Cofactor() ) ) );
+
+        // Public factor in Montgomery form times d gives the ordinary product.
+        PublicKey ret;
+        curve_.ToAffine( peer.Mul( scalar_.Mul( scalar_.ToMont( factor ), d ) ), ret.x, ret.y );
+        return ret;
+    }
+
+private:
+    // e = alpha mod q, or 1 if that is zero.
+    Number Digest( const Number& alpha ) const
+    {
+        Number e = order_.Reduce( alpha );
+        if( e.IsZero() )
+        {
+            e = Number( 1 );
+        }
+        return e;
+    }
+
+    // r = x( kP ) mod q, s = ( rd + ke ) mod q. Fails if either is zero. Canonical
+    // signature uses q - k instead of k if y of kP is odd: x and r stay the same.
+    bool TrySign( const Number& alpha,
+                  const Number& d,
+                  const Number& k,
+                  bool canonical,
+                  Signature& out ) const
+    {
+        Number x;
+        Number y;
+        curve_.ToAffine( baseTable_.Mul( k ), x, y );
+        out.r = order_.Reduce( x );
+        if( out.r.IsZero() )
+        {
+            return false;
+        }
+
+        uint64_t negate = static_cast< uint64_t >( 0 )
+                          - ( static_cast< uint64_t >( canonical ) & y.Limbs()[ 0 ] & 1 );
+        Number nonce;
+        CurveType::Select( nonce, scalar_.Sub( Number( 0 ), k ), k, negate );
+
+        // Secret d and k are only multiplied by public numbers in Montgomery form, which
+        // gives ordinary products, and added in constant time.
+        out.s = scalar_.Add( scalar_.Mul( scalar_.ToMont( out.r ), d ),
+                             scalar_.Mul( scalar_.ToMont( Digest( alpha ) ), nonce ) );
+        return !out.s.IsZero();
+    }
+
+    // Prepared item of VerifyBatch.
+    struct BatchEntry
+    {
+        size_t index;
+        typename CurveType::Point key;
+        typename CurveType::Point negR;
+        Number z1;
+        Number z2;
+    };
+
+    // Count of entries verified individually without the combination.
+    static constexpr size_t BATCH_LEAF_SIZE = 2;
+
+    // Failed combination is not split in halves: a single valid signature which is not
+    // canonical after all fails every half that contains it, so bisection would cost more
+    // than verification of each entry.
+    void VerifyEntries( const VerificationItem* items,
+                        const BatchEntry* entries,
+                        size_t count,
+                        bool* results ) const
+    {
+        if( count > BATCH_LEAF_SIZE && CheckCombination( entries, count ) )
+        {
+            for( size_t i = 0; i < count; ++i )
+            {
+                results[ entries[ i ].index ] = true;
+            }
+            return;
+        }
+        for( size_t i = 0; i < count; ++i )
+        {
+            const VerificationItem& item = items[ entries[ i ].index ];
+            results[ entries[ i ].index ] = Verify( item.alpha, item.signature, item.key );
+        }
+    }
+
+    // sum( w_i * z1_i ) * P + sum( w_i * z2_i * Q_i + w_i * ( -R_i ) ) = O.
+    bool CheckCombination( const BatchEntry* entries, size_t count ) const
+    {
+        constexpr size_t WEIGHT_BYTE_SIZE = 16;
+        std::vector< typename CurveType::Point > points;
+        std::vector< Number > scalars;
+        points.reserve( 2 * count );
+        scalars.reserve( 2 * count );
+        Number baseScalar;
+        Number weight;
+        uint8_t bytes[ WEIGHT_BYTE_SIZE ];
+        for( size_t i = 0; i < count; ++i )
+        {
+            util::random::Fill( bytes, WEIGHT_BYTE_SIZE );
+            bytes[ WEIGHT_BYTE_SIZE - 1 ] |= 1;
+            weight.ImportBE( bytes, WEIGHT_BYTE_SIZE );
+
+            baseScalar = order_.Add( baseScalar, order_.Mul( weight, entries[ i ].z1 ) );
+            points.push_back( entries[ i ].key );
+            scalars.push_back( order_.Mul( weight, entries[ i ].z2 ) );
+            points.push_back( entries[ i ].negR );
+            scalars.push_back( weight );
+        }
+        typename CurveType::Point sum =
+            MultiScalarMul( curve_, points.data(), scalars.data(), points.size() );
+        if( !baseScalar.IsZero() )
+        {
+            sum = curve_.Add( sum, baseTable_.Mul( baseScalar ) );
+        }
+        return sum.infinity;
+    }
+
+    Number RandomScalar() const
+    {
+        constexpr size_t BYTE_SIZE = bitSize / 8;
+        size_t excess = bitSize - order_.Modulus().BitLength();
+        uint8_t bytes[ BYTE_SIZE ];
+        Number ret;
+        do
+        {
+            util::random::Fill( bytes, BYTE_SIZE );
+            ret.ImportBE( bytes, BYTE_SIZE );
+            ret >>= excess;
+        } while( !InRange( ret ) );
+        return ret;
+    }
+
+    inline bool InRange( const Number& value ) const
+    {
+        return !value.IsZero() && value < order_.Modulus();
+    }
+
+    void CheckScalar( const Number& value ) const
+    {
+        [[unlikely]] if( !InRange( value ) )
+        {
+            throw std::runtime_error( "Scalar is out of range" );
+        }
+    }
+
+    CurveType curve_;
+    math::BarrettContext< bitSize > order_;
+    math::MontgomeryContext< bitSize > scalar_;
+    FixedBaseTable< bitSize > baseTable_;
+};
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <core/ec/curve.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+/**
+ * @brief sum( scalars[ i ] * points[ i ] ) by Pippenger's bucket method.
+ *
+ * Scalars are split into windows of c bits. For every window, points are added to the
+ * bucket of their digit and buckets are summed with running sums, so a window costs about
+ * count + 2^( c + 1 ) additions instead of count multiplications. Window size grows with
+ * count. Running time depends on scalars, use only for public values.
+ *
+ * @param[in] curve Curve.
+ * @param[in] points Points in affine form of the curve model.
+ * @param[in] scalars Scalars, any values below 2^bitSize.
+ * @param[in] count Count of points and scalars.
+ */
+template < size_t bitSize >
+typename Curve< bitSize >::Point MultiScalarMul( const Curve< bitSize >& curve,
+                                                 const typename Curve< bitSize >::Point* points,
+                                                 const math::LongNumber< bitSize >* scalars,
+                                                 size_t count )
+{
+    using Projective = typename Curve< bitSize >::Projective;
+    constexpr size_t WORD_BIT_SIZE = 64;
+    constexpr size_t MAX_WINDOW_BIT_SIZE = 12;
+
+    size_t bits = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+        size_t length = scalars[ i ].BitLength();
+        bits = length > bits ? length : bits;
+    }
+    size_t windowBitSize = 2;
+    while( windowBitSize < MAX_WINDOW_BIT_SIZE && ( size_t( 4 ) << windowBitSize ) < count )
+    {
+        ++windowBitSize;
+    }
+    size_t windows = ( bits + windowBitSize - 1 ) / windowBitSize;
+    uint64_t digitMask = ( uint64_t( 1 ) << windowBitSize ) - 1;
+
+    auto digit = [ & ]( const math::LongNumber< bitSize >& scalar, size_t bit ) -> uint64_t {
+        const uint64_t* limbs = scalar.Limbs();
+        size_t word = bit / WORD_BIT_SIZE;
+        size_t shift = bit % WORD_BIT_SIZE;
+        uint64_t value = limbs[ word ] >> shift;
+        if( shift + windowBitSize > WORD_BIT_SIZE
+            && word + 1 < math::LongNumber< bitSize >::LIMB_COUNT )
+        {
+            value |= limbs[ word + 1 ] << ( WORD_BIT_SIZE - shift );
+        }
+        return value & digitMask;
+    };
+
+    std::vector< Projective > buckets( digitMask + 1 );
+    Projective acc = curve.Neutral();
+    Projective running;
+    Projective windowSum;
+    for( size_t w = windows; w > 0; --w )
+    {
+        for( size_t i = 0; i < windowBitSize; ++i )
+        {
+            curve.Double( acc, acc );
+        }
+        for( auto& bucket: buckets )
+        {
+            bucket = curve.Neutral();
+        }
+        for( size_t i = 0; i < count; ++i )
+        {
+            uint64_t value = digit( scalars[ i ], ( w - 1 ) * windowBitSize );
+            if( value != 0 )
+            {
+                curve.AddMixed( buckets[ value ], buckets[ value ], points[ i ] );
+            }
+        }
+
+        // sum( j * bucket[ j ] ) = sum over j of running sums of buckets from the top.
+        running = curve.Neutral();
+        windowSum = curve.Neutral();
+        for( size_t j = digitMask; j > 0; --j )
+        {
+            curve.Add( running, running, buckets[ j ] );
+            curve.Add( windowSum, windowSum, running );
+        }
+        curve.Add( acc, acc, windowSum );
+    }
+    return curve.Normalize( acc );
+}
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+/**
+ * @brief Parameters of curve y^2 = x^3 + ax + b over prime field with cyclic subgroup of
+ * prime order q generated by point ( x, y ). Values are big-endian hex strings.
+ *
+ * Curves birationally equivalent to twisted Edwards curve eu^2 + v^2 = 1 + du^2v^2 also
+ * carry e and d, which are null otherwise.
+ */
+struct CurveParams
+{
+    const char* name;
+    size_t bitSize;
+    const char* p;
+    const char* a;
+    const char* b;
+    const char* q;
+    const char* x;
+    const char* y;
+    unsigned cofactor;
+    const char* e = nullptr;
+    const char* d = nullptr;
+};
+
+/**
+ * @brief Curve of the example in GOST R 34.10-2012, appendix A.1.
+ */
+const CurveParams& GostTestParamSet256() noexcept;
+
+const CurveParams& Tc26ParamSet256A() noexcept;
+const CurveParams& Tc26ParamSet256B() noexcept;
+const CurveParams& Tc26ParamSet256C() noexcept;
+const CurveParams& Tc26ParamSet256D() noexcept;
+const CurveParams& Tc26ParamSet512A() noexcept;
+const CurveParams& Tc26ParamSet512B() noexcept;
+const CurveParams& Tc26ParamSet512C() noexcept;
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
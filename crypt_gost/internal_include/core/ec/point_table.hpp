@@ -0,0 +1,156 @@
+#pragma once
+
+#include <core/ec/curve.hpp>
+#include <core/math/number_array.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace ec
+{
+
+/**
+ * @brief Odd multiples of a variable point for constant-time scalar multiplication.
+ *
+ * Scalar is recoded into signed odd digits of WINDOW_BIT_SIZE bits, none of them zero, so
+ * every window costs the same doublings and one addition of a table entry. Entries are
+ * read with a full scan of the table and negated without branches. Building the table
+ * costs about 2^( WINDOW_BIT_SIZE - 1 ) additions and one inversion, an object may be kept
+ * to reuse the table for the same point, e.g. for repeated key agreement with one peer.
+ */
+template < size_t bitSize >
+class PointTable final
+{
+public:
+    using CurveType = Curve< bitSize >;
+    using Number = typename CurveType::Number;
+    using Point = typename CurveType::Point;
+    using Projective = typename CurveType::Projective;
+
+    static constexpr size_t WINDOW_BIT_SIZE = 5;
+    static constexpr size_t TABLE_SIZE = 1 << ( WINDOW_BIT_SIZE - 1 );
+
+    /**
+     * @brief Build table of ( 2j + 1 ) * point for j = 0..TABLE_SIZE - 1.
+     *
+     * @param[in] curve Curve, must outlive the table.
+     * @param[in] point Finite point of order q.
+     *
+     * @throw std::runtime_error If point is at infinity.
+     */
+    PointTable( const CurveType& curve, const Point& point )
+        : curve_( curve )
+        , x_( TABLE_SIZE )
+        , y_( TABLE_SIZE )
+    {
+        [[unlikely]] if( point.infinity )
+        {
+            throw std::runtime_error( "Point at infinity has no multiples table" );
+        }
+        Projective multiples[ TABLE_SIZE ];
+        Point entries[ TABLE_SIZE ];
+        Projective twice;
+        multiples[ 0 ] = curve_.ToProjective( point );
+        curve_.Double( twice, multiples[ 0 ] );
+        for( size_t j = 1; j < TABLE_SIZE; ++j )
+        {
+            curve_.Add( multiples[ j ], multiples[ j - 1 ], twice );
+        }
+        curve_.NormalizeBatch( multiples, entries, TABLE_SIZE );
+        for( size_t j = 0; j < TABLE_SIZE; ++j )
+        {
+            x_.Set( j, entries[ j ].x );
+            y_.Set( j, entries[ j ].y );
+        }
+    }
+
+    /**
+     * @brief k * point in time independent of k.
+     *
+     * @throw std::runtime_error If k is not in range 0 < k < q.
+     */
+    Point Mul( const Number& k ) const
+    {
+        constexpr size_t DIGITS = ( bitSize + WINDOW_BIT_SIZE - 1 ) / WINDOW_BIT_SIZE;
+        constexpr uint64_t WINDOW_MASK = ( uint64_t( 1 ) << ( WINDOW_BIT_SIZE + 1 ) ) - 1;
+        const Number& q = curve_.Order();
+        [[unlikely]] if( k.IsZero() || k >= q )
+        {
+            throw std::runtime_error( "Scalar is out of range" );
+        }
+
+        // Recoding needs an odd scalar: even k is replaced by odd q - k, and the result
+        // is negated.
+        uint64_t even = static_cast< uint64_t >( 0 ) - ( ( k.Limbs()[ 0 ] & 1 ) ^ 1 );
+        Number scalar;
+        CurveType::Select( scalar, q - k, k, even );
+
+        // Digit d = ( t mod 2^( w + 1 ) ) - 2^w is odd, and t = ( t - d ) / 2^w stays odd.
+        // The last digit is the remaining positive t.
+        int64_t digits[ DIGITS ];
+        uint64_t t[ Number::LIMB_COUNT ];
+        std::memcpy( t, scalar.Limbs(), sizeof( t ) );
+        for( size_t i = 0; i + 1 < DIGITS; ++i )
+        {
+            uint64_t window = t[ 0 ] & WINDOW_MASK;
+            digits[ i ] = static_cast< int64_t >( window ) - ( int64_t( 1 ) << WINDOW_BIT_SIZE );
+            math::kernel::ShiftRight( t, t, Number::LIMB_COUNT, WINDOW_BIT_SIZE );
+            t[ 0 ] |= 1;
+        }
+        digits[ DIGITS - 1 ] = static_cast< int64_t >( t[ 0 ] );
+
+        Point entry;
+        Select( entry, digits[ DIGITS - 1 ] );
+        Projective acc = curve_.ToProjective( entry );
+        for( size_t i = DIGITS - 1; i > 0; --i )
+        {
+            for( size_t j = 0; j < WINDOW_BIT_SIZE; ++j )
+            {
+                curve_.Double( acc, acc );
+            }
+            Select( entry, digits[ i - 1 ] );
+            curve_.AddMixed( acc, acc, entry );
+        }
+
+        Point ret = curve_.Normalize( acc );
+        curve_.NegateIf( ret, even );
+        return ret;
+    }
+
+private:
+    // entry = |digit| * point, negated for negative digit.
+    void Select( Point& entry, int64_t digit ) const
+    {
+        uint64_t negative = static_cast< uint64_t >( digit >> 63 );
+        uint64_t magnitude = ( static_cast< uint64_t >( digit ) ^ negative ) - negative;
+        uint64_t index = magnitude >> 1;
+        uint64_t x[ Number::LIMB_COUNT ] = {};
+        uint64_t y[ Number::LIMB_COUNT ] = {};
+        for( size_t j = 0; j < TABLE_SIZE; ++j )
+        {
+            uint64_t mask = static_cast< uint64_t >( 0 ) - static_cast< uint64_t >( index == j );
+            for( size_t l = 0; l < Number::LIMB_COUNT; ++l )
+            {
+                x[ l ] |= x_.Limb( j, l ) & mask;
+                y[ l ] |= y_.Limb( j, l ) & mask;
+            }
+        }
+        entry.x.AssignLimbs( x );
+        entry.y.AssignLimbs( y );
+        entry.infinity = false;
+        curve_.NegateIf( entry, negative );
+    }
+
+    const CurveType& curve_;
+    math::LongNumberArray< bitSize > x_;
+    math::LongNumberArray< bitSize > y_;
+};
+
+} // namespace ec
+
+} // namespace core
+
+} // namespace crypt_gost
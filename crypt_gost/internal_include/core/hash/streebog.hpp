@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/util/segment.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace hash
+{
+
+/**
+ * @brief Streebog hash function, GOST R 34.11-2012, with 256-bit or 512-bit digest.
+ *
+ * Message and digest are byte strings with the least significant byte of the standard's
+ * vectors first, as produced by common implementations.
+ *
+ * Transformation L( P( S( x ) ) ) of the compression function is computed with eight lookup
+ * tables of 256 words: word j of the result is XOR of entries selected by byte j of every
+ * word of x.
+ *
+ * A message is hashed by any number of Update calls and Final, which also starts the next
+ * message. Construction and Init start a message as well.
+ */
+class Streebog final
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t DIGEST_SIZE_256 = 32;
+    static constexpr size_t DIGEST_SIZE_512 = 64;
+
+    /**
+     * @brief Message for DigestMany.
+     */
+    struct Message
+    {
+        const uint8_t* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] digestSize DIGEST_SIZE_256 or DIGEST_SIZE_512.
+     *
+     * @throw std::runtime_error If digest size is not supported.
+     */
+    explicit Streebog( size_t digestSize = DIGEST_SIZE_512 );
+
+    ~Streebog() noexcept;
+
+    /**
+     * @brief Digest size in bytes.
+     */
+    size_t GetDigestSize() const noexcept;
+
+    /**
+     * @brief Start new message.
+     */
+    void Init() noexcept;
+
+    /**
+     * @brief Hash next \p size bytes of the message.
+     *
+     * Whole blocks are compressed directly from \p data, only the bytes which do not
+     * complete a block are kept until the next call.
+     */
+    void Update( const uint8_t* data, size_t size ) noexcept;
+
+    /**
+     * @brief Hash next \p count segments of the message.
+     *
+     * A block split between segments is collected in the buffer, as between Update calls.
+     */
+    void Update( const util::ConstSegment* segments, size_t count ) noexcept;
+
+    /**
+     * @brief Finish message and start the next one.
+     *
+     * @param[out] digest GetDigestSize() bytes.
+     */
+    void Final( uint8_t* digest ) noexcept;
+
+    /**
+     * @brief Hash independent messages.
+     *
+     * Compressions of several messages run together in vector lanes, a lane which finishes
+     * its message continues with the next one, so short messages of different lengths are
+     * hashed at the throughput of the vector kernel.
+     *
+     * @param[in] digestSize DIGEST_SIZE_256 or DIGEST_SIZE_512.
+     * @param[in] messages Messages.
+     * @param[in] count Number of messages.
+     * @param[out] digests \p count digests of \p digestSize bytes, in the order of messages.
+     *
+     * @throw std::runtime_error If digest size is not supported.
+     */
+    static void DigestMany( size_t digestSize,
+                            const Message* messages,
+                            size_t count,
+                            uint8_t* digests );
+
+private:
+    void Compress( const uint8_t* block ) noexcept;
+
+    uint64_t h_[ 8 ];
+    uint64_t length_[ 8 ];
+    uint64_t sum_[ 8 ];
+    uint8_t buffer_[ BLOCK_SIZE ];
+    size_t bufferSize_;
+    size_t digestSize_;
+};
+
+} // namespace hash
+
+} // namespace core
+
+} // namespace crypt_gost
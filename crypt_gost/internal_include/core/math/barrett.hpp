@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stdexcept>
+#include <core/math/math.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Barrett reduction context for a fixed modulus.
+ *
+ * Modulus q of bit length s is used together with precomputed mu = floor( 4^s / q ),
+ * so that a value below q^2 is reduced with two multiplications and at most three
+ * subtractions. Unlike Montgomery reduction, operands and results stay in ordinary form,
+ * which suits scalar arithmetic modulo a curve subgroup order of no special form.
+ *
+ * Since q < 2^s, mu lies in ( 2^s, 2^(s + 1) ) and is stored as mu - 2^s to keep
+ * all intermediate products within 2 * bitSize bits.
+ */
+template < size_t bitSize, typename T = uint64_t >
+class BarrettContext final
+{
+public:
+    using Number = LongNumber< bitSize, T >;
+    using WideNumber = LongNumber< 2 * bitSize, T >;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] modulus Modulus. Must not be a power of two and must be longer than
+     * bitSize / 2 bits, so that any single-width number can be reduced.
+     */
+    explicit BarrettContext( const Number& modulus )
+        : modulus_( modulus )
+        , wideModulus_( modulus )
+        , muLow_()
+        , shift_( modulus.BitLength() )
+    {
+        [[unlikely]] if( 2 * shift_ < bitSize || modulus == ( Number( 1 ) << ( shift_ - 1 ) ) )
+        {
+            throw std::runtime_error( "Unsupported Barrett modulus" );
+        }
+
+        // Long division of 2^(2s) by q. The quotient bit at position s is always set and
+        // is dropped, the remaining s bits form mu - 2^s.
+        WideNumber remainder = 1;
+        WideNumber one = 1;
+        remainder <<= shift_;
+        remainder -= wideModulus_;
+        for( size_t i = 0; i < shift_; ++i )
+        {
+            remainder <<= 1;
+            muLow_ <<= 1;
+            if( remainder >= wideModulus_ )
+            {
+                remainder -= wideModulus_;
+                muLow_ += one;
+            }
+        }
+    }
+
+    inline const Number& Modulus() const noexcept
+    {
+        return modulus_;
+    }
+
+    /**
+     * @brief Reduce double-width value.
+     *
+     * @param[in] value Value to reduce, must be less than q^2.
+     *
+     * @return Number value mod q.
+     */
+    Number Reduce( const WideNumber& value ) const
+    {
+        // quotient = floor( floor( x / 2^s ) * mu / 2^s ) underestimates floor( x / q )
+        // by at most 3.
+        WideNumber high = value >> shift_;
+        WideNumber quotient = high * muLow_;
+        quotient >>= shift_;
+        quotient += high;
+
+        WideNumber remainder = value - quotient * wideModulus_;
+        while( remainder >= wideModulus_ )
+        {
+            remainder -= wideModulus_;
+        }
+        return Number( remainder );
+    }
+
+    /**
+     * @brief Reduce single-width value, e.g. a hash interpreted as a number.
+     *
+     * @param[in] value Value to reduce.
+     *
+     * @return Number value mod q.
+     */
+    Number Reduce( const Number& value ) const
+    {
+        return Reduce( WideNumber( value ) );
+    }
+
+    /**
+     * @brief Modular addition of reduced operands.
+     */
+    Number Add( const Number& a, const Number& b ) const
+    {
+        Number sum = a + b;
+        // Sum may wrap around 2^bitSize when the modulus occupies the top bit.
+        if( sum < a || sum >= modulus_ )
+        {
+            sum -= modulus_;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Modular subtraction of reduced operands.
+     */
+    Number Sub( const Number& a, const Number& b ) const
+    {
+        Number diff = a - b;
+        if( a < b )
+        {
+            diff += modulus_;
+        }
+        return diff;
+    }
+
+    /**
+     * @brief Modular multiplication of reduced operands.
+     */
+    Number Mul( const Number& a, const Number& b ) const
+    {
+        return Reduce( WideNumber( a ) * WideNumber( b ) );
+    }
+
+    /**
+     * @brief Compute ( a * b + c * d ) mod q for reduced operands,
+     * e.g. signature component s = ( rd + ke ) mod q.
+     */
+    Number MulAdd( const Number& a, const Number& b, const Number& c, const Number& d ) const
+    {
+        return Add( Mul( a, b ), Mul( c, d ) );
+    }
+
+private:
+    Number modulus_;
+    WideNumber wideModulus_;
+    WideNumber muLow_;
+    size_t shift_;
+};
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cpu/dispatch.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+namespace kernel
+{
+
+/**
+ * @brief Arithmetic on several independent numbers at once.
+ *
+ * Numbers are split into 52-bit limbs, each held in a 64-bit word, and stored lane-
+ * interleaved: limb j of lane l is at index j * lanes + l. The 12 spare bits of every word
+ * absorb carries, which are propagated once at the end of an operation, and 52-bit limbs
+ * match the operand width of AVX-512 IFMA multiply-add instructions.
+ *
+ * Lane count must be a multiple of 4. Output may alias inputs.
+ */
+namespace batch
+{
+
+constexpr size_t RADIX_BIT_SIZE = 52;
+constexpr uint64_t RADIX_MASK = ( 1ull << RADIX_BIT_SIZE ) - 1;
+constexpr size_t MAX_LIMBS = 20;
+
+/**
+ * @brief r = a * b mod 2^( 52 * limbs ) in every lane.
+ */
+using MulFn = void ( * )( uint64_t* r,
+                          const uint64_t* a,
+                          const uint64_t* b,
+                          size_t limbs,
+                          size_t lanes );
+
+/**
+ * @brief r = a * b / 2^( 52 * limbs ) mod p in every lane.
+ *
+ * p is given as \p limbs 52-bit limbs shared by all lanes, pInv = -p^-1 mod 2^52.
+ * Operands must be less than p.
+ */
+using MontMulFn = void ( * )( uint64_t* r,
+                              const uint64_t* a,
+                              const uint64_t* b,
+                              const uint64_t* p,
+                              uint64_t pInv,
+                              size_t limbs,
+                              size_t lanes );
+
+/**
+ * @brief Split 64-bit words into 52-bit limbs.
+ *
+ * @param[out] limbs Limbs, limb j is written at index j * stride.
+ * @param[in] limbCount Count of limbs, 52 * limbCount must cover wordCount words.
+ * @param[in] stride Distance between limbs, i.e. lane count.
+ * @param[in] words Words, least significant first.
+ * @param[in] wordCount Count of words.
+ */
+inline void ImportWords( uint64_t* limbs,
+                         size_t limbCount,
+                         size_t stride,
+                         const uint64_t* words,
+                         size_t wordCount ) noexcept
+{
+    for( size_t j = 0; j < limbCount; ++j )
+    {
+        size_t word = j * RADIX_BIT_SIZE / 64;
+        size_t shift = j * RADIX_BIT_SIZE % 64;
+        uint64_t limb = word < wordCount ? words[ word ] >> shift : 0;
+        if( shift > 64 - RADIX_BIT_SIZE && word + 1 < wordCount )
+        {
+            limb |= words[ word + 1 ] << ( 64 - shift );
+        }
+        limbs[ j * stride ] = limb & RADIX_MASK;
+    }
+}
+
+/**
+ * @brief Join 52-bit limbs into 64-bit words, bits beyond wordCount words are dropped.
+ */
+inline void ExportWords( uint64_t* words,
+                         size_t wordCount,
+                         const uint64_t* limbs,
+                         size_t limbCount,
+                         size_t stride ) noexcept
+{
+    for( size_t i = 0; i < wordCount; ++i )
+    {
+        words[ i ] = 0;
+    }
+    for( size_t j = 0; j < limbCount; ++j )
+    {
+        size_t word = j * RADIX_BIT_SIZE / 64;
+        size_t shift = j * RADIX_BIT_SIZE % 64;
+        uint64_t limb = limbs[ j * stride ];
+        if( word < wordCount )
+        {
+            words[ word ] |= limb << shift;
+        }
+        if( shift > 64 - RADIX_BIT_SIZE && word + 1 < wordCount )
+        {
+            words[ word + 1 ] |= limb >> ( 64 - shift );
+        }
+    }
+}
+
+namespace generic
+{
+
+void Mul( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t limbs, size_t lanes ) noexcept;
+
+void MontMul( uint64_t* r,
+              const uint64_t* a,
+              const uint64_t* b,
+              const uint64_t* p,
+              uint64_t pInv,
+              size_t limbs,
+              size_t lanes ) noexcept;
+
+} // namespace generic
+
+cpu::Dispatcher< MulFn >& MulDispatcher() noexcept;
+cpu::Dispatcher< MontMulFn >& MontMulDispatcher() noexcept;
+
+inline void Mul( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t limbs, size_t lanes )
+{
+    MulDispatcher().Get()( r, a, b, limbs, lanes );
+}
+
+inline void MontMul( uint64_t* r,
+                     const uint64_t* a,
+                     const uint64_t* b,
+                     const uint64_t* p,
+                     uint64_t pInv,
+                     size_t limbs,
+                     size_t lanes )
+{
+    MontMulDispatcher().Get()( r, a, b, p, pInv, limbs, lanes );
+}
+
+} // namespace batch
+
+} // namespace kernel
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/cpu/dispatch.hpp>
+#include <core/util/traits.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Low-level arithmetic on arrays of words.
+ *
+ * Arrays are stored least significant word first, as in LongNumber. Output may alias
+ * inputs. Operations on 64-bit words are dispatched at runtime to the best kernel for
+ * the processor, other word types use the portable implementation.
+ */
+namespace kernel
+{
+
+namespace generic
+{
+
+/**
+ * @brief r = a + b.
+ *
+ * @return T Carry out.
+ */
+template < typename T >
+T Add( T* r, const T* a, const T* b, size_t n ) noexcept
+{
+    T carry = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        T sum = a[ i ] + carry;
+        carry = sum < carry;
+        T res = sum + b[ i ];
+        carry += res < sum;
+        r[ i ] = res;
+    }
+    return carry;
+}
+
+/**
+ * @brief r = a - b.
+ *
+ * @return T Borrow out.
+ */
+template < typename T >
+T Sub( T* r, const T* a, const T* b, size_t n ) noexcept
+{
+    T borrow = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        T diff = a[ i ] - b[ i ];
+        T borrowNext = a[ i ] < b[ i ];
+        borrowNext |= diff < borrow;
+        r[ i ] = diff - borrow;
+        borrow = borrowNext;
+    }
+    return borrow;
+}
+
+/**
+ * @brief r = a << shift, shift < n * bits of T.
+ */
+template < typename T >
+void ShiftLeft( T* r, const T* a, size_t n, size_t shift ) noexcept
+{
+    constexpr size_t WORD_BIT_SIZE = util::traits::BitsNumberOf< T >();
+    size_t words = shift / WORD_BIT_SIZE;
+    size_t bits = shift % WORD_BIT_SIZE;
+
+    if( bits == 0 )
+    {
+        for( size_t i = n - 1; i >= words + 1; --i )
+        {
+            r[ i ] = a[ i - words ];
+        }
+    }
+    else
+    {
+        for( size_t i = n - 1; i >= words + 1; --i )
+        {
+            r[ i ] = ( a[ i - words ] << bits )
+                     | ( a[ i - words - 1 ] >> ( WORD_BIT_SIZE - bits ) );
+        }
+    }
+    r[ words ] = a[ 0 ] << bits;
+    for( size_t i = 0; i < words; ++i )
+    {
+        r[ i ] = 0;
+    }
+}
+
+/**
+ * @brief r = a >> shift, shift < n * bits of T.
+ */
+template < typename T >
+void ShiftRight( T* r, const T* a, size_t n, size_t shift ) noexcept
+{
+    constexpr size_t WORD_BIT_SIZE = util::traits::BitsNumberOf< T >();
+    size_t words = shift / WORD_BIT_SIZE;
+    size_t bits = shift % WORD_BIT_SIZE;
+    size_t last = n - words - 1;
+
+    if( bits == 0 )
+    {
+        for( size_t i = 0; i <= last; ++i )
+        {
+            r[ i ] = a[ i + words ];
+        }
+    }
+    else
+    {
+        for( size_t i = 0; i < last; ++i )
+        {
+            r[ i ] = ( a[ i + words ] >> bits )
+                     | ( a[ i + words + 1 ] << ( WORD_BIT_SIZE - bits ) );
+        }
+        r[ last ] = a[ n - 1 ] >> bits;
+    }
+    for( size_t i = last + 1; i < n; ++i )
+    {
+        r[ i ] = 0;
+    }
+}
+
+/**
+ * @brief r = r + a * b.
+ *
+ * @return T Carry out word.
+ */
+template < typename T >
+T AddMul1( T* r, const T* a, size_t n, T b ) noexcept
+{
+    using DoubleT = util::traits::DoubleWidth_t< T >;
+    T carry = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+        DoubleT acc = static_cast< DoubleT >( a[ i ] ) * b + r[ i ] + carry;
+        r[ i ] = static_cast< T >( acc );
+        carry = static_cast< T >( acc >> util::traits::BitsNumberOf< T >() );
+    }
+    return carry;
+}
+
+} // namespace generic
+
+using AddFn = uint64_t ( * )( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n );
+using SubFn = uint64_t ( * )( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n );
+using ShiftFn = void ( * )( uint64_t* r, const uint64_t* a, size_t n, size_t shift );
+using AddMul1Fn = uint64_t ( * )( uint64_t* r, const uint64_t* a, size_t n, uint64_t b );
+
+cpu::Dispatcher< AddFn >& AddDispatcher() noexcept;
+cpu::Dispatcher< SubFn >& SubDispatcher() noexcept;
+cpu::Dispatcher< ShiftFn >& ShiftLeftDispatcher() noexcept;
+cpu::Dispatcher< ShiftFn >& ShiftRightDispatcher() noexcept;
+cpu::Dispatcher< AddMul1Fn >& AddMul1Dispatcher() noexcept;
+
+template < typename T >
+inline T Add( T* r, const T* a, const T* b, size_t n ) noexcept
+{
+    return generic::Add( r, a, b, n );
+}
+
+inline uint64_t Add( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept
+{
+    return AddDispatcher().Get()( r, a, b, n );
+}
+
+template < typename T >
+inline T Sub( T* r, const T* a, const T* b, size_t n ) noexcept
+{
+    return generic::Sub( r, a, b, n );
+}
+
+inline uint64_t Sub( uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n ) noexcept
+{
+    return SubDispatcher().Get()( r, a, b, n );
+}
+
+template < typename T >
+inline void ShiftLeft( T* r, const T* a, size_t n, size_t shift ) noexcept
+{
+    generic::ShiftLeft( r, a, n, shift );
+}
+
+inline void ShiftLeft( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept
+{
+    ShiftLeftDispatcher().Get()( r, a, n, shift );
+}
+
+template < typename T >
+inline void ShiftRight( T* r, const T* a, size_t n, size_t shift ) noexcept
+{
+    generic::ShiftRight( r, a, n, shift );
+}
+
+inline void ShiftRight( uint64_t* r, const uint64_t* a, size_t n, size_t shift ) noexcept
+{
+    ShiftRightDispatcher().Get()( r, a, n, shift );
+}
+
+template < typename T >
+inline T AddMul1( T* r, const T* a, size_t n, T b ) noexcept
+{
+    return generic::AddMul1( r, a, n, b );
+}
+
+inline uint64_t AddMul1( uint64_t* r, const uint64_t* a, size_t n, uint64_t b ) noexcept
+{
+    return AddMul1Dispatcher().Get()( r, a, n, b );
+}
+
+} // namespace kernel
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <iostream>
 #include <functional>
-#include <iomanip>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <string_view>
 #include <core/allocator/heap_allocator.hpp>
 #include <core/util/mem_buf.hpp>
+#include <core/util/hex.hpp>
+#include <core/math/kernel.hpp>
 
 #include <core/util/traits.hpp>
 
@@ -25,36 +29,45 @@ using namespace crypt_gost::core::allocator;
 using namespace crypt_gost::core::util;
 using namespace crypt_gost::core;
 
+// Conversion of a word between host byte order and big-/little-endian byte order.
 #ifdef CRYPT_GOST_HAS_BYTE_ORDERING
 #    ifdef CRYPT_GOST_LITTLE_ENDIAN
-#        define BYTE_SWAP( x ) traits::ChangeByteOrdering( ( x ) )
+#        define BIG_ENDIAN_SWAP( x )    traits::ChangeByteOrdering( ( x ) )
+#        define LITTLE_ENDIAN_SWAP( x ) ( x )
 #    elif defined( CRYPT_GOST_BIG_ENDIAN )
-#        define BYTE_SWAP( x ) ( x )
+#        define BIG_ENDIAN_SWAP( x )    ( x )
+#        define LITTLE_ENDIAN_SWAP( x ) traits::ChangeByteOrdering( ( x ) )
 #    endif
 #else
 static const bool IS_LITTLE_ENDIAN = traits::IsLittleEndian();
-#    define BYTE_SWAP( x ) ( IS_LITTLE_ENDIAN ? traits::ChangeByteOrdering( ( x ) ) : ( x ) )
+#    define BIG_ENDIAN_SWAP( x ) ( IS_LITTLE_ENDIAN ? traits::ChangeByteOrdering( ( x ) ) : ( x ) )
+#    define LITTLE_ENDIAN_SWAP( x ) \
+        ( IS_LITTLE_ENDIAN ? ( x ) : traits::ChangeByteOrdering( ( x ) ) )
 #endif
 
 namespace sfinae
 {
 
-constexpr bool IsPowerOfTwo( const size_t value )
+/**
+ * @brief Whether number of \p bitSize bits consists of a whole count of words of type \p T.
+ */
+template < size_t bitSize, typename T >
+struct is_word_multiple
 {
-    return ( value & ( value - 1 ) ) == 0;
-}
-
-template < size_t number >
-struct is_power_of_two
-{
-    static const bool value = IsPowerOfTwo( number );
+    static const bool value = bitSize > 0 && bitSize % ( sizeof( T ) * 8 ) == 0;
 };
 
 } // namespace sfinae
 
+/**
+ * @brief Unsigned integer of fixed bit size.
+ *
+ * Words are stored in native byte order, least significant word first. Byte
+ * representations are converted explicitly with Import and Export functions.
+ */
 template < size_t bitSize,
            typename T = uint64_t,
-           std::enable_if_t< sfinae::is_power_of_two< bitSize >::value, bool > = true,
+           std::enable_if_t< sfinae::is_word_multiple< bitSize, T >::value, bool > = true,
            std::enable_if_t< std::is_integral< T >::value, bool > = true,
            std::enable_if_t< std::is_unsigned< T >::value, bool > = true >
 class LongNumber final
@@ -73,11 +86,7 @@ public:
             throw std::runtime_error( "Invalid byte sequence size" );
         }
 
-        std::memcpy( bytes_.byte, bytes.begin(), bitSize / 8 );
-        if( !CheckIsZero() )
-        {
-            ByteSwap();
-        }
+        ImportBE( bytes.begin(), bytes.size() );
     };
 
     LongNumber( T value = 0, I_Allocator& alloc = HeapAllocator::GetInstance() )
@@ -87,9 +96,31 @@ public:
     {
         bytes_.byte = static_cast< uint8_t* >( buf_.GetBuf() );
         memset( buf_.GetBuf(), 0, bitSize / 8 );
-        bytes_.word[ traits_.COUNT_OF_WORDS - 1 ] = value;
+        bytes_.word[ 0 ] = value;
     };
 
+    /**
+     * @brief Construct number of another bit size.
+     *
+     * Value is zero-extended when \p other is narrower and truncated to the least
+     * significant \p bitSize bits when it is wider.
+     */
+    template < size_t otherBitSize >
+    explicit LongNumber( const LongNumber< otherBitSize, T >& other,
+                         I_Allocator& alloc = HeapAllocator::GetInstance() )
+        : bytes_()
+        , buf_( bitSize / 8, 8, alloc )
+        , isZero_( true )
+    {
+        constexpr size_t otherWords = otherBitSize / traits::BitsNumberOf< T >();
+        constexpr size_t count = std::min( traits_.COUNT_OF_WORDS, otherWords );
+
+        bytes_.byte = static_cast< uint8_t* >( buf_.GetBuf() );
+        memset( buf_.GetBuf(), 0, bitSize / 8 );
+        std::memcpy( bytes_.word, other.bytes_.word, count * sizeof( T ) );
+        CheckIsZero();
+    }
+
     ~LongNumber() = default;
 
     LongNumber( const LongNumber& other )
@@ -128,6 +159,38 @@ public:
         return 0 == std::memcmp( bytes_.byte, other.bytes_.byte, bitSize / 8 );
     }
 
+    bool operator!=( const LongNumber& other ) const noexcept
+    {
+        return !( *this == other );
+    }
+
+    bool operator<( const LongNumber& other ) const noexcept
+    {
+        for( size_t i = traits_.COUNT_OF_WORDS; i > 0; --i )
+        {
+            if( bytes_.word[ i - 1 ] != other.bytes_.word[ i - 1 ] )
+            {
+                return bytes_.word[ i - 1 ] < other.bytes_.word[ i - 1 ];
+            }
+        }
+        return false;
+    }
+
+    bool operator>( const LongNumber& other ) const noexcept
+    {
+        return other < *this;
+    }
+
+    bool operator<=( const LongNumber& other ) const noexcept
+    {
+        return !( other < *this );
+    }
+
+    bool operator>=( const LongNumber& other ) const noexcept
+    {
+        return !( *this < other );
+    }
+
     LongNumber& operator+=( const LongNumber& other ) noexcept
     {
         if( other.isZero_ )
@@ -135,178 +198,464 @@ public:
             return *this;
         }
 
-        bool carry = false;
-        for( size_t i = traits_.COUNT_OF_WORDS - 1; i != std::numeric_limits< size_t >::max(); --i )
+        kernel::Add( bytes_.word, bytes_.word, other.bytes_.word, traits_.COUNT_OF_WORDS );
+        CheckIsZero();
+        return *this;
+    }
+
+    // Binary operators have overloads for rvalue operands, which reuse the buffer of an
+    // expiring operand instead of allocating a new one, so that in an expression like
+    // a ^ b ^ c + d only the innermost temporaries allocate.
+    LongNumber operator+( const LongNumber& other ) const&
+    {
+        LongNumber ret( *this );
+        ret += other;
+        return ret;
+    }
+
+    LongNumber operator+( const LongNumber& other ) &&
+    {
+        *this += other;
+        return std::move( *this );
+    }
+
+    LongNumber operator+( LongNumber&& other ) const&
+    {
+        other += *this;
+        return std::move( other );
+    }
+
+    LongNumber operator+( LongNumber&& other ) &&
+    {
+        *this += other;
+        return std::move( *this );
+    }
+
+    /**
+     * @brief Subtraction modulo 2^bitSize.
+     */
+    LongNumber& operator-=( const LongNumber& other ) noexcept
+    {
+        if( other.isZero_ )
         {
-            T a = bytes_.word[ i ];
-            T b = other.bytes_.word[ i ];
-            T res = a + b;
-            bool carryNext = res < a;
-            res += carry;
-            if( res == 0 && carry )
-            {
-                carryNext = true;
-            }
-            bytes_.word[ i ] = res;
-            carry = carryNext;
+            return *this;
         }
+
+        kernel::Sub( bytes_.word, bytes_.word, other.bytes_.word, traits_.COUNT_OF_WORDS );
         CheckIsZero();
         return *this;
     }
 
-    LongNumber operator+( const LongNumber& other ) const
+    LongNumber operator-( const LongNumber& other ) const&
     {
         LongNumber ret( *this );
-        ret += other;
+        ret -= other;
         return ret;
     }
 
+    LongNumber operator-( const LongNumber& other ) &&
+    {
+        *this -= other;
+        return std::move( *this );
+    }
+
     LongNumber& operator^=( const LongNumber& other ) noexcept
     {
         for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
         {
             bytes_.word[ i ] ^= other.bytes_.word[ i ];
         }
+        CheckIsZero();
         return *this;
     }
 
-    LongNumber operator^( const LongNumber& other ) const
+    LongNumber operator^( const LongNumber& other ) const&
     {
         LongNumber ret( *this );
         ret ^= other;
         return ret;
     }
 
-    LongNumber operator<<=( size_t shift ) noexcept
+    LongNumber operator^( const LongNumber& other ) &&
+    {
+        *this ^= other;
+        return std::move( *this );
+    }
+
+    LongNumber operator^( LongNumber&& other ) const&
+    {
+        other ^= *this;
+        return std::move( other );
+    }
+
+    LongNumber operator^( LongNumber&& other ) &&
+    {
+        *this ^= other;
+        return std::move( *this );
+    }
+
+    LongNumber& operator<<=( size_t shift ) noexcept
     {
         [[unlikely]] if( isZero_ || shift == 0 )
         {
             return *this;
         }
 
-        if( shift > bitSize )
+        if( shift >= bitSize )
         {
             memset( bytes_.byte, 0, bitSize / 8 );
+            isZero_ = true;
             return *this;
         }
 
-        size_t wordsShift = shift / traits::BitsNumberOf( bytes_.word[ 0 ] );
-        size_t perWordBitShift = shift % traits::BitsNumberOf( bytes_.word[ 0 ] );
+        kernel::ShiftLeft( bytes_.word, bytes_.word, traits_.COUNT_OF_WORDS, shift );
+        CheckIsZero();
+        return *this;
+    }
 
-        // memcpy for overlapping buffers is undefined behabiour, so copy in
-        // cycle.
-        size_t readPos = wordsShift;
-        size_t writePos = 0;
+    LongNumber operator<<( size_t shift ) const&
+    {
+        LongNumber ret( *this );
+        ret <<= shift;
+        return ret;
+    }
 
-        for( size_t i = 0; i < traits_.COUNT_OF_WORDS - wordsShift; ++i )
-        {
-            assert( readPos < traits_.COUNT_OF_WORDS );
-            assert( writePos < traits_.COUNT_OF_WORDS );
-            bytes_.word[ writePos ] = bytes_.word[ readPos ];
-            ++readPos;
-            ++writePos;
-        }
-        for( size_t i = traits_.COUNT_OF_WORDS - wordsShift; i < traits_.COUNT_OF_WORDS; ++i )
+    LongNumber operator<<( size_t shift ) &&
+    {
+        *this <<= shift;
+        return std::move( *this );
+    }
+
+    LongNumber& operator>>=( size_t shift ) noexcept
+    {
+        [[unlikely]] if( isZero_ || shift == 0 )
         {
-            bytes_.word[ i ] = 0;
+            return *this;
         }
 
-        size_t appendToRight = 0;
-        for( size_t i = wordsShift; i < traits_.COUNT_OF_WORDS; ++i )
+        if( shift >= bitSize )
         {
-            size_t wordIdx = traits_.COUNT_OF_WORDS - i - 1;
-            assert( wordIdx < traits_.COUNT_OF_WORDS );
-            T word = bytes_.word[ wordIdx ];
-            T buf = word >> ( traits_.WORD_BIT_SIZE - perWordBitShift );
-            T res = word << perWordBitShift;
-            res |= appendToRight;
-            bytes_.word[ wordIdx ] = res;
-            appendToRight = buf;
+            memset( bytes_.byte, 0, bitSize / 8 );
+            isZero_ = true;
+            return *this;
         }
+
+        kernel::ShiftRight( bytes_.word, bytes_.word, traits_.COUNT_OF_WORDS, shift );
         CheckIsZero();
         return *this;
     }
 
-    LongNumber operator*=( const LongNumber& other ) noexcept
+    LongNumber operator>>( size_t shift ) const&
+    {
+        LongNumber ret( *this );
+        ret >>= shift;
+        return ret;
+    }
+
+    LongNumber operator>>( size_t shift ) &&
+    {
+        *this >>= shift;
+        return std::move( *this );
+    }
+
+    /**
+     * @brief Multiplication modulo 2^bitSize.
+     */
+    LongNumber& operator*=( const LongNumber& other ) noexcept
     {
         [[unlikely]] if( isZero_ || other.isZero_ )
         {
             memset( buf_.GetBuf(), 0, traits_.COUNT_OF_BYTES );
+            isZero_ = true;
             return *this;
         }
 
-        size_t lastCheckedBit = 0;
-        LongNumber tmp( *this );
+        // Truncated schoolbook multiplication. Operands are copied to the stack, so that
+        // the product is accumulated in place without a temporary number even when other
+        // is *this. Row i adds left word of weight i times the low words of right.
+        T left[ traits_.COUNT_OF_WORDS ];
+        T right[ traits_.COUNT_OF_WORDS ];
+        std::memcpy( left, bytes_.word, traits_.COUNT_OF_BYTES );
+        std::memcpy( right, other.bytes_.word, traits_.COUNT_OF_BYTES );
         memset( buf_.GetBuf(), 0, traits_.COUNT_OF_BYTES );
-        for( size_t i = 0; i < traits_.NUMBER_BIT_SIZE; ++i )
+
+        for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
         {
-            if( other.CheckBit( i ) )
-            {
-                size_t shift = i - lastCheckedBit;
-                tmp <<= ( shift );
-                *this += tmp;
-                lastCheckedBit = i;
-            }
+            kernel::AddMul1( bytes_.word + i, right, traits_.COUNT_OF_WORDS - i, left[ i ] );
         }
+        CheckIsZero();
         return *this;
     }
 
-    LongNumber operator*( const LongNumber& other ) const
+    LongNumber operator*( const LongNumber& other ) const&
+    {
+        LongNumber ret( *this );
+        ret *= other;
+        return ret;
+    }
+
+    LongNumber operator*( const LongNumber& other ) &&
     {
-        LongNumber ret;
-        size_t firstBitsCount = 0;
-        size_t secondBitsCount = 0;
-        std::reference_wrapper< const LongNumber > left = *this;
-        std::reference_wrapper< const LongNumber > right = other;
+        *this *= other;
+        return std::move( *this );
+    }
 
-        [[unlikely]] if( isZero_ || other.isZero_ )
+    LongNumber operator*( LongNumber&& other ) const&
+    {
+        other *= *this;
+        return std::move( other );
+    }
+
+    LongNumber operator*( LongNumber&& other ) &&
+    {
+        *this *= other;
+        return std::move( *this );
+    }
+
+    /**
+     * @brief Load number from big-endian byte sequence.
+     *
+     * @param[in] data Bytes, most significant first.
+     * @param[in] size Count of bytes, shorter sequences are zero-extended.
+     *
+     * @throw std::runtime_error If \p size exceeds bitSize / 8.
+     */
+    void ImportBE( const uint8_t* data, size_t size )
+    {
+        CheckImportSize( size );
+        memset( bytes_.byte, 0, traits_.COUNT_OF_BYTES );
+        for( size_t i = 0; i < size / sizeof( T ); ++i )
         {
-            return ret;
+            T word;
+            std::memcpy( &word, data + size - ( i + 1 ) * sizeof( T ), sizeof( T ) );
+            bytes_.word[ i ] = BIG_ENDIAN_SWAP( word );
         }
+        for( size_t i = size - size % sizeof( T ); i < size; ++i )
+        {
+            bytes_.word[ i / sizeof( T ) ] |= static_cast< T >( data[ size - 1 - i ] )
+                                              << 8 * ( i % sizeof( T ) );
+        }
+        CheckIsZero();
+    }
 
-        for( size_t i = 0; i < traits_.NUMBER_BIT_SIZE; ++i )
+    /**
+     * @brief Load number from little-endian byte sequence.
+     *
+     * @param[in] data Bytes, least significant first.
+     * @param[in] size Count of bytes, shorter sequences are zero-extended.
+     *
+     * @throw std::runtime_error If \p size exceeds bitSize / 8.
+     */
+    void ImportLE( const uint8_t* data, size_t size )
+    {
+        CheckImportSize( size );
+        memset( bytes_.byte, 0, traits_.COUNT_OF_BYTES );
+        for( size_t i = 0; i < size / sizeof( T ); ++i )
         {
-            firstBitsCount += CheckBit( i );
-            secondBitsCount += other.CheckBit( i );
+            T word;
+            std::memcpy( &word, data + i * sizeof( T ), sizeof( T ) );
+            bytes_.word[ i ] = LITTLE_ENDIAN_SWAP( word );
         }
-        if( firstBitsCount > secondBitsCount )
+        for( size_t i = size - size % sizeof( T ); i < size; ++i )
         {
-            std::swap( left, right );
+            bytes_.word[ i / sizeof( T ) ] |= static_cast< T >( data[ i ] )
+                                              << 8 * ( i % sizeof( T ) );
         }
+        CheckIsZero();
+    }
 
-        ret = left;
-        ret *= right;
-        return ret;
+    /**
+     * @brief Store number as big-endian byte sequence.
+     *
+     * @param[out] data Buffer for bytes, most significant first.
+     * @param[in] size Size of buffer, larger buffers are padded with leading zeros.
+     *
+     * @throw std::runtime_error If \p size is less than bitSize / 8.
+     */
+    void ExportBE( uint8_t* data, size_t size ) const
+    {
+        CheckExportSize( size );
+        size_t padding = size - traits_.COUNT_OF_BYTES;
+        memset( data, 0, padding );
+        for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
+        {
+            T word = BIG_ENDIAN_SWAP( bytes_.word[ i ] );
+            std::memcpy( data + size - ( i + 1 ) * sizeof( T ), &word, sizeof( T ) );
+        }
+    }
+
+    /**
+     * @brief Store number as little-endian byte sequence.
+     *
+     * @param[out] data Buffer for bytes, least significant first.
+     * @param[in] size Size of buffer, larger buffers are padded with trailing zeros.
+     *
+     * @throw std::runtime_error If \p size is less than bitSize / 8.
+     */
+    void ExportLE( uint8_t* data, size_t size ) const
+    {
+        CheckExportSize( size );
+        for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
+        {
+            T word = LITTLE_ENDIAN_SWAP( bytes_.word[ i ] );
+            std::memcpy( data + i * sizeof( T ), &word, sizeof( T ) );
+        }
+        memset( data + traits_.COUNT_OF_BYTES, 0, size - traits_.COUNT_OF_BYTES );
+    }
+
+    /**
+     * @brief Count of words in number.
+     */
+    static constexpr size_t LIMB_COUNT = bitSize / traits::BitsNumberOf< T >();
+
+    /**
+     * @brief Words of number, least significant first.
+     */
+    inline const T* Limbs() const noexcept
+    {
+        return bytes_.word;
+    }
+
+    /**
+     * @brief Load number from LIMB_COUNT words, least significant first.
+     */
+    void AssignLimbs( const T* limbs ) noexcept
+    {
+        std::memcpy( bytes_.word, limbs, traits_.COUNT_OF_BYTES );
+        CheckIsZero();
+    }
+
+    /**
+     * @brief Count of characters written by ToHex.
+     */
+    static constexpr size_t HEX_LENGTH = bitSize / 4;
+
+    /**
+     * @brief Write number as lowercase hex digits, most significant first.
+     *
+     * @param[out] out Buffer for HEX_LENGTH characters, no terminating null is written.
+     */
+    void ToHex( char* out ) const noexcept
+    {
+        for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
+        {
+            T word = bytes_.word[ traits_.COUNT_OF_WORDS - 1 - i ];
+            for( size_t j = 0; j < sizeof( T ); ++j )
+            {
+                uint8_t byte = static_cast< uint8_t >( word >> 8 * ( sizeof( T ) - 1 - j ) );
+                util::hex::EncodeByte( out + 2 * ( i * sizeof( T ) + j ), byte );
+            }
+        }
+    }
+
+    /**
+     * @brief Load number from hex digits of either case, most significant first.
+     *
+     * @param[in] hex Digits without prefix. Shorter strings, including odd-length ones,
+     * are zero-extended.
+     *
+     * @throw std::runtime_error If \p hex is longer than HEX_LENGTH or contains
+     * a character other than a hex digit.
+     */
+    void FromHex( std::string_view hex )
+    {
+        [[unlikely]] if( hex.size() > HEX_LENGTH )
+        {
+            throw std::runtime_error( "Hex string is too long" );
+        }
+
+        constexpr size_t DIGITS_PER_WORD = 2 * sizeof( T );
+        memset( bytes_.byte, 0, traits_.COUNT_OF_BYTES );
+        for( size_t i = 0; i < hex.size(); ++i )
+        {
+            int digit = util::hex::DecodeDigit( hex[ hex.size() - 1 - i ] );
+            [[unlikely]] if( digit < 0 )
+            {
+                memset( bytes_.byte, 0, traits_.COUNT_OF_BYTES );
+                isZero_ = true;
+                throw std::runtime_error( "Invalid hex digit" );
+            }
+            bytes_.word[ i / DIGITS_PER_WORD ] |= static_cast< T >( digit )
+                                                  << 4 * ( i % DIGITS_PER_WORD );
+        }
+        CheckIsZero();
+    }
+
+    /**
+     * @brief Store number as big-endian bytes.
+     *
+     * @param[out] out Buffer for bitSize / 8 bytes.
+     */
+    void ToBytes( uint8_t* out ) const
+    {
+        ExportBE( out, traits_.COUNT_OF_BYTES );
     }
 
+    /**
+     * @brief Load number from big-endian bytes, see ImportBE.
+     */
+    void FromBytes( const uint8_t* data, size_t size )
+    {
+        ImportBE( data, size );
+    }
+
+    /**
+     * @brief Print number as colon-separated hex bytes, most significant first.
+     */
     friend std::ostream& operator<<( std::ostream& os, const LongNumber& number )
     {
-        number.ByteSwap();
-        for( size_t i = 0; i < number.traits_.COUNT_OF_BYTES - 1; ++i )
+        char hex[ HEX_LENGTH ];
+        number.ToHex( hex );
+        char text[ 3 * traits_.COUNT_OF_BYTES ];
+        for( size_t i = 0; i < traits_.COUNT_OF_BYTES; ++i )
         {
-            os << std::setfill( '0' ) << std::setw( 2 ) << std::hex
-               << static_cast< int >( number.bytes_.byte[ i ] ) << ":";
+            text[ 3 * i ] = hex[ 2 * i ];
+            text[ 3 * i + 1 ] = hex[ 2 * i + 1 ];
+            text[ 3 * i + 2 ] = ':';
         }
-        os << std::setfill( '0' ) << std::setw( 2 ) << std::hex
-           << static_cast< int >( number.bytes_.byte[ number.BitSize() / 8 - 1 ] ) << std::flush;
-        number.ByteSwap();
-        return os;
+        return os.write( text, sizeof( text ) - 1 );
     }
 
-private:
-    constexpr inline size_t BitSize() const noexcept
+    inline bool IsZero() const noexcept
     {
-        return bitSize;
+        return isZero_;
     }
 
-    inline bool CheckBit( size_t bit ) const noexcept
+    /**
+     * @brief Number of significant bits, i.e. index of the highest set bit plus one.
+     *
+     * @return size_t Bit length, 0 for zero.
+     */
+    size_t BitLength() const noexcept
     {
-        assert( bit <= bitSize );
+        for( size_t i = traits_.COUNT_OF_WORDS; i > 0; --i )
+        {
+            T word = bytes_.word[ i - 1 ];
+            if( word != 0 )
+            {
+                size_t length = 0;
+                while( word != 0 )
+                {
+                    word >>= 1;
+                    ++length;
+                }
+                return ( i - 1 ) * traits_.WORD_BIT_SIZE + length;
+            }
+        }
+        return 0;
+    }
 
-        size_t wordIdx = traits_.COUNT_OF_WORDS - 1 - bit / traits_.WORD_BIT_SIZE;
-        size_t bitIdx = bit % traits_.WORD_BIT_SIZE;
-        T word = bytes_.word[ wordIdx ];
-        return ( ( T )1 << ( bitIdx ) ) & word;
+private:
+    template < size_t otherBitSize,
+               typename U,
+               std::enable_if_t< sfinae::is_word_multiple< otherBitSize, U >::value, bool >,
+               std::enable_if_t< std::is_integral< U >::value, bool >,
+               std::enable_if_t< std::is_unsigned< U >::value, bool > >
+    friend class LongNumber;
+
+    constexpr inline size_t BitSize() const noexcept
+    {
+        return bitSize;
     }
 
     bool CheckIsZero() noexcept
@@ -323,11 +672,19 @@ private:
         return isZero_;
     }
 
-    void ByteSwap() const noexcept
+    static void CheckImportSize( size_t size )
     {
-        for( size_t i = 0; i < traits_.COUNT_OF_WORDS; ++i )
+        [[unlikely]] if( size > traits_.COUNT_OF_BYTES )
+        {
+            throw std::runtime_error( "Byte sequence is too long" );
+        }
+    }
+
+    static void CheckExportSize( size_t size )
+    {
+        [[unlikely]] if( size < traits_.COUNT_OF_BYTES )
         {
-            bytes_.word[ i ] = BYTE_SWAP( bytes_.word[ i ] );
+            throw std::runtime_error( "Buffer is too short" );
         }
     }
 
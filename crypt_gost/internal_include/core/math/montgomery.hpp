@@ -0,0 +1,527 @@
+#pragma once
+
+#include <stdexcept>
+#include <vector>
+#include <core/math/number_array.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Montgomery arithmetic modulo a fixed odd modulus.
+ *
+ * A number x is represented by x * R mod p, where R = 2^bitSize, so that multiplication
+ * needs no division: Mul( aR, bR ) = abR. Unless stated otherwise, functions take and
+ * return numbers in Montgomery form, less than the modulus, and run in time independent
+ * of their values.
+ */
+template < size_t bitSize, typename T = uint64_t >
+class MontgomeryContext final
+{
+public:
+    using Number = LongNumber< bitSize, T >;
+    static constexpr size_t LIMB_COUNT = Number::LIMB_COUNT;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] modulus Odd modulus greater than 1.
+     */
+    explicit MontgomeryContext( const Number& modulus )
+        : modulus_( modulus )
+        , inverse_( 0 )
+        , one_()
+        , rSquared_()
+        , rCubed_()
+        , halfModulus_( ( modulus >> 1 ) + Number( 1 ) )
+        , fermatChain_()
+    {
+        [[unlikely]] if( ( modulus.Limbs()[ 0 ] & 1 ) == 0 || modulus < Number( 3 ) )
+        {
+            throw std::runtime_error( "Unsupported Montgomery modulus" );
+        }
+
+        // Newton iteration doubles the count of correct low bits of p^-1 each step.
+        T low = modulus.Limbs()[ 0 ];
+        T inverse = low;
+        for( size_t bits = 1; bits < traits::BitsNumberOf< T >(); bits *= 2 )
+        {
+            inverse = static_cast< T >( inverse * static_cast< T >( 2 - low * inverse ) );
+        }
+        inverse_ = static_cast< T >( 0 - inverse );
+
+        // R mod p and R^2 mod p by doubling, in double width to keep the carry.
+        LongNumber< 2 * bitSize, T > wideModulus( modulus );
+        LongNumber< 2 * bitSize, T > value = 1;
+        for( size_t i = 0; i < 2 * bitSize; ++i )
+        {
+            value <<= 1;
+            if( value >= wideModulus )
+            {
+                value -= wideModulus;
+            }
+            if( i == bitSize - 1 )
+            {
+                one_ = Number( value );
+            }
+        }
+        rSquared_ = Number( value );
+        rCubed_ = Mul( rSquared_, rSquared_ );
+
+        BuildFermatChain( modulus - Number( 2 ) );
+    }
+
+    inline const Number& Modulus() const noexcept
+    {
+        return modulus_;
+    }
+
+    /**
+     * @brief Montgomery form of 1, i.e. R mod p.
+     */
+    inline const Number& One() const noexcept
+    {
+        return one_;
+    }
+
+    /**
+     * @brief out = a * b / R mod p.
+     */
+    void Mul( const Number& a, const Number& b, Number& out ) const noexcept
+    {
+        T res[ LIMB_COUNT ];
+        MulLimbs( res, a.Limbs(), b.Limbs() );
+        out.AssignLimbs( res );
+    }
+
+    Number Mul( const Number& a, const Number& b ) const
+    {
+        Number ret;
+        Mul( a, b, ret );
+        return ret;
+    }
+
+    Number Sqr( const Number& a ) const
+    {
+        return Mul( a, a );
+    }
+
+    /**
+     * @brief out = a + b mod p. Works for either representation.
+     */
+    void Add( const Number& a, const Number& b, Number& out ) const noexcept
+    {
+        T sum[ LIMB_COUNT ];
+        AddLimbs( sum, a.Limbs(), b.Limbs() );
+        out.AssignLimbs( sum );
+    }
+
+    Number Add( const Number& a, const Number& b ) const
+    {
+        Number ret;
+        Add( a, b, ret );
+        return ret;
+    }
+
+    /**
+     * @brief out = a - b mod p. Works for either representation.
+     */
+    void Sub( const Number& a, const Number& b, Number& out ) const noexcept
+    {
+        T diff[ LIMB_COUNT ];
+        SubLimbs( diff, a.Limbs(), b.Limbs() );
+        out.AssignLimbs( diff );
+    }
+
+    Number Sub( const Number& a, const Number& b ) const
+    {
+        Number ret;
+        Sub( a, b, ret );
+        return ret;
+    }
+
+    /**
+     * @brief r = a * b / R mod p on LIMB_COUNT words, for callers which keep temporaries
+     * in stack buffers. Output may alias inputs.
+     *
+     * Coarsely integrated operand scanning: one word of b is multiplied in and one word of
+     * the result is reduced per iteration. Loops of fixed length on double width products
+     * are unrolled by the compiler, which is faster for field sizes than calls of the
+     * dispatched kernel.
+     */
+    void MulLimbs( T* r, const T* a, const T* b ) const noexcept
+    {
+        using DoubleT = traits::DoubleWidth_t< T >;
+        constexpr size_t WORD_BIT_SIZE = traits::BitsNumberOf< T >();
+        const T* p = modulus_.Limbs();
+        T acc[ LIMB_COUNT + 1 ] = {};
+        for( size_t i = 0; i < LIMB_COUNT; ++i )
+        {
+            DoubleT product = 0;
+            for( size_t j = 0; j < LIMB_COUNT; ++j )
+            {
+                product = static_cast< DoubleT >( a[ j ] ) * b[ i ] + acc[ j ]
+                          + static_cast< T >( product >> WORD_BIT_SIZE );
+                acc[ j ] = static_cast< T >( product );
+            }
+            DoubleT sum = static_cast< DoubleT >( acc[ LIMB_COUNT ] )
+                          + static_cast< T >( product >> WORD_BIT_SIZE );
+            acc[ LIMB_COUNT ] = static_cast< T >( sum );
+            T top = static_cast< T >( sum >> WORD_BIT_SIZE );
+
+            T m = static_cast< T >( acc[ 0 ] * inverse_ );
+            product = static_cast< DoubleT >( p[ 0 ] ) * m + acc[ 0 ];
+            for( size_t j = 1; j < LIMB_COUNT; ++j )
+            {
+                product = static_cast< DoubleT >( p[ j ] ) * m + acc[ j ]
+                          + static_cast< T >( product >> WORD_BIT_SIZE );
+                acc[ j - 1 ] = static_cast< T >( product );
+            }
+            sum = static_cast< DoubleT >( acc[ LIMB_COUNT ] )
+                  + static_cast< T >( product >> WORD_BIT_SIZE );
+            acc[ LIMB_COUNT - 1 ] = static_cast< T >( sum );
+            sum = static_cast< DoubleT >( top ) + static_cast< T >( sum >> WORD_BIT_SIZE );
+            acc[ LIMB_COUNT ] = static_cast< T >( sum );
+        }
+
+        // Result is below 2p, subtract p unless that borrows.
+        T diff[ LIMB_COUNT ];
+        T borrow = kernel::generic::Sub( diff, acc, p, LIMB_COUNT );
+        Select( r, diff, acc, Mask( acc[ LIMB_COUNT ] | ( borrow ^ 1 ) ) );
+    }
+
+    /**
+     * @brief r = a + b mod p on LIMB_COUNT words. Output may alias inputs.
+     */
+    void AddLimbs( T* r, const T* a, const T* b ) const noexcept
+    {
+        T sum[ LIMB_COUNT ];
+        T diff[ LIMB_COUNT ];
+        T carry = kernel::generic::Add( sum, a, b, LIMB_COUNT );
+        T borrow = kernel::generic::Sub( diff, sum, modulus_.Limbs(), LIMB_COUNT );
+        // Subtract unless the sum is below the modulus.
+        Select( r, diff, sum, Mask( carry | ( borrow ^ 1 ) ) );
+    }
+
+    /**
+     * @brief r = a - b mod p on LIMB_COUNT words. Output may alias inputs.
+     */
+    void SubLimbs( T* r, const T* a, const T* b ) const noexcept
+    {
+        T diff[ LIMB_COUNT ];
+        T sum[ LIMB_COUNT ];
+        T borrow = kernel::generic::Sub( diff, a, b, LIMB_COUNT );
+        kernel::generic::Add( sum, diff, modulus_.Limbs(), LIMB_COUNT );
+        Select( r, sum, diff, Mask( borrow ) );
+    }
+
+    /**
+     * @brief Convert number less than the modulus to Montgomery form.
+     */
+    Number ToMont( const Number& a ) const
+    {
+        return Mul( a, rSquared_ );
+    }
+
+    /**
+     * @brief Convert number from Montgomery form.
+     */
+    Number FromMont( const Number& a ) const
+    {
+        return Mul( a, Number( 1 ) );
+    }
+
+    /**
+     * @brief base^exponent mod p.
+     *
+     * Fixed 4-bit window: every window costs four squarings and one multiplication by
+     * a table entry, which is read with a full constant-time scan of the table.
+     *
+     * @param[in] base Base in Montgomery form.
+     * @param[in] exponent Exponent in ordinary form, any value.
+     *
+     * @return Number Power in Montgomery form.
+     */
+    Number Pow( const Number& base, const Number& exponent ) const
+    {
+        constexpr size_t WINDOW_BIT_SIZE = 4;
+        constexpr size_t TABLE_SIZE = 1 << WINDOW_BIT_SIZE;
+        constexpr size_t WINDOWS_PER_WORD = traits::BitsNumberOf< T >() / WINDOW_BIT_SIZE;
+
+        T table[ TABLE_SIZE ][ LIMB_COUNT ];
+        std::memcpy( table[ 0 ], one_.Limbs(), sizeof( table[ 0 ] ) );
+        std::memcpy( table[ 1 ], base.Limbs(), sizeof( table[ 1 ] ) );
+        for( size_t i = 2; i < TABLE_SIZE; ++i )
+        {
+            MulLimbs( table[ i ], table[ i - 1 ], base.Limbs() );
+        }
+
+        T acc[ LIMB_COUNT ];
+        T entry[ LIMB_COUNT ];
+        std::memcpy( acc, one_.Limbs(), sizeof( acc ) );
+        const T* exp = exponent.Limbs();
+        for( size_t w = LIMB_COUNT * WINDOWS_PER_WORD; w > 0; --w )
+        {
+            for( size_t i = 0; i < WINDOW_BIT_SIZE; ++i )
+            {
+                MulLimbs( acc, acc, acc );
+            }
+            size_t bit = ( w - 1 ) * WINDOW_BIT_SIZE;
+            T window = ( exp[ bit / traits::BitsNumberOf< T >() ]
+                         >> ( bit % traits::BitsNumberOf< T >() ) )
+                       & ( TABLE_SIZE - 1 );
+            std::memset( entry, 0, sizeof( entry ) );
+            for( size_t i = 0; i < TABLE_SIZE; ++i )
+            {
+                T mask = Mask( ( window ^ static_cast< T >( i ) ) == 0 );
+                for( size_t j = 0; j < LIMB_COUNT; ++j )
+                {
+                    entry[ j ] |= table[ i ][ j ] & mask;
+                }
+            }
+            MulLimbs( acc, acc, entry );
+        }
+
+        Number ret;
+        ret.AssignLimbs( acc );
+        return ret;
+    }
+
+    /**
+     * @brief a^-1 mod p by Fermat's little theorem, a^( p - 2 ). Modulus must be prime.
+     *
+     * The public exponent p - 2 is recoded once per context into a sliding-window chain of
+     * squarings and multiplications by odd powers, so the operation sequence is the same
+     * for every a. Zero is mapped to zero.
+     */
+    Number Inverse( const Number& a ) const
+    {
+        T table[ FERMAT_TABLE_SIZE ][ LIMB_COUNT ];
+        T square[ LIMB_COUNT ];
+        std::memcpy( table[ 0 ], a.Limbs(), sizeof( table[ 0 ] ) );
+        MulLimbs( square, a.Limbs(), a.Limbs() );
+        for( size_t i = 1; i < FERMAT_TABLE_SIZE; ++i )
+        {
+            MulLimbs( table[ i ], table[ i - 1 ], square );
+        }
+
+        T acc[ LIMB_COUNT ];
+        std::memcpy( acc, table[ fermatChain_[ 0 ].index ], sizeof( acc ) );
+        for( size_t i = 1; i < fermatChain_.size(); ++i )
+        {
+            for( size_t j = 0; j < fermatChain_[ i ].squarings; ++j )
+            {
+                MulLimbs( acc, acc, acc );
+            }
+            if( fermatChain_[ i ].index != NO_MULTIPLICATION )
+            {
+                MulLimbs( acc, acc, table[ fermatChain_[ i ].index ] );
+            }
+        }
+
+        Number ret;
+        ret.AssignLimbs( acc );
+        return ret;
+    }
+
+    /**
+     * @brief a^-1 mod p by constant-time binary extended GCD, for any odd modulus.
+     *
+     * Every one of 2 * bitSize iterations performs the same conditional subtractions,
+     * swaps and halvings with masks instead of branches.
+     *
+     * @throw std::runtime_error If a is not invertible.
+     */
+    Number InverseGcd( const Number& a ) const
+    {
+        // Invariants: a = u * x mod p, b = v * x mod p, b is odd.
+        T x[ LIMB_COUNT ];
+        T y[ LIMB_COUNT ];
+        T u[ LIMB_COUNT ] = { 1 };
+        T v[ LIMB_COUNT ] = {};
+        T tmp[ LIMB_COUNT ];
+        const T zero[ LIMB_COUNT ] = {};
+        const T* p = modulus_.Limbs();
+        std::memcpy( x, a.Limbs(), sizeof( x ) );
+        std::memcpy( y, p, sizeof( y ) );
+
+        for( size_t i = 0; i < 2 * bitSize; ++i )
+        {
+            T odd = Mask( x[ 0 ] & 1 );
+
+            // If x is odd: x -= y, and if that borrows, y = old x and x = old y - old x.
+            T borrow = kernel::Sub( tmp, x, y, LIMB_COUNT );
+            Select( x, tmp, x, odd );
+            T swap = odd & Mask( borrow );
+            kernel::Add( tmp, y, x, LIMB_COUNT );
+            Select( y, tmp, y, swap );
+            kernel::Sub( tmp, zero, x, LIMB_COUNT );
+            Select( x, tmp, x, swap );
+
+            // Same steps for the coefficients modulo p.
+            for( size_t j = 0; j < LIMB_COUNT; ++j )
+            {
+                T diff = ( u[ j ] ^ v[ j ] ) & swap;
+                u[ j ] ^= diff;
+                v[ j ] ^= diff;
+            }
+            borrow = kernel::Sub( tmp, u, v, LIMB_COUNT );
+            Select( u, tmp, u, odd );
+            kernel::Add( tmp, u, p, LIMB_COUNT );
+            Select( u, tmp, u, odd & Mask( borrow ) );
+
+            // x is even now, halve it together with u modulo p.
+            kernel::ShiftRight( x, x, LIMB_COUNT, 1 );
+            T uOdd = Mask( u[ 0 ] & 1 );
+            kernel::ShiftRight( u, u, LIMB_COUNT, 1 );
+            kernel::Add( tmp, u, halfModulus_.Limbs(), LIMB_COUNT );
+            Select( u, tmp, u, uOdd );
+        }
+
+        // y = gcd( a, p ).
+        T one[ LIMB_COUNT ] = { 1 };
+        [[unlikely]] if( std::memcmp( y, one, sizeof( y ) ) != 0 )
+        {
+            throw std::runtime_error( "Number is not invertible" );
+        }
+
+        // v = ( aR )^-1 = a^-1 * R^-1, convert to a^-1 * R.
+        T res[ LIMB_COUNT ];
+        MulLimbs( res, v, rCubed_.Limbs() );
+        Number ret;
+        ret.AssignLimbs( res );
+        return ret;
+    }
+
+    /**
+     * @brief Replace every element by its inverse with a single field inversion.
+     *
+     * Montgomery's trick: inverse of the product of all elements is multiplied by prefix
+     * products to obtain each inverse, 3 * ( n - 1 ) multiplications in total. Modulus
+     * must be prime.
+     *
+     * @param[in,out] values Non-zero elements in Montgomery form.
+     *
+     * @throw std::runtime_error If an element is zero.
+     */
+    void BatchInverse( LongNumberArray< bitSize, T >& values ) const
+    {
+        size_t count = values.Size();
+        if( count == 0 )
+        {
+            return;
+        }
+
+        LongNumberArray< bitSize, T > prefix( count );
+        Number acc = one_;
+        Number value;
+        for( size_t i = 0; i < count; ++i )
+        {
+            prefix.Set( i, acc );
+            values.Get( i, value );
+            Mul( acc, value, acc );
+        }
+        [[unlikely]] if( acc.IsZero() )
+        {
+            throw std::runtime_error( "Zero element in batch inversion" );
+        }
+
+        Number inverse = Inverse( acc );
+        Number product;
+        for( size_t i = count; i > 0; --i )
+        {
+            values.Get( i - 1, value );
+            prefix.Get( i - 1, product );
+            Mul( inverse, product, product );
+            Mul( inverse, value, inverse );
+            values.Set( i - 1, product );
+        }
+    }
+
+private:
+    static constexpr size_t FERMAT_WINDOW_BIT_SIZE = 5;
+    static constexpr size_t FERMAT_TABLE_SIZE = 1 << ( FERMAT_WINDOW_BIT_SIZE - 1 );
+    static constexpr size_t NO_MULTIPLICATION = FERMAT_TABLE_SIZE;
+
+    // Squarings followed by multiplication by odd power 2 * index + 1.
+    struct ChainStep
+    {
+        size_t squarings;
+        size_t index;
+    };
+
+    // All ones if value is non-zero.
+    static inline T Mask( T value ) noexcept
+    {
+        return static_cast< T >( 0 - static_cast< T >( value != 0 ) );
+    }
+
+    // r = mask ? a : b, word by word.
+    static inline void Select( T* r, const T* a, const T* b, T mask ) noexcept
+    {
+        for( size_t i = 0; i < LIMB_COUNT; ++i )
+        {
+            r[ i ] = ( a[ i ] & mask ) | ( b[ i ] & ~mask );
+        }
+    }
+
+    // Sliding-window recoding of a public exponent.
+    void BuildFermatChain( const Number& exponent )
+    {
+        const T* exp = exponent.Limbs();
+        auto bit = [ exp ]( size_t i ) -> T {
+            return ( exp[ i / traits::BitsNumberOf< T >() ] >> ( i % traits::BitsNumberOf< T >() ) )
+                   & 1;
+        };
+
+        size_t pending = 0;
+        size_t i = exponent.BitLength();
+        while( i > 0 )
+        {
+            if( bit( i - 1 ) == 0 )
+            {
+                ++pending;
+                --i;
+                continue;
+            }
+            // Longest window starting at bit i - 1 that ends with a set bit.
+            size_t low = i > FERMAT_WINDOW_BIT_SIZE ? i - FERMAT_WINDOW_BIT_SIZE : 0;
+            while( bit( low ) == 0 )
+            {
+                ++low;
+            }
+            size_t value = 0;
+            for( size_t j = i; j > low; --j )
+            {
+                value = ( value << 1 ) | bit( j - 1 );
+            }
+            fermatChain_.push_back( ChainStep{ pending + ( i - low ), value >> 1 } );
+            pending = 0;
+            i = low;
+        }
+        if( pending != 0 )
+        {
+            fermatChain_.push_back( ChainStep{ pending, NO_MULTIPLICATION } );
+        }
+    }
+
+    Number modulus_;
+    T inverse_;
+    Number one_;
+    Number rSquared_;
+    Number rCubed_;
+    Number halfModulus_;
+    std::vector< ChainStep > fermatChain_;
+};
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <core/math/barrett.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Fixed-size array of numbers of the same bit size in a single buffer.
+ *
+ * Unlike an array of LongNumber objects, elements carry no per-object header or separate
+ * allocation. Words are stored either packed, element after element, or as structure of
+ * arrays, where word j of all elements forms a contiguous row, so that element-wise
+ * operations process several elements per word position.
+ */
+template < size_t bitSize, typename T = uint64_t >
+class LongNumberArray final
+{
+public:
+    using Number = LongNumber< bitSize, T >;
+
+    enum Layout
+    {
+        PACKED,
+        SOA
+    };
+
+    static constexpr size_t LIMB_COUNT = Number::LIMB_COUNT;
+
+    /**
+     * @brief Create array of zeros.
+     *
+     * @param[in] size Count of elements.
+     * @param[in] layout Word layout.
+     * @param[in] alloc Allocator for the buffer.
+     */
+    explicit LongNumberArray( size_t size,
+                              Layout layout = PACKED,
+                              I_Allocator& alloc = HeapAllocator::GetInstance() )
+        : size_( size )
+        , layout_( layout )
+        , buf_( BufferSize( size ), ALIGNMENT, alloc )
+    {
+        memset( buf_.GetBuf(), 0, BufferSize( size ) );
+    }
+
+    inline size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    inline Layout GetLayout() const noexcept
+    {
+        return layout_;
+    }
+
+    /**
+     * @brief Word \p limb of element \p index, least significant word has index 0.
+     */
+    inline T& Limb( size_t index, size_t limb ) noexcept
+    {
+        return Data()[ Offset( index, limb ) ];
+    }
+
+    inline const T& Limb( size_t index, size_t limb ) const noexcept
+    {
+        return Data()[ Offset( index, limb ) ];
+    }
+
+    /**
+     * @brief Copy element \p index to \p out without allocation.
+     */
+    void Get( size_t index, Number& out ) const
+    {
+        CheckIndex( index );
+        T limbs[ LIMB_COUNT ];
+        Gather( limbs, index );
+        out.AssignLimbs( limbs );
+    }
+
+    Number Get( size_t index ) const
+    {
+        Number ret;
+        Get( index, ret );
+        return ret;
+    }
+
+    void Set( size_t index, const Number& value )
+    {
+        CheckIndex( index );
+        Scatter( index, value.Limbs() );
+    }
+
+    /**
+     * @brief Element-wise this = a + b mod 2^bitSize. Arrays may alias.
+     */
+    void Add( const LongNumberArray& a, const LongNumberArray& b )
+    {
+        CheckCompatible( a );
+        CheckCompatible( b );
+        if( layout_ == PACKED )
+        {
+            for( size_t i = 0; i < size_; ++i )
+            {
+                kernel::Add( Data() + i * LIMB_COUNT,
+                             a.Data() + i * LIMB_COUNT,
+                             b.Data() + i * LIMB_COUNT,
+                             LIMB_COUNT );
+            }
+            return;
+        }
+
+        // Carries of a block of elements are kept while walking up the word rows, the
+        // inner loop runs over independent elements and has no carry dependency.
+        T carry[ SOA_BLOCK ];
+        for( size_t start = 0; start < size_; start += SOA_BLOCK )
+        {
+            size_t count = std::min( SOA_BLOCK, size_ - start );
+            std::fill( carry, carry + count, T( 0 ) );
+            for( size_t limb = 0; limb < LIMB_COUNT; ++limb )
+            {
+                T* r = Data() + limb * size_ + start;
+                const T* x = a.Data() + limb * size_ + start;
+                const T* y = b.Data() + limb * size_ + start;
+                for( size_t i = 0; i < count; ++i )
+                {
+                    T sum = x[ i ] + carry[ i ];
+                    T nextCarry = sum < carry[ i ];
+                    T res = sum + y[ i ];
+                    carry[ i ] = nextCarry + ( res < sum );
+                    r[ i ] = res;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Element-wise this = a ^ b. Arrays may alias.
+     */
+    void Xor( const LongNumberArray& a, const LongNumberArray& b )
+    {
+        CheckCompatible( a );
+        CheckCompatible( b );
+        // Both layouts place the same words at the same offsets.
+        T* r = Data();
+        const T* x = a.Data();
+        const T* y = b.Data();
+        for( size_t i = 0; i < size_ * LIMB_COUNT; ++i )
+        {
+            r[ i ] = x[ i ] ^ y[ i ];
+        }
+    }
+
+    /**
+     * @brief Element-wise this = a * b mod 2^bitSize. Arrays may alias.
+     */
+    void Mul( const LongNumberArray& a, const LongNumberArray& b )
+    {
+        CheckCompatible( a );
+        CheckCompatible( b );
+        T left[ LIMB_COUNT ];
+        T right[ LIMB_COUNT ];
+        T res[ LIMB_COUNT ];
+        for( size_t i = 0; i < size_; ++i )
+        {
+            a.Gather( left, i );
+            b.Gather( right, i );
+            std::fill( res, res + LIMB_COUNT, T( 0 ) );
+            for( size_t j = 0; j < LIMB_COUNT; ++j )
+            {
+                kernel::AddMul1( res + j, right, LIMB_COUNT - j, left[ j ] );
+            }
+            Scatter( i, res );
+        }
+    }
+
+    /**
+     * @brief Element-wise this = a * b mod q for elements reduced modulo q of \p ctx.
+     * Arrays may alias.
+     */
+    void ModMul( const LongNumberArray& a,
+                 const LongNumberArray& b,
+                 const BarrettContext< bitSize, T >& ctx )
+    {
+        CheckCompatible( a );
+        CheckCompatible( b );
+        Number left;
+        Number right;
+        for( size_t i = 0; i < size_; ++i )
+        {
+            a.Get( i, left );
+            b.Get( i, right );
+            Scatter( i, ctx.Mul( left, right ).Limbs() );
+        }
+    }
+
+private:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t SOA_BLOCK = 64;
+
+    // aligned_alloc requires size to be a multiple of alignment.
+    static constexpr size_t BufferSize( size_t size ) noexcept
+    {
+        size_t bytes = std::max< size_t >( size, 1 ) * LIMB_COUNT * sizeof( T );
+        return ( bytes + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+    }
+
+    inline T* Data() const noexcept
+    {
+        return static_cast< T* >( buf_.GetBuf() );
+    }
+
+    inline size_t Offset( size_t index, size_t limb ) const noexcept
+    {
+        return layout_ == PACKED ? index * LIMB_COUNT + limb : limb * size_ + index;
+    }
+
+    void Gather( T* limbs, size_t index ) const noexcept
+    {
+        for( size_t j = 0; j < LIMB_COUNT; ++j )
+        {
+            limbs[ j ] = Data()[ Offset( index, j ) ];
+        }
+    }
+
+    void Scatter( size_t index, const T* limbs ) noexcept
+    {
+        for( size_t j = 0; j < LIMB_COUNT; ++j )
+        {
+            Data()[ Offset( index, j ) ] = limbs[ j ];
+        }
+    }
+
+    void CheckIndex( size_t index ) const
+    {
+        [[unlikely]] if( index >= size_ )
+        {
+            throw std::runtime_error( "Index out of range" );
+        }
+    }
+
+    void CheckCompatible( const LongNumberArray& other ) const
+    {
+        [[unlikely]] if( other.size_ != size_ || other.layout_ != layout_ )
+        {
+            throw std::runtime_error( "Incompatible number arrays" );
+        }
+    }
+
+    size_t size_;
+    Layout layout_;
+    util::MemBuf buf_;
+};
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
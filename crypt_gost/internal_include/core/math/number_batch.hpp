@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <core/math/math.hpp>
+#include <core/math/batch_kernel.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Montgomery parameters of an odd modulus for LongNumberBatch.
+ *
+ * Montgomery radix is R = 2^( 52 * LIMB_COUNT ), the smallest power of the limb radix
+ * covering bitSize bits.
+ */
+template < size_t bitSize >
+class BatchMontgomeryContext final
+{
+public:
+    using Number = LongNumber< bitSize >;
+
+    static constexpr size_t LIMB_COUNT =
+        ( bitSize + kernel::batch::RADIX_BIT_SIZE - 1 ) / kernel::batch::RADIX_BIT_SIZE;
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] modulus Odd modulus greater than 1.
+     */
+    explicit BatchMontgomeryContext( const Number& modulus )
+        : modulus_( modulus )
+        , limbs_()
+        , inverse_( 0 )
+        , rSquared_()
+    {
+        [[unlikely]] if( ( modulus.Limbs()[ 0 ] & 1 ) == 0 || modulus < Number( 3 ) )
+        {
+            throw std::runtime_error( "Unsupported Montgomery modulus" );
+        }
+
+        kernel::batch::ImportWords(
+            limbs_.data(), LIMB_COUNT, 1, modulus.Limbs(), Number::LIMB_COUNT );
+
+        // Newton iteration doubles the count of correct low bits of p^-1 each step.
+        uint64_t low = modulus.Limbs()[ 0 ];
+        uint64_t inverse = low;
+        for( int i = 0; i < 5; ++i )
+        {
+            inverse *= 2 - low * inverse;
+        }
+        inverse_ = ( 0 - inverse ) & kernel::batch::RADIX_MASK;
+
+        // R^2 mod p by doubling, in double width to keep the carry.
+        LongNumber< 2 * bitSize > wideModulus( modulus );
+        LongNumber< 2 * bitSize > value = 1;
+        for( size_t i = 0; i < 2 * LIMB_COUNT * kernel::batch::RADIX_BIT_SIZE; ++i )
+        {
+            value <<= 1;
+            if( value >= wideModulus )
+            {
+                value -= wideModulus;
+            }
+        }
+        rSquared_ = Number( value );
+    }
+
+    inline const Number& Modulus() const noexcept
+    {
+        return modulus_;
+    }
+
+    /**
+     * @brief Modulus as 52-bit limbs.
+     */
+    inline const uint64_t* Limbs() const noexcept
+    {
+        return limbs_.data();
+    }
+
+    /**
+     * @brief -p^-1 mod 2^52.
+     */
+    inline uint64_t Inverse() const noexcept
+    {
+        return inverse_;
+    }
+
+    /**
+     * @brief R^2 mod p, converts numbers to Montgomery form.
+     */
+    inline const Number& RSquared() const noexcept
+    {
+        return rSquared_;
+    }
+
+private:
+    Number modulus_;
+    std::array< uint64_t, LIMB_COUNT > limbs_;
+    uint64_t inverse_;
+    Number rSquared_;
+};
+
+/**
+ * @brief Several independent numbers processed together by SIMD kernels.
+ *
+ * Numbers are stored lane-interleaved in radix 2^52, see kernel::batch, so that one vector
+ * instruction works on the same limb of 4 (AVX2) or 8 (AVX-512 IFMA) numbers. Kernels are
+ * selected at runtime. Arithmetic follows LongNumber: Add and Mul wrap modulo 2^bitSize.
+ *
+ * @tparam lanes Count of numbers, a multiple of 4.
+ */
+template < size_t bitSize, size_t lanes >
+class LongNumberBatch final
+{
+    static_assert( lanes > 0 && lanes % 4 == 0, "Lane count must be a multiple of 4" );
+
+public:
+    using Number = LongNumber< bitSize >;
+    using Context = BatchMontgomeryContext< bitSize >;
+
+    static constexpr size_t LIMB_COUNT = Context::LIMB_COUNT;
+    static_assert( LIMB_COUNT <= kernel::batch::MAX_LIMBS, "Bit size is too large" );
+
+    explicit LongNumberBatch( I_Allocator& alloc = HeapAllocator::GetInstance() )
+        : buf_( BUFFER_SIZE, ALIGNMENT, alloc )
+    {
+        memset( buf_.GetBuf(), 0, BUFFER_SIZE );
+    }
+
+    void Set( size_t lane, const Number& value )
+    {
+        CheckLane( lane );
+        kernel::batch::ImportWords(
+            Data() + lane, LIMB_COUNT, lanes, value.Limbs(), Number::LIMB_COUNT );
+    }
+
+    /**
+     * @brief Set all lanes to \p value.
+     */
+    void Fill( const Number& value )
+    {
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            Set( lane, value );
+        }
+    }
+
+    /**
+     * @brief Copy lane \p lane to \p out without allocation.
+     */
+    void Get( size_t lane, Number& out ) const
+    {
+        CheckLane( lane );
+        uint64_t words[ Number::LIMB_COUNT ];
+        kernel::batch::ExportWords( words, Number::LIMB_COUNT, Data() + lane, LIMB_COUNT, lanes );
+        out.AssignLimbs( words );
+    }
+
+    Number Get( size_t lane ) const
+    {
+        Number ret;
+        Get( lane, ret );
+        return ret;
+    }
+
+    /**
+     * @brief this = a + b mod 2^bitSize in every lane. Batches may alias.
+     */
+    void Add( const LongNumberBatch& a, const LongNumberBatch& b ) noexcept
+    {
+        uint64_t carry[ lanes ] = {};
+        uint64_t* r = Data();
+        const uint64_t* x = a.Data();
+        const uint64_t* y = b.Data();
+        for( size_t j = 0; j < LIMB_COUNT; ++j )
+        {
+            for( size_t lane = 0; lane < lanes; ++lane )
+            {
+                size_t i = j * lanes + lane;
+                uint64_t sum = x[ i ] + y[ i ] + carry[ lane ];
+                r[ i ] = sum & kernel::batch::RADIX_MASK;
+                carry[ lane ] = sum >> kernel::batch::RADIX_BIT_SIZE;
+            }
+        }
+        Truncate();
+    }
+
+    /**
+     * @brief this = a * b mod 2^bitSize in every lane. Batches may alias.
+     */
+    void Mul( const LongNumberBatch& a, const LongNumberBatch& b )
+    {
+        kernel::batch::Mul( Data(), a.Data(), b.Data(), LIMB_COUNT, lanes );
+        Truncate();
+    }
+
+    /**
+     * @brief this = a * b / R mod p in every lane. Batches may alias.
+     *
+     * Operands must be less than p.
+     */
+    void MontMul( const LongNumberBatch& a, const LongNumberBatch& b, const Context& ctx )
+    {
+        kernel::batch::MontMul(
+            Data(), a.Data(), b.Data(), ctx.Limbs(), ctx.Inverse(), LIMB_COUNT, lanes );
+    }
+
+    /**
+     * @brief this = a * R mod p in every lane, a must be less than p.
+     */
+    void ToMont( const LongNumberBatch& a, const Context& ctx )
+    {
+        LongNumberBatch rSquared;
+        rSquared.Fill( ctx.RSquared() );
+        MontMul( a, rSquared, ctx );
+    }
+
+    /**
+     * @brief this = a / R mod p in every lane, a must be less than p.
+     */
+    void FromMont( const LongNumberBatch& a, const Context& ctx )
+    {
+        LongNumberBatch one;
+        one.Fill( Number( 1 ) );
+        MontMul( a, one, ctx );
+    }
+
+private:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t BUFFER_SIZE =
+        ( LIMB_COUNT * lanes * sizeof( uint64_t ) + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+    static constexpr size_t TOP_BIT_SIZE =
+        bitSize - ( LIMB_COUNT - 1 ) * kernel::batch::RADIX_BIT_SIZE;
+
+    inline uint64_t* Data() const noexcept
+    {
+        return static_cast< uint64_t* >( buf_.GetBuf() );
+    }
+
+    // Drop bits of the top limb beyond bitSize.
+    void Truncate() noexcept
+    {
+        uint64_t* top = Data() + ( LIMB_COUNT - 1 ) * lanes;
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            top[ lane ] &= ( 1ull << TOP_BIT_SIZE ) - 1;
+        }
+    }
+
+    void CheckLane( size_t lane ) const
+    {
+        [[unlikely]] if( lane >= lanes )
+        {
+            throw std::runtime_error( "Lane out of range" );
+        }
+    }
+
+    util::MemBuf buf_;
+};
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
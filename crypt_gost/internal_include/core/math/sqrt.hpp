@@ -0,0 +1,199 @@
+#pragma once
+
+#include <core/math/montgomery.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace math
+{
+
+/**
+ * @brief Square roots modulo a fixed prime.
+ *
+ * Method is chosen once per modulus:
+ * - p = 3 mod 4: root is a^( ( p + 1 ) / 4 ), a single exponentiation;
+ * - p = 5 mod 8: Atkin's method, one exponentiation and a few multiplications;
+ * - otherwise: Tonelli-Shanks with fixed count of operations for p - 1 = 2^s * m, about
+ *   s^2 / 2 squarings after one exponentiation.
+ *
+ * Numbers are in Montgomery form of the context with the same modulus, see GetField.
+ * Sqrt runs in time independent of its argument.
+ */
+template < size_t bitSize, typename T = uint64_t >
+class SqrtContext final
+{
+public:
+    using Number = LongNumber< bitSize, T >;
+    using Field = MontgomeryContext< bitSize, T >;
+    static constexpr size_t LIMB_COUNT = Number::LIMB_COUNT;
+
+    enum Method
+    {
+        EXPONENT,
+        ATKIN,
+        TONELLI_SHANKS
+    };
+
+    /**
+     * @brief Create context.
+     *
+     * @param[in] modulus Odd prime.
+     *
+     * @throw std::runtime_error If modulus is not supported by MontgomeryContext, or
+     * no quadratic non-residue is found for Tonelli-Shanks, which means modulus is not prime.
+     */
+    explicit SqrtContext( const Number& modulus )
+        : field_( modulus )
+        , method_( EXPONENT )
+        , exponent_()
+        , twoAdicity_( 0 )
+        , rootOfUnity_()
+    {
+        const T low = modulus.Limbs()[ 0 ];
+        if( ( low & 3 ) == 3 )
+        {
+            // ( p + 1 ) / 4.
+            exponent_ = ( modulus >> 2 ) + Number( 1 );
+        }
+        else if( ( low & 7 ) == 5 )
+        {
+            // ( p - 5 ) / 8.
+            method_ = ATKIN;
+            exponent_ = modulus >> 3;
+        }
+        else
+        {
+            // p - 1 = 2^s * m, exponent is ( m - 1 ) / 2 and root of unity is c = z^m for
+            // a non-residue z, it has order 2^s.
+            method_ = TONELLI_SHANKS;
+            Number m = modulus - Number( 1 );
+            while( ( m.Limbs()[ 0 ] & 1 ) == 0 )
+            {
+                m >>= 1;
+                ++twoAdicity_;
+            }
+            exponent_ = m >> 1;
+
+            constexpr T MAX_NON_RESIDUE = 1024;
+            Number minusOne = field_.Sub( Number( 0 ), field_.One() );
+            Number halfOrder = modulus >> 1;
+            Number candidate = field_.One();
+            T z = 2;
+            for( ; z < MAX_NON_RESIDUE; ++z )
+            {
+                field_.Add( candidate, field_.One(), candidate );
+                if( field_.Pow( candidate, halfOrder ) == minusOne )
+                {
+                    break;
+                }
+            }
+            [[unlikely]] if( z == MAX_NON_RESIDUE )
+            {
+                throw std::runtime_error( "Modulus is not prime" );
+            }
+            rootOfUnity_ = field_.Pow( candidate, m );
+        }
+    }
+
+    inline const Field& GetField() const noexcept
+    {
+        return field_;
+    }
+
+    inline Method GetMethod() const noexcept
+    {
+        return method_;
+    }
+
+    /**
+     * @brief root with root^2 = a, if there is one.
+     *
+     * @param[in] a Number in Montgomery form.
+     * @param[out] root Square root in Montgomery form, either of the two. Undefined if a is
+     * not a square.
+     *
+     * @return Whether a is a square.
+     */
+    bool Sqrt( const Number& a, Number& root ) const
+    {
+        switch( method_ )
+        {
+        case EXPONENT:
+            root = field_.Pow( a, exponent_ );
+            break;
+        case ATKIN:
+            root = Atkin( a );
+            break;
+        case TONELLI_SHANKS:
+            root = TonelliShanks( a );
+            break;
+        }
+        return field_.Sqr( root ) == a;
+    }
+
+private:
+    // b = ( 2a )^( ( p - 5 ) / 8 ), i = 2ab^2 is a square root of -1 for a square a, and
+    // root = ab( i - 1 ).
+    Number Atkin( const Number& a ) const
+    {
+        Number twiceA = field_.Add( a, a );
+        Number b = field_.Pow( twiceA, exponent_ );
+        Number i = field_.Mul( twiceA, field_.Sqr( b ) );
+        return field_.Mul( field_.Mul( a, b ), field_.Sub( i, field_.One() ) );
+    }
+
+    // Invariants: root^2 = a * t and t has order dividing 2^k, c has order 2^k. Each step
+    // halves the order of t by multiplying t by c^2 and root by c when t^( 2^( k - 2 ) ) is
+    // not 1, with selection instead of a branch.
+    Number TonelliShanks( const Number& a ) const
+    {
+        Number root = field_.Pow( a, exponent_ );
+        Number t = field_.Mul( field_.Sqr( root ), a );
+        field_.Mul( root, a, root );
+        Number c = rootOfUnity_;
+        Number b;
+        Number candidate;
+        for( size_t k = twoAdicity_; k > 1; --k )
+        {
+            b = t;
+            for( size_t j = 2; j < k; ++j )
+            {
+                field_.Mul( b, b, b );
+            }
+            T keep = static_cast< T >( 0 ) - static_cast< T >( b == field_.One() );
+            field_.Mul( root, c, candidate );
+            Select( root, root, candidate, keep );
+            field_.Mul( c, c, c );
+            field_.Mul( t, c, candidate );
+            Select( t, t, candidate, keep );
+        }
+        return root;
+    }
+
+    // r = mask ? a : b.
+    static void Select( Number& r, const Number& a, const Number& b, T mask )
+    {
+        T limbs[ LIMB_COUNT ];
+        for( size_t i = 0; i < LIMB_COUNT; ++i )
+        {
+            limbs[ i ] = ( a.Limbs()[ i ] & mask ) | ( b.Limbs()[ i ] & ~mask );
+        }
+        r.AssignLimbs( limbs );
+    }
+
+    Field field_;
+    Method method_;
+    Number exponent_;
+    size_t twoAdicity_;
+    Number rootOfUnity_;
+};
+
+} // namespace math
+
+} // namespace core
+
+} // namespace crypt_gost
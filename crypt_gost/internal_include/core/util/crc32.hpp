@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief CRC-32 of ISO-HDLC (zlib, PNG), reflected polynomial 0xEDB88320.
+ *
+ * @param[in] data Data.
+ * @param[in] size Size of data.
+ * @param[in] crc CRC of preceding data, to checksum data given in parts.
+ *
+ * @return uint32_t CRC of preceding data followed by \p data.
+ */
+uint32_t Crc32( const void* data, size_t size, uint32_t crc = 0 ) noexcept;
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
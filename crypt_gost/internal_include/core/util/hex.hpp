@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief Table-driven hexadecimal codec.
+ *
+ * Each byte is encoded with a single lookup of its two digits and each digit is decoded
+ * with a single lookup, so no per-character branching or iostream formatting is involved.
+ */
+namespace hex
+{
+
+namespace detail
+{
+
+struct Tables
+{
+    char encode[ 2 * 256 ];
+    int8_t decode[ 256 ];
+};
+
+constexpr Tables MakeTables() noexcept
+{
+    constexpr char DIGITS[] = "0123456789abcdef";
+    Tables tables{};
+    for( size_t i = 0; i < 256; ++i )
+    {
+        tables.encode[ 2 * i ] = DIGITS[ i >> 4 ];
+        tables.encode[ 2 * i + 1 ] = DIGITS[ i & 0x0f ];
+        tables.decode[ i ] = -1;
+    }
+    for( size_t i = 0; i < 10; ++i )
+    {
+        tables.decode[ '0' + i ] = static_cast< int8_t >( i );
+    }
+    for( size_t i = 0; i < 6; ++i )
+    {
+        tables.decode[ 'a' + i ] = static_cast< int8_t >( 10 + i );
+        tables.decode[ 'A' + i ] = static_cast< int8_t >( 10 + i );
+    }
+    return tables;
+}
+
+inline constexpr Tables TABLES = MakeTables();
+
+} // namespace detail
+
+/**
+ * @brief Write two lowercase hex digits of \p byte to \p out.
+ */
+inline void EncodeByte( char* out, uint8_t byte ) noexcept
+{
+    out[ 0 ] = detail::TABLES.encode[ 2 * byte ];
+    out[ 1 ] = detail::TABLES.encode[ 2 * byte + 1 ];
+}
+
+/**
+ * @brief Encode byte sequence.
+ *
+ * @param[out] out Buffer for 2 * size characters, no terminating null is written.
+ * @param[in] data Bytes to encode.
+ * @param[in] size Count of bytes.
+ */
+inline void Encode( char* out, const uint8_t* data, size_t size ) noexcept
+{
+    for( size_t i = 0; i < size; ++i )
+    {
+        EncodeByte( out + 2 * i, data[ i ] );
+    }
+}
+
+/**
+ * @brief Decode single hex digit of either case.
+ *
+ * @return int Digit value or -1 if \p c is not a hex digit.
+ */
+inline int DecodeDigit( char c ) noexcept
+{
+    return detail::TABLES.decode[ static_cast< uint8_t >( c ) ];
+}
+
+/**
+ * @brief Decode hex string of even length.
+ *
+ * @param[out] out Buffer for size / 2 bytes.
+ * @param[in] hex Characters to decode.
+ * @param[in] size Count of characters.
+ *
+ * @return bool False if \p size is odd or a character is not a hex digit.
+ */
+inline bool Decode( uint8_t* out, const char* hex, size_t size ) noexcept
+{
+    [[unlikely]] if( size % 2 != 0 )
+    {
+        return false;
+    }
+    for( size_t i = 0; i < size / 2; ++i )
+    {
+        int high = DecodeDigit( hex[ 2 * i ] );
+        int low = DecodeDigit( hex[ 2 * i + 1 ] );
+        [[unlikely]] if( ( high | low ) < 0 )
+        {
+            return false;
+        }
+        out[ i ] = static_cast< uint8_t >( ( high << 4 ) | low );
+    }
+    return true;
+}
+
+} // namespace hex
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
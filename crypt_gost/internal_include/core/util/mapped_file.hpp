@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <core/util/segment.hpp>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Pages are shared with other processes mapping the same file and are loaded on demand.
+ */
+class MappedFile final
+{
+public:
+    MappedFile() noexcept = default;
+
+    /**
+     * @brief Map file.
+     *
+     * @throw std::runtime_error If file cannot be opened or mapped, or is empty.
+     */
+    explicit MappedFile( const char* path );
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    MappedFile( MappedFile&& other ) noexcept;
+    MappedFile& operator=( MappedFile&& other ) noexcept;
+
+    ~MappedFile() noexcept;
+
+    inline const uint8_t* Data() const noexcept
+    {
+        return data_;
+    }
+
+    inline size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    void Unmap() noexcept;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Write concatenation of \p count segments to file \p path.
+ *
+ * Data is written to a new file with a unique name in the same directory, which is renamed
+ * to \p path, so that a concurrent MappedFile never sees a partially written file. The file
+ * is readable by all and writable by the owner.
+ *
+ * @throw std::runtime_error If the file cannot be written.
+ */
+void ReplaceFile( const char* path, const ConstSegment* segments, size_t count );
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
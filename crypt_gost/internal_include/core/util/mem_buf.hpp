@@ -38,6 +38,10 @@ public:
 
     MemBuf& operator=( const MemBuf& other )
     {
+        if( this == &other )
+        {
+            return *this;
+        }
         if( capacity_ < other.size_ || alignment_ != other.alignment_
             || !std::is_same< decltype( alloc_ ), decltype( other.alloc_ ) >::value )
         {
@@ -71,6 +75,10 @@ public:
 
     MemBuf& operator=( MemBuf&& other ) noexcept
     {
+        if( this == &other )
+        {
+            return *this;
+        }
         size_ = other.size_;
         capacity_ = other.capacity_;
         alignment_ = other.alignment_;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+namespace random
+{
+
+/**
+ * @brief Fill buffer with bytes from the operating system random number generator.
+ *
+ * @param[out] data Buffer.
+ * @param[in] size Size of buffer.
+ *
+ * @throw std::runtime_error If the generator fails.
+ */
+void Fill( uint8_t* data, size_t size );
+
+} // namespace random
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
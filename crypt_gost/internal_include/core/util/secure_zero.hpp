@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief Zero memory which held secret data.
+ *
+ * Unlike plain memset, the stores are kept by the compiler even if the memory is not read
+ * afterwards, e.g. is about to be released. Files compiled with target options include this
+ * header before them, so that the function is compiled for the baseline instruction set.
+ */
+inline void SecureZero( void* data, size_t size ) noexcept
+{
+    std::memset( data, 0, size );
+    __asm__ volatile( "" : : "r"( data ) : "memory" );
+}
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief Fragment of a buffer processed in place, as in a scatter/gather list.
+ */
+struct Segment
+{
+    uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief Fragment of a buffer which is only read.
+ */
+struct ConstSegment
+{
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief Sum of sizes of \p count segments.
+ */
+template < typename SegmentType >
+inline size_t TotalSize( const SegmentType* segments, size_t count ) noexcept
+{
+    size_t ret = 0;
+    for( size_t i = 0; i < count; ++i )
+    {
+        ret += segments[ i ].size;
+    }
+    return ret;
+}
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
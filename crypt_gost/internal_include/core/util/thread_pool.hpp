@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypt_gost
+{
+
+namespace core
+{
+
+namespace util
+{
+
+/**
+ * @brief Fixed set of worker threads running indexed tasks.
+ *
+ * Run executes task( 0 ) .. task( count - 1 ) and returns when all of them are done. The
+ * calling thread takes tasks as well, so a pool of one thread runs them in the caller and
+ * starts no workers. Tasks are taken in order of their indices, one at a time, which
+ * balances tasks of different duration. Run calls from different threads are serialized.
+ */
+class ThreadPool final
+{
+public:
+    /**
+     * @brief Start workers.
+     *
+     * @param[in] threadCount Number of threads including the caller of Run, 0 for the
+     * number of hardware threads.
+     *
+     * @throw std::runtime_error If a thread cannot be started.
+     */
+    explicit ThreadPool( size_t threadCount = 0 );
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    ~ThreadPool() noexcept;
+
+    inline size_t GetThreadCount() const noexcept
+    {
+        return workers_.size() + 1;
+    }
+
+    /**
+     * @brief Run \p count tasks, \p task is called with the index of a task and must not
+     * throw.
+     */
+    template < typename Task >
+    inline void Run( size_t count, const Task& task ) noexcept
+    {
+        Run( count, &Invoke< Task >, &task );
+    }
+
+private:
+    using TaskFn = void ( * )( const void* context, size_t index );
+
+    template < typename Task >
+    static void Invoke( const void* context, size_t index )
+    {
+        ( *static_cast< const Task* >( context ) )( index );
+    }
+
+    void Run( size_t count, TaskFn fn, const void* context ) noexcept;
+    void Work() noexcept;
+    void WorkerLoop() noexcept;
+    void Stop() noexcept;
+
+    std::vector< std::thread > workers_;
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    size_t generation_ = 0;
+    size_t busy_ = 0;
+    bool stop_ = false;
+    TaskFn fn_ = nullptr;
+    const void* context_ = nullptr;
+    size_t count_ = 0;
+    std::atomic< size_t > next_ = 0;
+};
+
+} // namespace util
+
+} // namespace core
+
+} // namespace crypt_gost
@@ -1,4 +1,7 @@
+#pragma once
+
 #include <type_traits>
+#include <cstdint>
 #include <cstdlib>
 
 namespace crypt_gost
@@ -25,22 +28,67 @@ constexpr size_t BitsNumberOf( T value ) noexcept
     return sizeof( value ) * 8;
 }
 
+/**
+ * @brief Unsigned integer type of twice the width of \p T, used for word products.
+ */
+template < typename T >
+struct DoubleWidth;
+
+template <>
+struct DoubleWidth< uint8_t >
+{
+    using type = uint16_t;
+};
+
+template <>
+struct DoubleWidth< uint16_t >
+{
+    using type = uint32_t;
+};
+
+template <>
+struct DoubleWidth< uint32_t >
+{
+    using type = uint64_t;
+};
+
+template <>
+struct DoubleWidth< uint64_t >
+{
+    using type = unsigned __int128;
+};
+
+template < typename T >
+using DoubleWidth_t = typename DoubleWidth< T >::type;
+
 static inline bool IsLittleEndian() noexcept
 {
     int32_t a = 1;
     return *( int8_t* )( &a ) == 1;
 }
 
+/**
+ * @brief Reverse byte order of an integer.
+ */
 template < typename T, std::enable_if_t< std::is_integral< T >::value, bool > = true >
-T ChangeByteOrdering( T number ) noexcept
+inline T ChangeByteOrdering( T number ) noexcept
 {
-    T ret = 0;
-    for( size_t i = 0; i < sizeof( T ); ++i )
+    if constexpr( sizeof( T ) == 8 )
+    {
+        return static_cast< T >( __builtin_bswap64( static_cast< uint64_t >( number ) ) );
+    }
+    else if constexpr( sizeof( T ) == 4 )
+    {
+        return static_cast< T >( __builtin_bswap32( static_cast< uint32_t >( number ) ) );
+    }
+    else if constexpr( sizeof( T ) == 2 )
+    {
+        return static_cast< T >( __builtin_bswap16( static_cast< uint16_t >( number ) ) );
+    }
+    else
     {
-        size_t tmp = ( ( uint8_t* )( &number ) )[ i ];
-        ret |= tmp << 8 * ( sizeof( T ) - i - 1 );
+        return number;
     }
-    return ret;
 }
 
 } // namespace traits
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cipher/cbc.hpp>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/magma.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+static const char* const KUZNYECHIK_KEY =
+    "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef";
+static const char* const MAGMA_KEY =
+    "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+template < typename Cipher >
+static void CheckExample( const char* key,
+                          const char* iv,
+                          const char* plaintext,
+                          const char* ciphertext )
+{
+    auto keyBytes = Bytes( key );
+    auto ivBytes = Bytes( iv );
+    auto expected = Bytes( ciphertext );
+    auto data = Bytes( plaintext );
+    Cbc< Cipher > encryptor( keyBytes.data(), ivBytes.data(), ivBytes.size() );
+    std::vector< uint8_t > out( data.size() );
+    encryptor.Encrypt( data.data(), out.data(), data.size() );
+    EXPECT_EQ( out, expected );
+
+    Cbc< Cipher > decryptor( keyBytes.data(), ivBytes.data(), ivBytes.size() );
+    decryptor.Decrypt( out.data(), out.data(), out.size() );
+    EXPECT_EQ( out, data );
+}
+
+// GOST R 34.13-2015, appendix A.1.4.
+TEST( CbcTest, KuznyechikStandardExample )
+{
+    CheckExample< Kuznyechik >( KUZNYECHIK_KEY,
+                                "1234567890abcef0a1b2c3d4e5f00112"
+                                "23344556677889901213141516171819",
+                                "1122334455667700ffeeddccbbaa9988"
+                                "00112233445566778899aabbcceeff0a"
+                                "112233445566778899aabbcceeff0a00"
+                                "2233445566778899aabbcceeff0a0011",
+                                "689972d4a085fa4d90e52e3d6d7dcc27"
+                                "2826e661b478eca6af1e8e448d5ea5ac"
+                                "fe7babf1e91999e85640e8b0f49d90d0"
+                                "167688065a895c631a2d9a1560b63970" );
+}
+
+// GOST R 34.13-2015, appendix A.2.4.
+TEST( CbcTest, MagmaStandardExample )
+{
+    CheckExample< Magma >( MAGMA_KEY,
+                           "1234567890abcdef234567890abcdef134567890abcdef12",
+                           "92def06b3c130a59db54c704f8189d204a98fb2e67a8024c8912409b17b57e41",
+                           "96d1b05eea683919aff76129abb937b95058b4a1c4bc001920b78b1a7cd7e667" );
+}
+
+// Calls of any number of blocks continue the chains.
+TEST( CbcTest, Chunks )
+{
+    auto key = Bytes( MAGMA_KEY );
+    auto iv = Data( 3 * Magma::BLOCK_SIZE );
+    auto data = Data( 5000 * Magma::BLOCK_SIZE );
+    std::vector< uint8_t > expected( data.size() );
+    Cbc< Magma >( key.data(), iv.data(), iv.size() )
+        .Encrypt( data.data(), expected.data(), data.size() );
+
+    Cbc< Magma > encryptor( key.data(), iv.data(), iv.size() );
+    Cbc< Magma > decryptor( key.data(), iv.data(), iv.size() );
+    std::vector< uint8_t > out( data.size() );
+    size_t offset = 0;
+    for( size_t blocks: { 1, 0, 2, 5, 1000, 3, 600 } )
+    {
+        encryptor.Encrypt( data.data() + offset, out.data() + offset, blocks * Magma::BLOCK_SIZE );
+        offset += blocks * Magma::BLOCK_SIZE;
+    }
+    encryptor.Encrypt( data.data() + offset, out.data() + offset, data.size() - offset );
+    EXPECT_EQ( out, expected );
+
+    offset = 0;
+    for( size_t blocks: { 2, 1, 513, 7 } )
+    {
+        decryptor.Decrypt( out.data() + offset, out.data() + offset, blocks * Magma::BLOCK_SIZE );
+        offset += blocks * Magma::BLOCK_SIZE;
+    }
+    decryptor.Decrypt( out.data() + offset, out.data() + offset, out.size() - offset );
+    EXPECT_EQ( out, data );
+
+    EXPECT_THROW( decryptor.Decrypt( out.data(), out.data(), 1 ), std::runtime_error );
+    EXPECT_THROW( Cbc< Magma >( key.data(), iv.data(), 0 ), std::runtime_error );
+    EXPECT_THROW( Cbc< Magma >( key.data(), iv.data(), 12 ), std::runtime_error );
+}
+
+// Tasks of the pool start from the ciphertext before them, also when decrypting in place.
+TEST( CbcTest, ThreadPool )
+{
+    util::ThreadPool pool( 4 );
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto data = Data( 62501 * Kuznyechik::BLOCK_SIZE );
+    for( size_t ivSize: { Kuznyechik::BLOCK_SIZE, 3 * Kuznyechik::BLOCK_SIZE } )
+    {
+        auto iv = Data( ivSize );
+        std::vector< uint8_t > ciphertext( data.size() );
+        Cbc< Kuznyechik >( key.data(), iv.data(), ivSize )
+            .Encrypt( data.data(), ciphertext.data(), data.size() );
+
+        Cbc< Kuznyechik > decryptor( key.data(), iv.data(), ivSize );
+        std::vector< uint8_t > out = ciphertext;
+        decryptor.Decrypt( out.data(), out.data(), 32, &pool );
+        decryptor.Decrypt( out.data() + 32, out.data() + 32, out.size() - 32, &pool );
+        EXPECT_EQ( out, data ) << ivSize;
+
+        Cbc< Kuznyechik > separate( key.data(), iv.data(), ivSize );
+        separate.Decrypt( ciphertext.data(), out.data(), out.size(), &pool );
+        EXPECT_EQ( out, data ) << ivSize;
+    }
+}
+
+// Blocks split between segments are gathered, the rest is processed in place.
+TEST( CbcTest, Segments )
+{
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto iv = Data( 2 * Kuznyechik::BLOCK_SIZE );
+    auto data = Data( 20000 * Kuznyechik::BLOCK_SIZE );
+    std::vector< uint8_t > expected( data.size() );
+    Cbc< Kuznyechik >( key.data(), iv.data(), iv.size() )
+        .Encrypt( data.data(), expected.data(), data.size() );
+    util::ThreadPool pool( 2 );
+    for( const std::vector< size_t >& sizes: { std::vector< size_t >{ 1, 7, 16, 3, 100, 0, 33 },
+                                                std::vector< size_t >{ 160003, 5 } } )
+    {
+        std::vector< uint8_t > out = data;
+        auto segments = Split( out.data(), out.size(), sizes );
+        Cbc< Kuznyechik > encryptor( key.data(), iv.data(), iv.size() );
+        encryptor.Encrypt( segments.data(), segments.size() );
+        EXPECT_EQ( out, expected );
+
+        Cbc< Kuznyechik > decryptor( key.data(), iv.data(), iv.size() );
+        decryptor.Decrypt( segments.data(), segments.size(), &pool );
+        EXPECT_EQ( out, data );
+    }
+
+    // Nothing is processed when the total size is not whole blocks.
+    std::vector< uint8_t > out = data;
+    auto segments = Split( out.data(), 33, { 16, 17 } );
+    Cbc< Kuznyechik > cbc( key.data(), iv.data(), iv.size() );
+    EXPECT_THROW( cbc.Encrypt( segments.data(), segments.size() ), std::runtime_error );
+    EXPECT_EQ( out, data );
+}
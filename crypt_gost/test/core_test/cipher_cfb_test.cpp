@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cipher/cfb.hpp>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/magma.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+static const char* const KUZNYECHIK_KEY =
+    "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef";
+static const char* const MAGMA_KEY =
+    "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+template < typename Cipher >
+static void CheckExample( const char* key,
+                          const char* iv,
+                          const char* plaintext,
+                          const char* ciphertext )
+{
+    auto keyBytes = Bytes( key );
+    auto ivBytes = Bytes( iv );
+    auto expected = Bytes( ciphertext );
+    auto data = Bytes( plaintext );
+    Cfb< Cipher > encryptor( keyBytes.data(), ivBytes.data(), ivBytes.size() );
+    std::vector< uint8_t > out( data.size() );
+    encryptor.Encrypt( data.data(), out.data(), data.size() );
+    EXPECT_EQ( out, expected );
+
+    Cfb< Cipher > decryptor( keyBytes.data(), ivBytes.data(), ivBytes.size() );
+    decryptor.Decrypt( out.data(), out.data(), out.size() );
+    EXPECT_EQ( out, data );
+}
+
+// GOST R 34.13-2015, appendix A.1.5.
+TEST( CfbTest, KuznyechikStandardExample )
+{
+    CheckExample< Kuznyechik >( KUZNYECHIK_KEY,
+                                "1234567890abcef0a1b2c3d4e5f00112"
+                                "23344556677889901213141516171819",
+                                "1122334455667700ffeeddccbbaa9988"
+                                "00112233445566778899aabbcceeff0a"
+                                "112233445566778899aabbcceeff0a00"
+                                "2233445566778899aabbcceeff0a0011",
+                                "81800a59b1842b24ff1f795e897abd95"
+                                "ed5b47a7048cfab48fb521369d9326bf"
+                                "79f2a8eb5cc68d38842d264e97a238b5"
+                                "4ffebecd4e922de6c75bd9dd44fbf4d1" );
+}
+
+// GOST R 34.13-2015, appendix A.2.5.
+TEST( CfbTest, MagmaStandardExample )
+{
+    CheckExample< Magma >( MAGMA_KEY,
+                           "1234567890abcdef234567890abcdef1",
+                           "92def06b3c130a59db54c704f8189d204a98fb2e67a8024c8912409b17b57e41",
+                           "db37e0e266903c830d46644c1f9a089c24bdd2035315d38bbcc0321421075505" );
+}
+
+// Calls of arbitrary sizes continue the stream, the last segment may be partial.
+TEST( CfbTest, Chunks )
+{
+    auto key = Bytes( MAGMA_KEY );
+    auto iv = Data( 3 * Magma::BLOCK_SIZE );
+    auto data = Data( 40003 );
+    std::vector< uint8_t > expected( data.size() );
+    Cfb< Magma >( key.data(), iv.data(), iv.size() )
+        .Encrypt( data.data(), expected.data(), data.size() );
+
+    Cfb< Magma > encryptor( key.data(), iv.data(), iv.size() );
+    Cfb< Magma > decryptor( key.data(), iv.data(), iv.size() );
+    std::vector< uint8_t > out( data.size() );
+    size_t offset = 0;
+    for( size_t size: { 3, 5, 8, 13, 0, 64, 7, 1000, 1, 129 } )
+    {
+        encryptor.Encrypt( data.data() + offset, out.data() + offset, size );
+        offset += size;
+    }
+    encryptor.Encrypt( data.data() + offset, out.data() + offset, data.size() - offset );
+    EXPECT_EQ( out, expected );
+
+    offset = 0;
+    for( size_t size: { 1, 15, 4097, 2 } )
+    {
+        decryptor.Decrypt( out.data() + offset, out.data() + offset, size );
+        offset += size;
+    }
+    decryptor.Decrypt( out.data() + offset, out.data() + offset, out.size() - offset );
+    EXPECT_EQ( out, data );
+
+    EXPECT_THROW( Cfb< Magma >( key.data(), iv.data(), 0 ), std::runtime_error );
+    EXPECT_THROW( Cfb< Magma >( key.data(), iv.data(), 12 ), std::runtime_error );
+}
+
+// Tasks of the pool start from the ciphertext before them, also when decrypting in place.
+TEST( CfbTest, ThreadPool )
+{
+    util::ThreadPool pool( 4 );
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto data = Data( 1000003 );
+    for( size_t ivSize: { Kuznyechik::BLOCK_SIZE, 3 * Kuznyechik::BLOCK_SIZE } )
+    {
+        auto iv = Data( ivSize );
+        std::vector< uint8_t > ciphertext( data.size() );
+        Cfb< Kuznyechik >( key.data(), iv.data(), ivSize )
+            .Encrypt( data.data(), ciphertext.data(), data.size() );
+
+        Cfb< Kuznyechik > decryptor( key.data(), iv.data(), ivSize );
+        std::vector< uint8_t > out = ciphertext;
+        decryptor.Decrypt( out.data(), out.data(), 37, &pool );
+        decryptor.Decrypt( out.data() + 37, out.data() + 37, out.size() - 37, &pool );
+        EXPECT_EQ( out, data ) << ivSize;
+
+        Cfb< Kuznyechik > separate( key.data(), iv.data(), ivSize );
+        separate.Decrypt( ciphertext.data(), out.data(), out.size(), &pool );
+        EXPECT_EQ( out, data ) << ivSize;
+    }
+}
+
+// Segments in place give the result of a contiguous buffer, with blocks split anywhere.
+TEST( CfbTest, Segments )
+{
+    auto key = Bytes( MAGMA_KEY );
+    auto iv = Data( 2 * Magma::BLOCK_SIZE );
+    auto data = Data( 300001 );
+    std::vector< uint8_t > expected( data.size() );
+    Cfb< Magma >( key.data(), iv.data(), iv.size() )
+        .Encrypt( data.data(), expected.data(), data.size() );
+    util::ThreadPool pool( 2 );
+    for( const std::vector< size_t >& sizes: { std::vector< size_t >{ 1, 7, 16, 3, 100, 0, 33 },
+                                                std::vector< size_t >{ 150001, 5 } } )
+    {
+        std::vector< uint8_t > out = data;
+        auto segments = Split( out.data(), out.size(), sizes );
+        Cfb< Magma > encryptor( key.data(), iv.data(), iv.size() );
+        encryptor.Encrypt( segments.data(), segments.size() );
+        EXPECT_EQ( out, expected );
+
+        Cfb< Magma > decryptor( key.data(), iv.data(), iv.size() );
+        decryptor.Decrypt( segments.data(), segments.size(), &pool );
+        EXPECT_EQ( out, data );
+    }
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cipher/ctr.hpp>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/magma.hpp>
+#include <core/util/segment.hpp>
+#include <core/util/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+static const char* const KUZNYECHIK_KEY =
+    "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef";
+static const char* const MAGMA_KEY =
+    "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+template < typename Cipher >
+static std::vector< uint8_t > Encrypt( const char* key,
+                                       const std::vector< uint8_t >& iv,
+                                       size_t sectionSize,
+                                       const std::vector< uint8_t >& data,
+                                       util::ThreadPool* pool = nullptr )
+{
+    auto keyBytes = Bytes( key );
+    Ctr< Cipher > ctr( keyBytes.data(), iv.data(), sectionSize );
+    std::vector< uint8_t > ret( data.size() );
+    ctr.Process( data.data(), ret.data(), data.size(), pool );
+    return ret;
+}
+
+// GOST R 34.13-2015, appendix A.1.2.
+TEST( CtrTest, KuznyechikStandardExample )
+{
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto iv = Bytes( "1234567890abcef0" );
+    auto plaintext = Bytes( "1122334455667700ffeeddccbbaa9988"
+                            "00112233445566778899aabbcceeff0a"
+                            "112233445566778899aabbcceeff0a00"
+                            "2233445566778899aabbcceeff0a0011" );
+    auto ciphertext = Bytes( "f195d8bec10ed1dbd57b5fa240bda1b8"
+                             "85eee733f6a13e5df33ce4b33c45dee4"
+                             "a5eae88be6356ed3d5e877f13564a3a5"
+                             "cb91fab1f20cbab6d1c6d15820bdba73" );
+    EXPECT_EQ( Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, 0, plaintext ), ciphertext );
+
+    Ctr< Kuznyechik > ctr( key.data(), iv.data() );
+    std::vector< uint8_t > data = ciphertext;
+    ctr.Process( data.data(), data.data(), data.size() );
+    EXPECT_EQ( data, plaintext );
+}
+
+// GOST R 34.13-2015, appendix A.2.2.
+TEST( CtrTest, MagmaStandardExample )
+{
+    auto iv = Bytes( "12345678" );
+    auto plaintext = Bytes( "92def06b3c130a59db54c704f8189d204a98fb2e67a8024c8912409b17b57e41" );
+    auto ciphertext = Bytes( "4e98110c97b7b93c3e250d93d6e85d69136d868807b2dbef568eb680ab52a12d" );
+    EXPECT_EQ( Encrypt< Magma >( MAGMA_KEY, iv, 0, plaintext ), ciphertext );
+}
+
+// RFC 8645, appendix A.1, section size N = 256 bits.
+TEST( CtrTest, KuznyechikAcpkmExample )
+{
+    auto iv = Bytes( "1234567890abcef0" );
+    auto plaintext = Bytes( "1122334455667700ffeeddccbbaa9988"
+                            "00112233445566778899aabbcceeff0a"
+                            "112233445566778899aabbcceeff0a00"
+                            "2233445566778899aabbcceeff0a0011"
+                            "33445566778899aabbcceeff0a001122"
+                            "445566778899aabbcceeff0a00112233"
+                            "5566778899aabbcceeff0a0011223344" );
+    auto ciphertext = Bytes( "f195d8bec10ed1dbd57b5fa240bda1b8"
+                             "85eee733f6a13e5df33ce4b33c45dee4"
+                             "4bceeb8f646f4c55001706275e85e800"
+                             "587c4df568d094393e4834afd0805046"
+                             "cf30f57686aeece11cfc6c316b8a896e"
+                             "dffd07ec813636460c4f3b743423163e"
+                             "6409a9c282fac8d469d221e7fbd6de5d" );
+    EXPECT_EQ( Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, 32, plaintext ), ciphertext );
+    EXPECT_EQ( Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, 32, ciphertext ), plaintext );
+}
+
+// RFC 8645, appendix A.2, section size N = 128 bits. The key is the one of A.1.
+TEST( CtrTest, MagmaAcpkmExample )
+{
+    auto iv = Bytes( "12345678" );
+    auto plaintext = Bytes( "1122334455667700ffeeddccbbaa9988"
+                            "00112233445566778899aabbcceeff0a"
+                            "112233445566778899aabbcceeff0a00"
+                            "2233445566778899aabbcceeff0a0011"
+                            "33445566778899aabbcceeff0a001122"
+                            "445566778899aabbcceeff0a00112233"
+                            "5566778899aabbcceeff0a0011223344" );
+    auto ciphertext = Bytes( "2ab81deeeb1e4cab68e104c4bd6b94ea"
+                             "c72c67af6c2e5b6b0eafb61770f1b32e"
+                             "a1ae71149eed1382abd467180672ec6f"
+                             "84a2f15b3fca72c15559fbd38c4c7c5d"
+                             "a90d5adbbd3d22f92b2283b686439fb4"
+                             "796fa8a3fe3b7ec39e48c896f90e1097"
+                             "a9351073a37a742c0569c8d445faeac5" );
+    EXPECT_EQ( Encrypt< Magma >( KUZNYECHIK_KEY, iv, 16, plaintext ), ciphertext );
+    EXPECT_EQ( Encrypt< Magma >( KUZNYECHIK_KEY, iv, 16, ciphertext ), plaintext );
+}
+
+// Every section after the first is encrypted under E_K( 0x80 .. 0x9f ) of the previous key,
+// with the counter continued.
+TEST( CtrTest, AcpkmSections )
+{
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto iv = Bytes( "1234567890abcef0" );
+    constexpr size_t SECTION_SIZE = 2 * Kuznyechik::BLOCK_SIZE;
+    auto data = Data( 3 * SECTION_SIZE );
+    auto ciphertext = Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, SECTION_SIZE, data );
+
+    uint8_t d[ Kuznyechik::KEY_SIZE ];
+    for( size_t i = 0; i < sizeof( d ); ++i )
+    {
+        d[ i ] = static_cast< uint8_t >( 0x80 + i );
+    }
+    Kuznyechik cipher( key.data() );
+    uint8_t counter[ Kuznyechik::BLOCK_SIZE ] = {};
+    std::memcpy( counter, iv.data(), iv.size() );
+    std::vector< uint8_t > expected( data.size() );
+    for( size_t i = 0; i < data.size() / Kuznyechik::BLOCK_SIZE; ++i )
+    {
+        if( i != 0 && i % 2 == 0 )
+        {
+            uint8_t next[ Kuznyechik::KEY_SIZE ];
+            cipher.EncryptBlocks( d, next, 2 );
+            cipher.SetKey( next );
+        }
+        counter[ Kuznyechik::BLOCK_SIZE - 1 ] = static_cast< uint8_t >( i );
+        uint8_t gamma[ Kuznyechik::BLOCK_SIZE ];
+        cipher.EncryptBlock( counter, gamma );
+        for( size_t j = 0; j < Kuznyechik::BLOCK_SIZE; ++j )
+        {
+            size_t index = i * Kuznyechik::BLOCK_SIZE + j;
+            expected[ index ] = data[ index ] ^ gamma[ j ];
+        }
+    }
+    EXPECT_EQ( ciphertext, expected );
+
+    // The first section is plain CTR.
+    auto ctr = Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, 0, data );
+    EXPECT_TRUE( std::equal( ctr.begin(), ctr.begin() + SECTION_SIZE, ciphertext.begin() ) );
+    EXPECT_FALSE( std::equal( ctr.begin() + SECTION_SIZE, ctr.end(), ciphertext.begin() ) );
+
+    EXPECT_THROW( Ctr< Kuznyechik >( key.data(), iv.data(), SECTION_SIZE + 1 ),
+                  std::runtime_error );
+}
+
+// Calls of arbitrary sizes continue the stream.
+TEST( CtrTest, Chunks )
+{
+    auto key = Bytes( MAGMA_KEY );
+    auto iv = Bytes( "12345678" );
+    auto data = Data( 5000 );
+    for( size_t sectionSize: { size_t( 0 ), size_t( 64 ), size_t( 1024 ) } )
+    {
+        auto expected = Encrypt< Magma >( MAGMA_KEY, iv, sectionSize, data );
+        Ctr< Magma > ctr( key.data(), iv.data(), sectionSize );
+        std::vector< uint8_t > out( data.size() );
+        size_t offset = 0;
+        for( size_t size: { 3, 5, 8, 13, 0, 64, 7, 1000, 1, 129 } )
+        {
+            ctr.Process( data.data() + offset, out.data() + offset, size );
+            offset += size;
+        }
+        ctr.Process( data.data() + offset, out.data() + offset, data.size() - offset );
+        EXPECT_EQ( out, expected ) << sectionSize;
+    }
+}
+
+// Tasks of the pool produce the same stream, also starting inside a block and a section.
+TEST( CtrTest, ThreadPool )
+{
+    util::ThreadPool pool( 4 );
+    auto data = Data( 1000003 );
+    auto kuznyechikKey = Bytes( KUZNYECHIK_KEY );
+    auto kuznyechikIv = Bytes( "1234567890abcef0" );
+    auto magmaKey = Bytes( MAGMA_KEY );
+    auto magmaIv = Bytes( "12345678" );
+    for( size_t sectionSize: { size_t( 0 ), size_t( 4096 ), size_t( 65536 ) } )
+    {
+        auto expected = Encrypt< Kuznyechik >( KUZNYECHIK_KEY, kuznyechikIv, sectionSize, data );
+        Ctr< Kuznyechik > ctr( kuznyechikKey.data(), kuznyechikIv.data(), sectionSize );
+        std::vector< uint8_t > out( data.size() );
+        ctr.Process( data.data(), out.data(), 4103 );
+        ctr.Process( data.data() + 4103, out.data() + 4103, data.size() - 4103, &pool );
+        EXPECT_EQ( out, expected ) << sectionSize;
+
+        expected = Encrypt< Magma >( MAGMA_KEY, magmaIv, sectionSize, data );
+        EXPECT_EQ( Encrypt< Magma >( MAGMA_KEY, magmaIv, sectionSize, data, &pool ), expected )
+            << sectionSize;
+    }
+}
+
+// Segments in place give the stream of a contiguous buffer, with blocks split anywhere.
+TEST( CtrTest, Segments )
+{
+    auto key = Bytes( KUZNYECHIK_KEY );
+    auto iv = Bytes( "1234567890abcef0" );
+    auto data = Data( 300000 );
+    auto expected = Encrypt< Kuznyechik >( KUZNYECHIK_KEY, iv, 4096, data );
+    util::ThreadPool pool( 2 );
+    for( const std::vector< size_t >& sizes: { std::vector< size_t >{ 1, 7, 16, 3, 100, 0, 33 },
+                                                std::vector< size_t >{ 150001, 5 } } )
+    {
+        std::vector< uint8_t > out = data;
+        auto segments = Split( out.data(), out.size(), sizes );
+        Ctr< Kuznyechik > ctr( key.data(), iv.data(), 4096 );
+        ctr.Process( segments.data(), segments.size(), &pool );
+        EXPECT_EQ( out, expected );
+    }
+}
+
+// Jobs under different keys match separate contexts, also when they cross the buffer of
+// counters, and invalid jobs are reported without touching other jobs.
+template < typename Cipher >
+static void CheckProcessMany()
+{
+    using Job = typename Ctr< Cipher >::Job;
+    using JobStatus = typename Ctr< Cipher >::JobStatus;
+    const size_t SIZES[] = { 0, 1, 15, 16, 17, 100, 5000, 3, 64, 40000, 8, 250 };
+    const size_t COUNT = sizeof( SIZES ) / sizeof( SIZES[ 0 ] );
+    std::vector< std::vector< uint8_t > > keys;
+    std::vector< std::vector< uint8_t > > ivs;
+    std::vector< Cipher > ciphers;
+    std::vector< std::vector< uint8_t > > data;
+    std::vector< std::vector< uint8_t > > expected;
+    ciphers.reserve( COUNT );
+    for( size_t j = 0; j < COUNT; ++j )
+    {
+        keys.emplace_back( Cipher::KEY_SIZE, static_cast< uint8_t >( j * 13 + 1 ) );
+        ivs.emplace_back( Ctr< Cipher >::IV_SIZE, static_cast< uint8_t >( j * 29 + 7 ) );
+        ciphers.emplace_back( keys[ j ].data() );
+        data.push_back( Data( SIZES[ j ] + j ) );
+        expected.emplace_back( data[ j ].size() );
+        Ctr< Cipher > ctr( keys[ j ].data(), ivs[ j ].data() );
+        ctr.Process( data[ j ].data(), expected[ j ].data(), data[ j ].size() );
+    }
+
+    std::vector< Job > jobs;
+    for( size_t j = 0; j < COUNT; ++j )
+    {
+        jobs.push_back( { &ciphers[ j ],
+                          ivs[ j ].data(),
+                          data[ j ].data(),
+                          data[ j ].size(),
+                          JobStatus::INVALID_ARGUMENTS } );
+    }
+    std::vector< uint8_t > untouched = data[ 1 ];
+    jobs[ 1 ].cipher = nullptr;
+    jobs.push_back( { &ciphers[ 0 ], ivs[ 0 ].data(), nullptr, 1, JobStatus::COMPLETED } );
+
+    Ctr< Cipher >::ProcessMany( jobs.data(), jobs.size() );
+    for( size_t j = 0; j < COUNT; ++j )
+    {
+        if( j == 1 )
+        {
+            EXPECT_EQ( jobs[ j ].status, JobStatus::INVALID_ARGUMENTS );
+            EXPECT_EQ( data[ j ], untouched );
+            continue;
+        }
+        EXPECT_EQ( jobs[ j ].status, JobStatus::COMPLETED ) << j;
+        EXPECT_EQ( data[ j ], expected[ j ] ) << j;
+    }
+    EXPECT_EQ( jobs.back().status, JobStatus::INVALID_ARGUMENTS );
+}
+
+TEST( CtrTest, ProcessMany )
+{
+    CheckProcessMany< Kuznyechik >();
+    CheckProcessMany< Magma >();
+}
@@ -0,0 +1,160 @@
+#include <cstring>
+#include <vector>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cpu/cpu_features.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+// GOST R 34.12-2015, appendix A.1.
+TEST( KuznyechikTest, StandardExample )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    auto plaintext = Bytes( "1122334455667700ffeeddccbbaa9988" );
+    auto ciphertext = Bytes( "7f679d90bebc24305a468d42b9d4edcd" );
+    Kuznyechik cipher( key.data() );
+
+    uint8_t block[ Kuznyechik::BLOCK_SIZE ];
+    cipher.EncryptBlock( plaintext.data(), block );
+    EXPECT_EQ( std::vector< uint8_t >( block, block + sizeof( block ) ), ciphertext );
+    cipher.DecryptBlock( block, block );
+    EXPECT_EQ( std::vector< uint8_t >( block, block + sizeof( block ) ), plaintext );
+}
+
+TEST( KuznyechikTest, Blocks )
+{
+    constexpr size_t COUNT = 37;
+    std::vector< uint8_t > key( Kuznyechik::KEY_SIZE );
+    std::vector< uint8_t > data( COUNT * Kuznyechik::BLOCK_SIZE );
+    for( size_t i = 0; i < key.size(); ++i )
+    {
+        key[ i ] = static_cast< uint8_t >( 7 * i + 1 );
+    }
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * i );
+    }
+    Kuznyechik cipher( key.data() );
+
+    std::vector< uint8_t > encrypted( data.size() );
+    cipher.EncryptBlocks( data.data(), encrypted.data(), COUNT );
+    for( size_t i = 0; i < COUNT; ++i )
+    {
+        uint8_t block[ Kuznyechik::BLOCK_SIZE ];
+        cipher.EncryptBlock( data.data() + i * Kuznyechik::BLOCK_SIZE, block );
+        EXPECT_EQ( std::memcmp( block, encrypted.data() + i * Kuznyechik::BLOCK_SIZE,
+                                Kuznyechik::BLOCK_SIZE ),
+                   0 );
+    }
+    std::vector< uint8_t > decrypted( encrypted );
+    cipher.DecryptBlocks( decrypted.data(), decrypted.data(), COUNT );
+    EXPECT_EQ( decrypted, data );
+
+    // Context is reusable for another key.
+    key[ 0 ] ^= 1;
+    cipher.SetKey( key.data() );
+    std::vector< uint8_t > other( data.size() );
+    cipher.EncryptBlocks( data.data(), other.data(), COUNT );
+    EXPECT_NE( other, encrypted );
+    Kuznyechik fresh( key.data() );
+    fresh.DecryptBlocks( other.data(), other.data(), COUNT );
+    EXPECT_EQ( other, data );
+}
+
+class KuznyechikKernelTest : public FeatureMaskTest
+{
+};
+
+// Vector kernels agree with single blocks for whole batches, padded and short tails.
+TEST_P( KuznyechikKernelTest, EncryptBlocks )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    Kuznyechik cipher( key.data() );
+    for( size_t count: { 1, 3, 8, 13, 31, 32, 33, 64, 75, 200 } )
+    {
+        std::vector< uint8_t > data( count * Kuznyechik::BLOCK_SIZE );
+        for( size_t i = 0; i < data.size(); ++i )
+        {
+            data[ i ] = static_cast< uint8_t >( i * 31 + count );
+        }
+        std::vector< uint8_t > expected( data.size() );
+        for( size_t i = 0; i < count; ++i )
+        {
+            cipher.DecryptBlock( data.data() + i * Kuznyechik::BLOCK_SIZE,
+                                 expected.data() + i * Kuznyechik::BLOCK_SIZE );
+        }
+
+        // Encryption is checked as the inverse of table-driven decryption.
+        std::vector< uint8_t > actual( expected );
+        cipher.EncryptBlocks( actual.data(), actual.data(), count );
+        EXPECT_EQ( actual, data ) << count;
+    }
+}
+
+TEST_P( KuznyechikKernelTest, DecryptBlocks )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    Kuznyechik cipher( key.data() );
+    for( size_t count: { 1, 3, 8, 13, 31, 32, 33, 64, 75, 200 } )
+    {
+        std::vector< uint8_t > data( count * Kuznyechik::BLOCK_SIZE );
+        for( size_t i = 0; i < data.size(); ++i )
+        {
+            data[ i ] = static_cast< uint8_t >( i * 29 + count );
+        }
+        std::vector< uint8_t > expected( data.size() );
+        for( size_t i = 0; i < count; ++i )
+        {
+            cipher.EncryptBlock( data.data() + i * Kuznyechik::BLOCK_SIZE,
+                                 expected.data() + i * Kuznyechik::BLOCK_SIZE );
+        }
+
+        std::vector< uint8_t > actual( expected );
+        cipher.DecryptBlocks( actual.data(), actual.data(), count );
+        EXPECT_EQ( actual, data ) << count;
+    }
+}
+
+// Every block is encrypted with its own key, batches under one key and mixed keys alike.
+TEST_P( KuznyechikKernelTest, EncryptBlocksMultiKey )
+{
+    std::vector< Kuznyechik > ciphers;
+    for( size_t k = 0; k < 5; ++k )
+    {
+        std::vector< uint8_t > key( Kuznyechik::KEY_SIZE );
+        for( size_t i = 0; i < key.size(); ++i )
+        {
+            key[ i ] = static_cast< uint8_t >( i * 17 + k * 101 );
+        }
+        ciphers.emplace_back( key.data() );
+    }
+    for( size_t count: { 1, 3, 8, 13, 31, 32, 33, 64, 75, 200 } )
+    {
+        std::vector< uint8_t > data( count * Kuznyechik::BLOCK_SIZE );
+        for( size_t i = 0; i < data.size(); ++i )
+        {
+            data[ i ] = static_cast< uint8_t >( i * 23 + count );
+        }
+        std::vector< const Kuznyechik* > keys( count );
+        std::vector< uint8_t > expected( data.size() );
+        for( size_t i = 0; i < count; ++i )
+        {
+            size_t k = i % 2 == 0 ? i % ciphers.size() : i / 7 % ciphers.size();
+            keys[ i ] = &ciphers[ count >= 128 && i < 64 ? 0 : k ];
+            keys[ i ]->EncryptBlock( data.data() + i * Kuznyechik::BLOCK_SIZE,
+                                     expected.data() + i * Kuznyechik::BLOCK_SIZE );
+        }
+
+        std::vector< uint8_t > actual( data );
+        Kuznyechik::EncryptBlocksMultiKey( keys.data(), actual.data(), actual.data(), count );
+        EXPECT_EQ( actual, expected ) << count;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         KuznyechikKernelTest,
+                         ::testing::Values( 0u, cpu::FEATURE_AVX2 | cpu::FEATURE_GFNI, ~0u ) );
@@ -0,0 +1,104 @@
+#include <cstring>
+#include <vector>
+#include <core/cipher/magma.hpp>
+#include <core/cpu/cpu_features.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+static const char* const KEY = "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// GOST R 34.12-2015, appendix A.2.
+TEST( MagmaTest, StandardExample )
+{
+    auto key = Bytes( KEY );
+    auto plaintext = Bytes( "fedcba9876543210" );
+    auto ciphertext = Bytes( "4ee901e5c2d8ca3d" );
+    Magma cipher( key.data() );
+
+    uint8_t block[ Magma::BLOCK_SIZE ];
+    cipher.EncryptBlock( plaintext.data(), block );
+    EXPECT_EQ( std::vector< uint8_t >( block, block + sizeof( block ) ), ciphertext );
+    cipher.DecryptBlock( block, block );
+    EXPECT_EQ( std::vector< uint8_t >( block, block + sizeof( block ) ), plaintext );
+}
+
+TEST( MagmaTest, SetKey )
+{
+    auto key = Bytes( KEY );
+    auto plaintext = Bytes( "fedcba9876543210" );
+    auto ciphertext = Bytes( "4ee901e5c2d8ca3d" );
+    std::vector< uint8_t > other( Magma::KEY_SIZE, 0x5a );
+    Magma cipher( other.data() );
+
+    uint8_t block[ Magma::BLOCK_SIZE ];
+    cipher.EncryptBlock( plaintext.data(), block );
+    EXPECT_NE( std::vector< uint8_t >( block, block + sizeof( block ) ), ciphertext );
+    cipher.SetKey( key.data() );
+    cipher.EncryptBlock( plaintext.data(), block );
+    EXPECT_EQ( std::vector< uint8_t >( block, block + sizeof( block ) ), ciphertext );
+}
+
+// Runs of blocks under one key and single blocks under alternating keys.
+TEST( MagmaTest, EncryptBlocksMultiKey )
+{
+    auto key = Bytes( KEY );
+    std::vector< uint8_t > other( Magma::KEY_SIZE, 0x5a );
+    Magma first( key.data() );
+    Magma second( other.data() );
+    const size_t COUNT = 100;
+    std::vector< uint8_t > data( COUNT * Magma::BLOCK_SIZE );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 41 );
+    }
+    std::vector< const Magma* > ciphers( COUNT );
+    std::vector< uint8_t > expected( data.size() );
+    for( size_t i = 0; i < COUNT; ++i )
+    {
+        ciphers[ i ] = i < 40 || i % 3 == 0 ? &first : &second;
+        ciphers[ i ]->EncryptBlock( data.data() + i * Magma::BLOCK_SIZE,
+                                    expected.data() + i * Magma::BLOCK_SIZE );
+    }
+    Magma::EncryptBlocksMultiKey( ciphers.data(), data.data(), data.data(), COUNT );
+    EXPECT_EQ( data, expected );
+}
+
+class MagmaKernelTest : public FeatureMaskTest
+{
+};
+
+// Vector kernels agree with single blocks for whole batches, padded and short tails.
+TEST_P( MagmaKernelTest, Blocks )
+{
+    auto key = Bytes( KEY );
+    Magma cipher( key.data() );
+    for( size_t count: { 1, 5, 11, 12, 31, 32, 33, 64, 77, 300 } )
+    {
+        std::vector< uint8_t > data( count * Magma::BLOCK_SIZE );
+        for( size_t i = 0; i < data.size(); ++i )
+        {
+            data[ i ] = static_cast< uint8_t >( i * 37 + count );
+        }
+        std::vector< uint8_t > expected( data.size() );
+        for( size_t i = 0; i < count; ++i )
+        {
+            cipher.EncryptBlock( data.data() + i * Magma::BLOCK_SIZE,
+                                 expected.data() + i * Magma::BLOCK_SIZE );
+        }
+
+        std::vector< uint8_t > actual( data );
+        cipher.EncryptBlocks( actual.data(), actual.data(), count );
+        EXPECT_EQ( actual, expected ) << count;
+        cipher.DecryptBlocks( actual.data(), actual.data(), count );
+        EXPECT_EQ( actual, data ) << count;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         MagmaKernelTest,
+                         ::testing::Values( 0u, cpu::FEATURE_AVX2 ) );
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/magma.hpp>
+#include <core/cipher/mgm.hpp>
+#include <core/cpu/cpu_features.hpp>
+#include <core/util/segment.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+/**
+ * @brief Test vector of RFC 9058, appendix A.
+ */
+struct Vector
+{
+    const char* key;
+    const char* nonce;
+    const char* aad;
+    const char* plaintext;
+    const char* ciphertext;
+    const char* tag;
+};
+
+static const Vector KUZNYECHIK_VECTOR = {
+    "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef",
+    "1122334455667700ffeeddccbbaa9988",
+    "0202020202020202010101010101010104040404040404040303030303030303ea0505050505050505",
+    "1122334455667700ffeeddccbbaa998800112233445566778899aabbcceeff0a112233445566778899aabbcc"
+    "eeff0a002233445566778899aabbcceeff0a0011aabbcc",
+    "a9757b8147956e9055b8a33de89f42fc8075d2212bf9fd5bd3f7069aadc16b39497ab15915a6ba85936b5d0e"
+    "a9f6851cc60c14d4d3f883d0ab94420695c76deb2c7552",
+    "cf5d656f40c34f5c46e8bb0e29fcdb4c",
+};
+
+static const Vector MAGMA_VECTOR = {
+    "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+    "12def06b3c130a59",
+    "01010101010101010202020202020202030303030303030304040404040404040505050505050505ea",
+    "ffeeddccbbaa998811223344556677008899aabbcceeff0a0011223344556677"
+    "99aabbcceeff0a001122334455667788aabbcceeff0a00112233445566778899aabbcc",
+    "c795066c5f9ea03b85113342459185ae1f2e00d6bf2b785d940470b8bb9c8e7d9a5dd3731f7ddc70ec27cb0a"
+    "ce6fa57670f65c646abb75d547aa37c3bcb5c34e03bb9c",
+    "a7928069aa10fd10",
+};
+
+// sum ^= h * x bit by bit, with the low terms of the field polynomial in \p reduction.
+static void ReferenceMultiplySum( uint8_t* sum,
+                                  const uint8_t* h,
+                                  const uint8_t* x,
+                                  size_t size,
+                                  uint8_t reduction )
+{
+    std::vector< uint8_t > r( size );
+    for( size_t bit = 0; bit < 8 * size; ++bit )
+    {
+        uint8_t carry = r[ 0 ] >> 7;
+        for( size_t i = 0; i + 1 < size; ++i )
+        {
+            r[ i ] = static_cast< uint8_t >( r[ i ] << 1 | r[ i + 1 ] >> 7 );
+        }
+        r[ size - 1 ] = static_cast< uint8_t >( r[ size - 1 ] << 1 ^ ( carry ? reduction : 0 ) );
+        if( x[ bit / 8 ] >> ( 7 - bit % 8 ) & 1 )
+        {
+            for( size_t i = 0; i < size; ++i )
+            {
+                r[ i ] ^= h[ i ];
+            }
+        }
+    }
+    for( size_t i = 0; i < size; ++i )
+    {
+        sum[ i ] ^= r[ i ];
+    }
+}
+
+class MgmTest : public FeatureMaskTest
+{
+};
+
+template < typename Cipher >
+static void CheckVector( const Vector& vector )
+{
+    auto key = Bytes( vector.key );
+    auto nonce = Bytes( vector.nonce );
+    auto aad = Bytes( vector.aad );
+    auto plaintext = Bytes( vector.plaintext );
+    auto ciphertext = Bytes( vector.ciphertext );
+    auto tag = Bytes( vector.tag );
+    Mgm< Cipher > mgm( key.data() );
+
+    std::vector< uint8_t > out( plaintext.size() );
+    uint8_t computed[ Mgm< Cipher >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Encrypt( plaintext.data(), out.data(), plaintext.size() );
+    mgm.Final( computed );
+    EXPECT_EQ( out, ciphertext );
+    EXPECT_EQ( std::vector< uint8_t >( computed, computed + sizeof( computed ) ), tag );
+
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Decrypt( ciphertext.data(), out.data(), ciphertext.size() );
+    EXPECT_TRUE( mgm.Verify( tag.data() ) );
+    EXPECT_EQ( out, plaintext );
+}
+
+TEST_P( MgmTest, KuznyechikStandardExample )
+{
+    CheckVector< Kuznyechik >( KUZNYECHIK_VECTOR );
+}
+
+TEST_P( MgmTest, MagmaStandardExample )
+{
+    CheckVector< Magma >( MAGMA_VECTOR );
+}
+
+TEST_P( MgmTest, MultiplySum )
+{
+    std::vector< uint8_t > h( 16 * 37 );
+    std::vector< uint8_t > x( h.size() );
+    for( size_t i = 0; i < h.size(); ++i )
+    {
+        h[ i ] = static_cast< uint8_t >( i * 97 + 13 );
+        x[ i ] = static_cast< uint8_t >( i * 29 ^ ( i >> 3 ) );
+    }
+    // Top bits set in both halves exercise both reduction steps.
+    std::memset( h.data(), 0xff, 16 );
+    std::memset( x.data(), 0xff, 16 );
+    for( size_t count: { 0, 1, 2, 37 } )
+    {
+        uint8_t expected[ 16 ] = { 1, 2, 3 };
+        uint8_t sum[ 16 ] = { 1, 2, 3 };
+        for( size_t i = 0; i < count; ++i )
+        {
+            ReferenceMultiplySum( expected, h.data() + 16 * i, x.data() + 16 * i, 16, 0x87 );
+        }
+        mgm::MultiplySum128( sum, h.data(), x.data(), count );
+        EXPECT_EQ( std::memcmp( sum, expected, 16 ), 0 ) << count;
+
+        std::memcpy( expected, sum, 8 );
+        for( size_t i = 0; i < 2 * count; ++i )
+        {
+            ReferenceMultiplySum( expected, h.data() + 8 * i, x.data() + 8 * i, 8, 0x1b );
+        }
+        mgm::MultiplySum64( sum, h.data(), x.data(), 2 * count );
+        EXPECT_EQ( std::memcmp( sum, expected, 8 ), 0 ) << count;
+    }
+}
+
+// Calls of arbitrary sizes give the same result as whole buffers.
+TEST_P( MgmTest, Chunks )
+{
+    auto key = Bytes( KUZNYECHIK_VECTOR.key );
+    auto nonce = Bytes( KUZNYECHIK_VECTOR.nonce );
+    std::vector< uint8_t > aad( 1000 );
+    std::vector< uint8_t > data( 5000 );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 131 );
+        aad[ i % aad.size() ] ^= static_cast< uint8_t >( i );
+    }
+    Mgm< Kuznyechik > mgm( key.data() );
+
+    std::vector< uint8_t > expected( data.size() );
+    uint8_t expectedTag[ Mgm< Kuznyechik >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Encrypt( data.data(), expected.data(), data.size() );
+    mgm.Final( expectedTag );
+
+    std::vector< uint8_t > out = data;
+    uint8_t tag[ Mgm< Kuznyechik >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    size_t offset = 0;
+    for( size_t size: { 0, 1, 15, 16, 17, 100, 3 } )
+    {
+        mgm.UpdateAad( aad.data() + offset, size );
+        offset += size;
+    }
+    mgm.UpdateAad( aad.data() + offset, aad.size() - offset );
+    offset = 0;
+    for( size_t size: { 5, 11, 0, 16, 1, 1000, 2000, 7 } )
+    {
+        mgm.Encrypt( out.data() + offset, out.data() + offset, size );
+        offset += size;
+    }
+    mgm.Encrypt( out.data() + offset, out.data() + offset, out.size() - offset );
+    mgm.Final( tag );
+    EXPECT_EQ( out, expected );
+    EXPECT_EQ( std::memcmp( tag, expectedTag, sizeof( tag ) ), 0 );
+
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    offset = 0;
+    for( size_t size: { 3, 3000, 1 } )
+    {
+        mgm.Decrypt( out.data() + offset, out.data() + offset, size );
+        offset += size;
+    }
+    mgm.Decrypt( out.data() + offset, out.data() + offset, out.size() - offset );
+    EXPECT_TRUE( mgm.Verify( tag, 8 ) );
+    EXPECT_EQ( out, data );
+}
+
+TEST_P( MgmTest, Forgery )
+{
+    auto key = Bytes( MAGMA_VECTOR.key );
+    auto nonce = Bytes( MAGMA_VECTOR.nonce );
+    auto aad = Bytes( MAGMA_VECTOR.aad );
+    auto plaintext = Bytes( MAGMA_VECTOR.plaintext );
+    Mgm< Magma > mgm( key.data() );
+
+    std::vector< uint8_t > ciphertext( plaintext.size() );
+    uint8_t tag[ Mgm< Magma >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Encrypt( plaintext.data(), ciphertext.data(), ciphertext.size() );
+    mgm.Final( tag );
+
+    std::vector< uint8_t > out( plaintext.size() );
+    ciphertext[ 20 ] ^= 4;
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Decrypt( ciphertext.data(), out.data(), out.size() );
+    EXPECT_FALSE( mgm.Verify( tag ) );
+    ciphertext[ 20 ] ^= 4;
+
+    aad.pop_back();
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Decrypt( ciphertext.data(), out.data(), out.size() );
+    EXPECT_FALSE( mgm.Verify( tag ) );
+
+    mgm.Start( nonce.data() );
+    mgm.Encrypt( plaintext.data(), out.data(), 1 );
+    EXPECT_THROW( mgm.UpdateAad( aad.data(), 1 ), std::runtime_error );
+    EXPECT_THROW( mgm.Final( tag, 0 ), std::runtime_error );
+    EXPECT_THROW( mgm.Final( tag, Mgm< Magma >::TAG_SIZE + 1 ), std::runtime_error );
+}
+
+// Associated data and payload in segments give the result of contiguous buffers.
+TEST_P( MgmTest, Segments )
+{
+    auto key = Bytes( KUZNYECHIK_VECTOR.key );
+    auto nonce = Bytes( KUZNYECHIK_VECTOR.nonce );
+    std::vector< uint8_t > aad( 300 );
+    std::vector< uint8_t > data( 5000 );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 131 );
+        aad[ i % aad.size() ] ^= static_cast< uint8_t >( i );
+    }
+    Mgm< Kuznyechik > mgm( key.data() );
+    std::vector< uint8_t > expected( data.size() );
+    uint8_t expectedTag[ Mgm< Kuznyechik >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aad.data(), aad.size() );
+    mgm.Encrypt( data.data(), expected.data(), data.size() );
+    mgm.Final( expectedTag );
+
+    const util::ConstSegment aadSegments[] = {
+        { aad.data(), 5 }, { aad.data() + 5, 0 }, { aad.data() + 5, 20 }, { aad.data() + 25, 275 }
+    };
+    std::vector< uint8_t > out = data;
+    auto segments = Split( out.data(), out.size(), { 1, 7, 16, 3, 100, 0, 33 } );
+    uint8_t tag[ Mgm< Kuznyechik >::TAG_SIZE ];
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aadSegments, 4 );
+    mgm.Encrypt( segments.data(), segments.size() );
+    mgm.Final( tag );
+    EXPECT_EQ( out, expected );
+    EXPECT_EQ( std::memcmp( tag, expectedTag, sizeof( tag ) ), 0 );
+
+    mgm.Start( nonce.data() );
+    mgm.UpdateAad( aadSegments, 4 );
+    mgm.Decrypt( segments.data(), segments.size() );
+    EXPECT_TRUE( mgm.Verify( tag ) );
+    EXPECT_EQ( out, data );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest, MgmTest, ::testing::Values( 0u, ~0u ) );
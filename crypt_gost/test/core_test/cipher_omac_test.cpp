@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cipher/kuznyechik.hpp>
+#include <core/cipher/magma.hpp>
+#include <core/cipher/omac.hpp>
+#include <core/util/segment.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::cipher;
+
+template < typename Cipher >
+static std::vector< uint8_t > Mac( Omac< Cipher >& omac,
+                                   const std::vector< uint8_t >& data,
+                                   size_t tagSize )
+{
+    std::vector< uint8_t > ret( tagSize );
+    omac.Update( data.data(), data.size() );
+    omac.Final( ret.data(), tagSize );
+    return ret;
+}
+
+// GOST R 34.13-2015, appendix A.1.6.
+TEST( OmacTest, KuznyechikStandardExample )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    auto data = Bytes( "1122334455667700ffeeddccbbaa9988"
+                       "00112233445566778899aabbcceeff0a"
+                       "112233445566778899aabbcceeff0a00"
+                       "2233445566778899aabbcceeff0a0011" );
+    Omac< Kuznyechik > omac( key.data() );
+    EXPECT_EQ( Mac( omac, data, 8 ), Bytes( "336f4d296059fbe3" ) );
+}
+
+// GOST R 34.13-2015, appendix A.2.6.
+TEST( OmacTest, MagmaStandardExample )
+{
+    auto key = Bytes( "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff" );
+    auto data = Bytes( "92def06b3c130a59db54c704f8189d204a98fb2e67a8024c8912409b17b57e41" );
+    Omac< Magma > omac( key.data() );
+    EXPECT_EQ( Mac( omac, data, 4 ), Bytes( "154e7210" ) );
+    auto tag = Bytes( "154e7210" );
+    EXPECT_FALSE( omac.Verify( tag.data(), 4 ) );
+    omac.Update( data.data(), data.size() );
+    EXPECT_TRUE( omac.Verify( tag.data(), 4 ) );
+    EXPECT_THROW( omac.Final( data.data(), 0 ), std::runtime_error );
+    EXPECT_THROW( omac.Final( data.data(), Omac< Magma >::TAG_SIZE + 1 ), std::runtime_error );
+}
+
+// Calls of arbitrary sizes give the MAC of the whole message, which is padded unless it ends
+// with a whole block.
+TEST( OmacTest, Chunks )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    Omac< Kuznyechik > omac( key.data() );
+    std::vector< uint8_t > data( 100 );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 7 + 3 );
+    }
+    std::vector< std::vector< uint8_t > > tags;
+    for( size_t size: { 0, 1, 15, 16, 17, 32, 100 } )
+    {
+        std::vector< uint8_t > message( data.begin(), data.begin() + size );
+        auto expected = Mac( omac, message, Omac< Kuznyechik >::TAG_SIZE );
+        for( size_t step: { 1, 5, 16 } )
+        {
+            for( size_t offset = 0; offset < size; offset += step )
+            {
+                omac.Update( message.data() + offset, std::min( step, size - offset ) );
+            }
+            std::vector< uint8_t > tag( Omac< Kuznyechik >::TAG_SIZE );
+            omac.Final( tag.data() );
+            EXPECT_EQ( tag, expected ) << size << " " << step;
+        }
+        tags.push_back( expected );
+    }
+    for( size_t i = 1; i < tags.size(); ++i )
+    {
+        EXPECT_NE( tags[ i ], tags[ i - 1 ] );
+    }
+}
+
+// Messages of different lengths in several groups give the tags of single messages.
+TEST( OmacTest, MacMany )
+{
+    auto key = Bytes( "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff" );
+    Omac< Magma > omac( key.data() );
+    constexpr size_t COUNT = 150;
+    std::vector< std::vector< uint8_t > > data( COUNT );
+    std::vector< Omac< Magma >::Message > messages( COUNT );
+    for( size_t i = 0; i < COUNT; ++i )
+    {
+        data[ i ].resize( i * 37 % 101 );
+        for( size_t j = 0; j < data[ i ].size(); ++j )
+        {
+            data[ i ][ j ] = static_cast< uint8_t >( i + j * 3 );
+        }
+        messages[ i ] = { data[ i ].data(), data[ i ].size() };
+    }
+    constexpr size_t TAG_SIZE = 6;
+    std::vector< uint8_t > tags( COUNT * TAG_SIZE );
+    omac.Update( data[ 1 ].data(), data[ 1 ].size() );
+    omac.MacMany( messages.data(), COUNT, tags.data(), TAG_SIZE );
+    // The current message is kept.
+    std::vector< uint8_t > tag( TAG_SIZE );
+    omac.Final( tag.data(), TAG_SIZE );
+    EXPECT_TRUE( std::equal( tag.begin(), tag.end(), tags.begin() + TAG_SIZE ) );
+
+    for( size_t i = 0; i < COUNT; ++i )
+    {
+        auto expected = Mac( omac, data[ i ], TAG_SIZE );
+        EXPECT_TRUE( std::equal( expected.begin(), expected.end(), tags.begin() + i * TAG_SIZE ) )
+            << i;
+    }
+}
+
+TEST( OmacTest, Segments )
+{
+    auto key = Bytes( "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef" );
+    Omac< Kuznyechik > omac( key.data() );
+    std::vector< uint8_t > data( 1000 );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 7 + 3 );
+    }
+    auto expected = Mac( omac, data, Omac< Kuznyechik >::TAG_SIZE );
+    auto segments =
+        Split< util::ConstSegment >( data.data(), data.size(), { 1, 7, 16, 3, 100, 0, 33 } );
+    omac.Update( segments.data(), segments.size() );
+    EXPECT_TRUE( omac.Verify( expected.data() ) );
+}
@@ -0,0 +1,370 @@
+#include <core/ec/fixed_base.hpp>
+#include <core/ec/msm.hpp>
+#include <core/ec/point_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace crypt_gost::core::ec;
+
+template < size_t bitSize >
+static void CheckParams( const CurveParams& params )
+{
+    Curve< bitSize > curve( params );
+    const auto& base = curve.Base();
+    EXPECT_TRUE( curve.IsOnCurve( base ) );
+    EXPECT_FALSE( curve.Mul( base, curve.Order() - 1 ).infinity );
+    EXPECT_TRUE( curve.Mul( base, curve.Order() ).infinity );
+}
+
+class CurveParams256Test : public ::testing::TestWithParam< const CurveParams* >
+{
+};
+
+class CurveParams512Test : public ::testing::TestWithParam< const CurveParams* >
+{
+};
+
+TEST_P( CurveParams256Test, BasePointOrder )
+{
+    CheckParams< 256 >( *GetParam() );
+}
+
+TEST_P( CurveParams512Test, BasePointOrder )
+{
+    CheckParams< 512 >( *GetParam() );
+}
+
+TEST( CurveTest, GroupLaw )
+{
+    using Number = Curve< 256 >::Number;
+    Curve< 256 > curve( GostTestParamSet256() );
+    const auto& base = curve.Base();
+
+    auto twice = curve.Double( base );
+    auto thrice = curve.Add( twice, base );
+    EXPECT_TRUE( curve.IsOnCurve( twice ) );
+    EXPECT_TRUE( curve.IsOnCurve( thrice ) );
+    EXPECT_EQ( thrice.x, curve.Mul( base, Number( 3 ) ).x );
+    EXPECT_EQ( curve.Add( base, twice ).x, thrice.x );
+    EXPECT_TRUE( curve.Add( base, curve.Negate( base ) ).infinity );
+    EXPECT_EQ( curve.Add( base, Curve< 256 >::Point() ).x, base.x );
+
+    Number x;
+    Number y;
+    curve.ToAffine( base, x, y );
+    EXPECT_EQ( x, Number( 2 ) );
+    EXPECT_THROW( curve.FromAffine( x, y + Number( 1 ) ), std::runtime_error );
+    EXPECT_THROW( curve.ToAffine( Curve< 256 >::Point(), x, y ), std::runtime_error );
+    EXPECT_THROW( Curve< 256 > wrongSize( Tc26ParamSet512A() ), std::runtime_error );
+}
+
+TEST( CurveTest, FixedBaseTable )
+{
+    using Number = Curve< 256 >::Number;
+    Curve< 256 > curve( Tc26ParamSet256A() );
+    FixedBaseTable< 256 > table( curve, curve.Base() );
+
+    EXPECT_TRUE( table.Mul( Number( 0 ) ).infinity );
+    for( Number k: { Number( 1 ),
+                     Number( 16 ),
+                     Number( 0x1234567 ),
+                     curve.Order() - Number( 1 ),
+                     ( curve.Order() >> 3 ) + Number( 0xf0f ) } )
+    {
+        auto expected = curve.Mul( curve.Base(), k );
+        auto actual = table.Mul( k );
+        ASSERT_FALSE( actual.infinity );
+        EXPECT_EQ( actual.x, expected.x );
+        EXPECT_EQ( actual.y, expected.y );
+    }
+}
+
+template < size_t bitSize >
+static void CheckFixedBaseOperationCounts( const CurveParams& params )
+{
+    // The sequence of operations must not depend on the scalar, exceptional additions would
+    // leak it. Timing is compared by the fixed base benchmark.
+    using Number = typename Curve< bitSize >::Number;
+    Curve< bitSize > curve( params );
+    FixedBaseTable< bitSize > table( curve, curve.Base() );
+    const Number scalars[] = {
+        Number( 1 ),
+        ( curve.Order() >> ( bitSize / 2 + 2 ) ) << ( bitSize / 2 ),
+        ( curve.Order() >> 2 ) + Number( 0x123456789 ),
+        curve.Order() - Number( 1 ),
+    };
+
+    OperationCounters expected;
+    for( size_t i = 0; i < std::size( scalars ); ++i )
+    {
+        operationCounters = {};
+        EXPECT_FALSE( table.Mul( scalars[ i ] ).infinity );
+        OperationCounters actual = operationCounters;
+        EXPECT_EQ( actual.shortcuts, 0u ) << i;
+        EXPECT_EQ( actual.doublings, 0u ) << i;
+        EXPECT_GT( actual.additions, 0u ) << i;
+        if( i == 0 )
+        {
+            expected = actual;
+        }
+        EXPECT_EQ( actual.additions, expected.additions ) << i;
+        EXPECT_EQ( actual.tableScans, expected.tableScans ) << i;
+    }
+}
+
+TEST( CurveTest, FixedBaseTableOperationCounts )
+{
+    CheckFixedBaseOperationCounts< 256 >( Tc26ParamSet256A() );
+    CheckFixedBaseOperationCounts< 256 >( Tc26ParamSet256B() );
+    CheckFixedBaseOperationCounts< 512 >( Tc26ParamSet512A() );
+}
+
+TEST( CurveTest, FixedBaseTableFile )
+{
+    using Number = Curve< 256 >::Number;
+    Curve< 256 > curve( Tc26ParamSet256A() );
+    Curve< 256 > other( Tc26ParamSet256B() );
+    std::string path = testing::TempDir() + "fixed_base_table_test.bin";
+    FixedBaseTable< 256 > table( curve, curve.Base() );
+    table.Save( path.c_str() );
+
+    auto mapped = FixedBaseTable< 256 >::Load( curve, curve.Base(), path.c_str() );
+    EXPECT_TRUE( mapped.IsMapped() );
+    EXPECT_FALSE( table.IsMapped() );
+    for( Number k: { Number( 0 ), Number( 0x1234567 ), curve.Order() - Number( 1 ) } )
+    {
+        auto expected = table.Mul( k );
+        auto actual = mapped.Mul( k );
+        EXPECT_EQ( actual.infinity, expected.infinity );
+        EXPECT_EQ( actual.x, expected.x );
+        EXPECT_EQ( actual.y, expected.y );
+    }
+
+    EXPECT_THROW( FixedBaseTable< 256 >::Load( other, other.Base(), path.c_str() ),
+                  std::runtime_error );
+    EXPECT_THROW( FixedBaseTable< 256 >::Load( curve, curve.Double( curve.Base() ), path.c_str() ),
+                  std::runtime_error );
+
+    {
+        std::fstream file( path, std::ios::binary | std::ios::in | std::ios::out );
+        file.seekg( 1000 );
+        char byte = static_cast< char >( file.get() ^ 1 );
+        file.seekp( 1000 );
+        file.put( byte );
+    }
+    EXPECT_THROW( FixedBaseTable< 256 >::Load( curve, curve.Base(), path.c_str() ),
+                  std::runtime_error );
+    std::remove( path.c_str() );
+    EXPECT_THROW( FixedBaseTable< 256 >::Load( curve, curve.Base(), path.c_str() ),
+                  std::runtime_error );
+}
+
+TEST( CurveTest, FixedBaseTableFileEntries )
+{
+    // Swapped entries are valid points, and the file checksum is updated.
+    Curve< 256 > curve( Tc26ParamSet256B() );
+    std::string path = testing::TempDir() + "fixed_base_table_entries_test.bin";
+    FixedBaseTable< 256 >( curve, curve.Base() ).Save( path.c_str() );
+    EXPECT_NO_THROW( FixedBaseTable< 256 >::Load( curve, curve.Base(), path.c_str() ) );
+
+    std::vector< uint8_t > data;
+    {
+        std::ifstream file( path, std::ios::binary );
+        data.assign( std::istreambuf_iterator< char >( file ), {} );
+    }
+    constexpr size_t CHECKSUM_OFFSET = 28;
+    constexpr size_t DATA_OFFSET_OFFSET = 40;
+    constexpr size_t ENTRY_SIZE = 64;
+    uint64_t dataOffset;
+    std::memcpy( &dataOffset, data.data() + DATA_OFFSET_OFFSET, sizeof( dataOffset ) );
+    uint8_t* entry = data.data() + dataOffset + 20 * ENTRY_SIZE;
+    std::swap_ranges( entry, entry + ENTRY_SIZE, entry + ENTRY_SIZE );
+    std::memset( data.data() + CHECKSUM_OFFSET, 0, sizeof( uint32_t ) );
+    uint32_t crc = crypt_gost::core::util::Crc32( data.data(), data.size() );
+    std::memcpy( data.data() + CHECKSUM_OFFSET, &crc, sizeof( crc ) );
+    {
+        std::ofstream file( path, std::ios::binary | std::ios::trunc );
+        file.write( reinterpret_cast< const char* >( data.data() ), data.size() );
+    }
+    EXPECT_THROW( FixedBaseTable< 256 >::Load( curve, curve.Base(), path.c_str() ),
+                  std::runtime_error );
+    std::remove( path.c_str() );
+}
+
+TEST( CurveTest, Models )
+{
+    EXPECT_EQ( Curve< 256 >( GostTestParamSet256() ).GetModel(), Curve< 256 >::WEIERSTRASS );
+    EXPECT_EQ( Curve< 256 >( Tc26ParamSet256B() ).GetModel(),
+               Curve< 256 >::WEIERSTRASS_A_MINUS_3 );
+    EXPECT_EQ( Curve< 256 >( Tc26ParamSet256A() ).GetModel(), Curve< 256 >::TWISTED_EDWARDS );
+    EXPECT_EQ( Curve< 512 >( Tc26ParamSet512C() ).GetModel(), Curve< 512 >::TWISTED_EDWARDS );
+}
+
+// Twisted Edwards and Jacobian arithmetic on the same curve give the same points.
+template < size_t bitSize >
+static void CheckEdwardsForm( const CurveParams& params )
+{
+    using Number = typename Curve< bitSize >::Number;
+    CurveParams weierstrassParams = params;
+    weierstrassParams.e = nullptr;
+    weierstrassParams.d = nullptr;
+    Curve< bitSize > edwards( params );
+    Curve< bitSize > weierstrass( weierstrassParams );
+    ASSERT_EQ( weierstrass.GetModel(), Curve< bitSize >::WEIERSTRASS );
+
+    Number x;
+    Number y;
+    Number expectedX;
+    Number expectedY;
+    for( Number k: { Number( 2 ), Number( 0xdeadbeef ), edwards.Order() - Number( 5 ) } )
+    {
+        edwards.ToAffine( edwards.Mul( edwards.Base(), k ), x, y );
+        weierstrass.ToAffine( weierstrass.Mul( weierstrass.Base(), k ), expectedX, expectedY );
+        EXPECT_EQ( x, expectedX );
+        EXPECT_EQ( y, expectedY );
+        EXPECT_TRUE( edwards.IsOnCurve( edwards.FromAffine( x, y ) ) );
+    }
+
+    // Full projective addition agrees with mixed addition.
+    auto base = edwards.ToProjective( edwards.Base() );
+    typename Curve< bitSize >::Projective twice;
+    typename Curve< bitSize >::Projective sum;
+    edwards.Double( twice, base );
+    edwards.Add( sum, twice, base );
+    EXPECT_EQ( edwards.Normalize( sum ).x, edwards.Mul( edwards.Base(), Number( 3 ) ).x );
+    EXPECT_TRUE( edwards.Add( edwards.Base(), edwards.Negate( edwards.Base() ) ).infinity );
+}
+
+TEST( CurveTest, EdwardsForm )
+{
+    CheckEdwardsForm< 256 >( Tc26ParamSet256A() );
+    CheckEdwardsForm< 512 >( Tc26ParamSet512C() );
+}
+
+TEST( CurveTest, JacobianAddition )
+{
+    using Number = Curve< 256 >::Number;
+    for( const CurveParams* params: { &GostTestParamSet256(), &Tc26ParamSet256C() } )
+    {
+        Curve< 256 > curve( *params );
+        auto base = curve.ToProjective( curve.Base() );
+        Curve< 256 >::Projective twice;
+        Curve< 256 >::Projective sum;
+        curve.Double( twice, base );
+        curve.Add( sum, twice, base );
+        curve.Add( sum, sum, twice );
+        EXPECT_EQ( curve.Normalize( sum ).y, curve.Mul( curve.Base(), Number( 5 ) ).y );
+        curve.Add( sum, base, base );
+        EXPECT_EQ( curve.Normalize( sum ).x, curve.Normalize( twice ).x );
+        curve.Add( sum, sum, curve.Neutral() );
+        EXPECT_EQ( curve.Normalize( sum ).x, curve.Normalize( twice ).x );
+    }
+}
+
+TEST( CurveTest, MultiScalarMul )
+{
+    using Number = Curve< 256 >::Number;
+    for( const CurveParams* params: { &Tc26ParamSet256A(), &Tc26ParamSet256B() } )
+    {
+        Curve< 256 > curve( *params );
+        std::vector< Curve< 256 >::Point > points;
+        std::vector< Number > scalars;
+        Curve< 256 >::Point expected;
+        for( uint64_t i = 1; i <= 40; ++i )
+        {
+            points.push_back( curve.Mul( curve.Base(), Number( i * 0x9e3779b97f4a7c15 ) ) );
+            Number scalar = ( curve.Order() >> ( i % 7 ) ) - Number( i );
+            scalars.push_back( scalar );
+            expected = curve.Add( expected, curve.Mul( points.back(), scalar ) );
+        }
+        // Repeated point, which hits doubling in a bucket.
+        points.push_back( points[ 0 ] );
+        scalars.push_back( scalars[ 0 ] );
+        expected = curve.Add( expected, curve.Mul( points[ 0 ], scalars[ 0 ] ) );
+
+        auto actual = MultiScalarMul( curve, points.data(), scalars.data(), points.size() );
+        EXPECT_EQ( actual.x, expected.x );
+        EXPECT_EQ( actual.y, expected.y );
+        EXPECT_TRUE( MultiScalarMul( curve, points.data(), scalars.data(), 0 ).infinity );
+    }
+}
+
+TEST( CurveTest, Lift )
+{
+    using Number = Curve< 256 >::Number;
+    Curve< 256 > curve( Tc26ParamSet256B() );
+    Number x;
+    Number y;
+    Curve< 256 >::Point point;
+    curve.ToAffine( curve.Mul( curve.Base(), Number( 12345 ) ), x, y );
+    bool odd = ( y.Limbs()[ 0 ] & 1 ) != 0;
+    ASSERT_TRUE( curve.Lift( x, odd, point ) );
+    EXPECT_EQ( point.y, curve.FromAffine( x, y ).y );
+    ASSERT_TRUE( curve.Lift( x, !odd, point ) );
+    EXPECT_EQ( point.y, curve.Negate( curve.FromAffine( x, y ) ).y );
+
+    // p = 1 mod 8. x = 2 is the base point, and x^3 + ax + b is not a square for x = 1.
+    Curve< 256 > example( GostTestParamSet256() );
+    ASSERT_TRUE( example.Lift( Number( 2 ), false, point ) );
+    EXPECT_TRUE( example.IsOnCurve( point ) );
+    EXPECT_FALSE( example.Lift( Number( 1 ), false, point ) );
+}
+
+template < size_t bitSize >
+static void CheckPointTable( const CurveParams& params )
+{
+    using Number = typename Curve< bitSize >::Number;
+    Curve< bitSize > curve( params );
+    auto point = curve.Mul( curve.Base(), Number( 0x5eed ) );
+    PointTable< bitSize > table( curve, point );
+    const Number& q = curve.Order();
+    for( Number k: { Number( 1 ),
+                     Number( 2 ),
+                     Number( 31 ),
+                     Number( 32 ),
+                     Number( 33 ),
+                     q - Number( 1 ),
+                     q - Number( 2 ),
+                     ( q >> 1 ) + Number( 0x123456789 ) } )
+    {
+        auto expected = curve.Mul( point, k );
+        auto actual = table.Mul( k );
+        ASSERT_FALSE( actual.infinity );
+        EXPECT_EQ( actual.x, expected.x );
+        EXPECT_EQ( actual.y, expected.y );
+    }
+    EXPECT_THROW( table.Mul( Number( 0 ) ), std::runtime_error );
+    EXPECT_THROW( table.Mul( q ), std::runtime_error );
+    EXPECT_THROW( PointTable< bitSize >( curve, typename Curve< bitSize >::Point() ),
+                  std::runtime_error );
+}
+
+TEST( CurveTest, PointTable )
+{
+    CheckPointTable< 256 >( GostTestParamSet256() );
+    CheckPointTable< 256 >( Tc26ParamSet256A() );
+    CheckPointTable< 256 >( Tc26ParamSet256B() );
+    CheckPointTable< 512 >( Tc26ParamSet512B() );
+    CheckPointTable< 512 >( Tc26ParamSet512C() );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         CurveParams256Test,
+                         ::testing::Values( &GostTestParamSet256(),
+                                            &Tc26ParamSet256A(),
+                                            &Tc26ParamSet256B(),
+                                            &Tc26ParamSet256C(),
+                                            &Tc26ParamSet256D() ) );
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         CurveParams512Test,
+                         ::testing::Values( &Tc26ParamSet512A(),
+                                            &Tc26ParamSet512B(),
+                                            &Tc26ParamSet512C() ) );
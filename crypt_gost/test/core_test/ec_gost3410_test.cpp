@@ -0,0 +1,297 @@
+#include <core/ec/gost3410.hpp>
+#include <core/hash/streebog.hpp>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+using namespace crypt_gost::core::ec;
+
+template < size_t bitSize >
+static typename Gost3410< bitSize >::Number Hex( const char* hex )
+{
+    typename Gost3410< bitSize >::Number ret;
+    ret.FromHex( hex );
+    return ret;
+}
+
+// GOST R 34.10-2012, appendix A.1.
+TEST( Gost3410Test, StandardExample )
+{
+    Gost3410< 256 > gost( GostTestParamSet256() );
+    auto d = Hex< 256 >( "7a929ade789bb9be10ed359dd39a72c11b60961f49397eee1d19ce9891ec3b28" );
+    auto alpha = Hex< 256 >( "2dfbc1b372d89a1188c09c52e0eec61fce52032ab1022e8e67ece6672b043ee5" );
+    auto k = Hex< 256 >( "77105c9b20bcd3122823c8cf6fcc7b956de33814e95b7fe64fed924594dceab3" );
+
+    auto key = gost.DerivePublicKey( d );
+    EXPECT_EQ( key.x,
+               Hex< 256 >( "7f2b49e270db6d90d8595bec458b50c58585ba1d4e9b788f6689dbd8e56fd80b" ) );
+    EXPECT_EQ( key.y,
+               Hex< 256 >( "26f1b489d6701dd185c8413a977b3cbbaf64d1c593d26627dffb101a87ff77da" ) );
+
+    auto signature = gost.Sign( alpha, d, k );
+    EXPECT_EQ( signature.r,
+               Hex< 256 >( "41aa28d2f1ab148280cd9ed56feda41974053554a42767b83ad043fd39dc0493" ) );
+    EXPECT_EQ( signature.s,
+               Hex< 256 >( "01456c64ba4642a1653c235a98a60249bcd6d3f746b631df928014f6c5bf9c40" ) );
+    EXPECT_TRUE( gost.Verify( alpha, signature, key ) );
+
+    auto forged = signature;
+    forged.s += 1;
+    EXPECT_FALSE( gost.Verify( alpha, forged, key ) );
+    EXPECT_FALSE( gost.Verify( alpha + 1, signature, key ) );
+    forged.r = 0;
+    EXPECT_FALSE( gost.Verify( alpha, forged, key ) );
+
+    EXPECT_THROW( gost.Sign( alpha, d, 0 ), std::runtime_error );
+    EXPECT_THROW( gost.DerivePublicKey( gost.GetCurve().Order() ), std::runtime_error );
+    key.y += 1;
+    EXPECT_THROW( gost.Verify( alpha, signature, key ), std::runtime_error );
+}
+
+template < size_t bitSize >
+static void RoundTrip( const CurveParams& params )
+{
+    Gost3410< bitSize > gost( params );
+    auto d = gost.GeneratePrivateKey();
+    auto key = gost.DerivePublicKey( d );
+    typename Gost3410< bitSize >::Number alpha = 0x1234;
+    alpha <<= bitSize - 16;
+    alpha += 0xabcdef;
+    for( int i = 0; i < 3; ++i )
+    {
+        auto signature = gost.Sign( alpha, d );
+        ASSERT_TRUE( gost.Verify( alpha, signature, key ) );
+        ASSERT_FALSE( gost.Verify( alpha + 1, signature, key ) );
+        alpha += 1;
+    }
+}
+
+TEST( Gost3410Test, RoundTrip256 )
+{
+    RoundTrip< 256 >( Tc26ParamSet256A() );
+    RoundTrip< 256 >( Tc26ParamSet256B() );
+}
+
+TEST( Gost3410Test, RoundTrip512 )
+{
+    RoundTrip< 512 >( Tc26ParamSet512A() );
+    RoundTrip< 512 >( Tc26ParamSet512C() );
+}
+
+template < size_t bitSize >
+static void BatchVerify( const CurveParams& params, bool canonical )
+{
+    using Gost = Gost3410< bitSize >;
+    Gost gost( params );
+    std::vector< typename Gost::VerificationItem > items;
+    for( int key = 0; key < 4; ++key )
+    {
+        auto d = gost.GeneratePrivateKey();
+        auto publicKey = gost.DerivePublicKey( d );
+        for( uint64_t i = 0; i < 6; ++i )
+        {
+            typename Gost::Number alpha = i * 0x1000193 + key;
+            items.push_back( { alpha, gost.Sign( alpha, d ), publicKey } );
+        }
+        // Signature with explicit nonce is not canonical in general.
+        typename Gost::Number alpha = 0xabc;
+        items.push_back( { alpha, gost.Sign( alpha, d, d ), publicKey } );
+    }
+
+    bool results[ 32 ];
+    ASSERT_LE( items.size(), 32u );
+    EXPECT_TRUE( gost.VerifyBatch( items.data(), items.size(), results, canonical ) );
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        EXPECT_TRUE( results[ i ] ) << i;
+    }
+
+    items[ 3 ].alpha += 1;
+    items[ 11 ].signature.s += 1;
+    items[ 20 ].key.y += 1;
+    items[ 21 ].signature.r = 0;
+    EXPECT_FALSE( gost.VerifyBatch( items.data(), items.size(), results, canonical ) );
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        bool expected = i != 3 && i != 11 && i != 20 && i != 21;
+        EXPECT_EQ( results[ i ], expected ) << i;
+    }
+    EXPECT_TRUE( gost.VerifyBatch( items.data(), 0, results, canonical ) );
+}
+
+// Signatures of other signers are not canonical, R may have odd y.
+template < size_t bitSize >
+static void BatchVerifyOddR( const CurveParams& params, bool canonical )
+{
+    using Gost = Gost3410< bitSize >;
+    Gost gost( params );
+    const auto& curve = gost.GetCurve();
+    auto d = gost.GeneratePrivateKey();
+    auto publicKey = gost.DerivePublicKey( d );
+    std::vector< typename Gost::VerificationItem > items;
+    for( uint64_t i = 0; items.size() < 8; ++i )
+    {
+        typename Gost::Number alpha = i * 0x1000193;
+        auto k = gost.GeneratePrivateKey();
+        typename Gost::Number x;
+        typename Gost::Number y;
+        curve.ToAffine( curve.Mul( curve.Base(), k ), x, y );
+        if( ( y.Limbs()[ 0 ] & 1 ) != 0 || i % 4 == 0 )
+        {
+            items.push_back( { alpha, gost.Sign( alpha, d, k ), publicKey } );
+        }
+    }
+
+    bool results[ 8 ];
+    EXPECT_TRUE( gost.VerifyBatch( items.data(), items.size(), results, canonical ) );
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        EXPECT_TRUE( results[ i ] ) << i;
+    }
+    items[ 5 ].signature.s += 1;
+    EXPECT_FALSE( gost.VerifyBatch( items.data(), items.size(), results, canonical ) );
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        EXPECT_EQ( results[ i ], i != 5 ) << i;
+    }
+}
+
+TEST( Gost3410Test, BatchVerify )
+{
+    BatchVerify< 256 >( Tc26ParamSet256B(), true );
+    BatchVerify< 512 >( Tc26ParamSet512A(), true );
+    // p = 1 mod 8, R is recovered with Tonelli-Shanks.
+    BatchVerify< 256 >( GostTestParamSet256(), true );
+    // Curves with cofactor fall back to individual verification.
+    BatchVerify< 256 >( Tc26ParamSet256A(), true );
+    BatchVerify< 256 >( Tc26ParamSet256B(), false );
+}
+
+TEST( Gost3410Test, BatchVerifyOddR )
+{
+    // Result does not depend on the canonical flag, which is wrong here.
+    BatchVerifyOddR< 256 >( Tc26ParamSet256B(), true );
+    BatchVerifyOddR< 512 >( Tc26ParamSet512A(), true );
+    BatchVerifyOddR< 256 >( Tc26ParamSet256B(), false );
+}
+
+template < size_t bitSize >
+static void KeyAgreement( const CurveParams& params )
+{
+    using Gost = Gost3410< bitSize >;
+    Gost gost( params );
+    auto ownKey = gost.GeneratePrivateKey();
+    auto peerKey = gost.GeneratePrivateKey();
+    auto ownPublic = gost.DerivePublicKey( ownKey );
+    auto peerPublic = gost.DerivePublicKey( peerKey );
+    typename Gost::Number ukm = 0x1d80603c8544c727;
+
+    auto own = gost.Agree( ownKey, peerPublic, ukm );
+    auto peer = gost.Agree( peerKey, ownPublic, ukm );
+    EXPECT_EQ( own.x, peer.x );
+    EXPECT_EQ( own.y, peer.y );
+
+    auto table = gost.MakePeerTable( peerPublic );
+    auto cached = gost.Agree( ownKey, table, ukm );
+    EXPECT_EQ( cached.x, own.x );
+    EXPECT_NE( gost.Agree( ownKey, table, ukm + 1 ).x, own.x );
+
+    // Zero UKM is replaced by 1.
+    EXPECT_EQ( gost.Agree( ownKey, table, 0 ).x, gost.Agree( ownKey, table, 1 ).x );
+    peerPublic.x += 1;
+    EXPECT_THROW( gost.Agree( ownKey, peerPublic, ukm ), std::runtime_error );
+}
+
+// R 1323565.1.020-2018 and RFC 7836, appendix A.2. Keys and UKM are little-endian there.
+TEST( Gost3410Test, KeyAgreementExample )
+{
+    using Number = Gost3410< 512 >::Number;
+    using crypt_gost::core::hash::Streebog;
+    Gost3410< 512 > gost( Tc26ParamSet512A() );
+    auto ownKey = Hex< 512 >( "67b63ca4ac8d2bb32618d89296c7476dbeb9f9048496f202b1902cf2ce41dbc2"
+                              "f847712d960483458d4b380867f426c7ca0ff5782702dbc44ee8fc72d9ec90c9" );
+    auto peerKey = Hex< 512 >( "dbd09213a592da5bbfd8ed068cccccbbfbeda4feac96b9b4908591440b071480"
+                               "3b9eb763ef932266d4c0181a9b73eacf9013efc65ec07c888515f1b6f759c848" );
+    Number ukm = 0x27c744853c60801d;
+
+    auto peerPublic = gost.DerivePublicKey( peerKey );
+    EXPECT_EQ( peerPublic.x,
+               Hex< 512 >( "51a6d54ee932d176e87591121cce5f395cb2f2f147114d95f463c8a7ed74a9fc"
+                           "5ecd2325a35fb6387831ea66bc3d2aa42ede35872cc75372073a71b983e12f19" ) );
+
+    // KEK_VKO is Streebog of the concatenated little-endian coordinates of the point.
+    auto shared = gost.Agree( ownKey, peerPublic, ukm );
+    EXPECT_EQ( shared.x, gost.Agree( peerKey, gost.DerivePublicKey( ownKey ), ukm ).x );
+    constexpr size_t COORDINATE_SIZE = 512 / 8;
+    uint8_t point[ 2 * COORDINATE_SIZE ];
+    shared.x.ToBytes( point );
+    shared.y.ToBytes( point + COORDINATE_SIZE );
+    std::reverse( point, point + COORDINATE_SIZE );
+    std::reverse( point + COORDINATE_SIZE, point + 2 * COORDINATE_SIZE );
+
+    uint8_t kek[ Streebog::DIGEST_SIZE_512 ];
+    Streebog hash256( Streebog::DIGEST_SIZE_256 );
+    hash256.Update( point, sizeof( point ) );
+    hash256.Final( kek );
+    Gost3410< 256 >::Number kek256;
+    kek256.FromBytes( kek, Streebog::DIGEST_SIZE_256 );
+    EXPECT_EQ( kek256,
+               Hex< 256 >( "c9a9a77320e2cc559ed72dce6f47e2192ccea95fa648670582c054c0ef36c221" ) );
+
+    Streebog hash512( Streebog::DIGEST_SIZE_512 );
+    hash512.Update( point, sizeof( point ) );
+    hash512.Final( kek );
+    Number kek512;
+    kek512.FromBytes( kek, Streebog::DIGEST_SIZE_512 );
+    EXPECT_EQ( kek512,
+               Hex< 512 >( "79f002a96940ce7bde3259a52e015297adaad84597a0d205b50e3e1719f97bfa"
+                           "7ee1d2661fa9979a5aa235b558a7e6d9f88f982dd63fc35a8ec0dd5e242d3bdf" ) );
+}
+
+TEST( Gost3410Test, KeyAgreement )
+{
+    KeyAgreement< 256 >( Tc26ParamSet256A() );
+    KeyAgreement< 256 >( Tc26ParamSet256B() );
+    KeyAgreement< 512 >( Tc26ParamSet512C() );
+}
+
+template < size_t bitSize >
+static void PublicKeyCompression( const CurveParams& params )
+{
+    using Gost = Gost3410< bitSize >;
+    constexpr size_t SIZE = Gost::CurveType::COMPRESSED_SIZE;
+    Gost gost( params );
+    for( int i = 0; i < 4; ++i )
+    {
+        auto publicKey = gost.DerivePublicKey( gost.GeneratePrivateKey() );
+        uint8_t encoded[ SIZE ];
+        gost.CompressPublicKey( publicKey, encoded );
+        EXPECT_EQ( encoded[ 0 ], 0x02 | ( publicKey.y.Limbs()[ 0 ] & 1 ) );
+        auto decoded = gost.DecompressPublicKey( encoded );
+        EXPECT_EQ( decoded.x, publicKey.x );
+        EXPECT_EQ( decoded.y, publicKey.y );
+
+        encoded[ 0 ] ^= 1;
+        decoded = gost.DecompressPublicKey( encoded );
+        EXPECT_EQ( decoded.x, publicKey.x );
+        EXPECT_EQ( decoded.y, gost.GetCurve().GetField().Modulus() - publicKey.y );
+        encoded[ 0 ] = 0x04;
+        EXPECT_THROW( gost.DecompressPublicKey( encoded ), std::runtime_error );
+    }
+
+    // x = p is not reduced.
+    uint8_t encoded[ SIZE ];
+    encoded[ 0 ] = 0x02;
+    gost.GetCurve().GetField().Modulus().ExportBE( encoded + 1, SIZE - 1 );
+    EXPECT_THROW( gost.DecompressPublicKey( encoded ), std::runtime_error );
+}
+
+TEST( Gost3410Test, PublicKeyCompression )
+{
+    PublicKeyCompression< 256 >( GostTestParamSet256() );
+    PublicKeyCompression< 256 >( Tc26ParamSet256A() );
+    PublicKeyCompression< 256 >( Tc26ParamSet256C() );
+    PublicKeyCompression< 512 >( Tc26ParamSet512B() );
+    PublicKeyCompression< 512 >( Tc26ParamSet512C() );
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <core/cpu/cpu_features.hpp>
+#include <core/hash/streebog.hpp>
+#include <core/util/segment.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::hash;
+
+static std::vector< uint8_t > Digest( size_t digestSize, const uint8_t* data, size_t size )
+{
+    Streebog hash( digestSize );
+    std::vector< uint8_t > ret( hash.GetDigestSize() );
+    hash.Update( data, size );
+    hash.Final( ret.data() );
+    return ret;
+}
+
+// GOST R 34.11-2012, appendix A, example 1.
+TEST( StreebogTest, StandardExample )
+{
+    const char* message = "012345678901234567890123456789012345678901234567890123456789012";
+    const auto* data = reinterpret_cast< const uint8_t* >( message );
+    EXPECT_EQ( Digest( Streebog::DIGEST_SIZE_512, data, std::strlen( message ) ),
+               Bytes( "1b54d01a4af5b9d5cc3d86d68d285462b19abc2475222f35c085122be4ba1ffa"
+                      "00ad30f8767b3a82384c6574f024c311e2a481332b08ef7f41797891c1646f48" ) );
+    EXPECT_EQ( Digest( Streebog::DIGEST_SIZE_256, data, std::strlen( message ) ),
+               Bytes( "9d151eefd8590b89daa6ba6cb74af9275dd051026bb149a452fd84e5e57b5500" ) );
+}
+
+TEST( StreebogTest, EmptyMessage )
+{
+    EXPECT_EQ( Digest( Streebog::DIGEST_SIZE_512, nullptr, 0 ),
+               Bytes( "8e945da209aa869f0455928529bcae4679e9873ab707b55315f56ceb98bef0a7"
+                      "362f715528356ee83cda5f2aac4c6ad2ba3a715c1bcd81cb8e9f90bf4c1c1a8a" ) );
+    EXPECT_EQ( Digest( Streebog::DIGEST_SIZE_256, nullptr, 0 ),
+               Bytes( "3f539a213e97c802cc229d474c6aa32a825a360b2a933a949fd925208d9ce1bb" ) );
+}
+
+// Any split of the message gives the same digest, including block boundaries.
+TEST( StreebogTest, Update )
+{
+    std::vector< uint8_t > message( 1000 );
+    for( size_t i = 0; i < message.size(); ++i )
+    {
+        message[ i ] = static_cast< uint8_t >( i * 13 + 5 );
+    }
+    for( size_t digestSize: { Streebog::DIGEST_SIZE_256, Streebog::DIGEST_SIZE_512 } )
+    {
+        auto expected = Digest( digestSize, message.data(), message.size() );
+        Streebog hash( digestSize );
+        for( size_t chunk: { 1, 7, 63, 64, 65, 128, 200 } )
+        {
+            for( size_t offset = 0; offset < message.size(); offset += chunk )
+            {
+                hash.Update( message.data() + offset,
+                             std::min( chunk, message.size() - offset ) );
+            }
+            std::vector< uint8_t > digest( digestSize );
+            hash.Final( digest.data() );
+            EXPECT_EQ( digest, expected ) << chunk;
+        }
+
+        hash.Update( message.data(), 100 );
+        hash.Init();
+        std::vector< uint8_t > digest( digestSize );
+        hash.Update( message.data(), 128 );
+        hash.Final( digest.data() );
+        EXPECT_EQ( digest, Digest( digestSize, message.data(), 128 ) );
+    }
+}
+
+TEST( StreebogTest, DigestSize )
+{
+    EXPECT_THROW( Streebog( 48 ), std::runtime_error );
+}
+
+class StreebogManyTest : public FeatureMaskTest
+{
+};
+
+// Messages of different lengths, so that lanes finish at different steps and are refilled.
+TEST_P( StreebogManyTest, DigestMany )
+{
+    constexpr size_t COUNT = 37;
+    std::vector< uint8_t > data( 64 * COUNT );
+    for( size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 29 + 3 );
+    }
+    std::vector< Streebog::Message > messages;
+    for( size_t i = 0; i < COUNT; ++i )
+    {
+        size_t size = ( i * i * 7 ) % ( data.size() - i );
+        messages.push_back( Streebog::Message{ data.data() + i, size } );
+    }
+
+    for( size_t digestSize: { Streebog::DIGEST_SIZE_256, Streebog::DIGEST_SIZE_512 } )
+    {
+        for( size_t count: { size_t( 1 ), size_t( 5 ), COUNT } )
+        {
+            std::vector< uint8_t > digests( count * digestSize );
+            Streebog::DigestMany( digestSize, messages.data(), count, digests.data() );
+            for( size_t i = 0; i < count; ++i )
+            {
+                auto expected = Digest( digestSize, messages[ i ].data, messages[ i ].size );
+                EXPECT_EQ( std::vector< uint8_t >( digests.begin() + i * digestSize,
+                                                   digests.begin() + ( i + 1 ) * digestSize ),
+                           expected )
+                    << i;
+            }
+        }
+    }
+    EXPECT_THROW( Streebog::DigestMany( 16, messages.data(), COUNT, nullptr ),
+                  std::runtime_error );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         StreebogManyTest,
+                         ::testing::Values( 0u, ~0u ) );
+
+TEST( StreebogTest, Segments )
+{
+    std::vector< uint8_t > message( 1000 );
+    for( size_t i = 0; i < message.size(); ++i )
+    {
+        message[ i ] = static_cast< uint8_t >( i * 13 + 5 );
+    }
+    auto segments = Split< util::ConstSegment >(
+        message.data(), message.size(), { 1, 7, 64, 3, 100, 0, 65 } );
+    Streebog hash;
+    std::vector< uint8_t > digest( hash.GetDigestSize() );
+    hash.Update( segments.data(), segments.size() );
+    hash.Final( digest.data() );
+    EXPECT_EQ( digest, Digest( Streebog::DIGEST_SIZE_512, message.data(), message.size() ) );
+}
@@ -0,0 +1,112 @@
+#include <tuple>
+
+#include <core/math/barrett.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core::math;
+
+using Number = LongNumber< 256 >;
+using WideNumber = LongNumber< 512 >;
+
+// Reference remainder by restoring binary long division.
+template < size_t bitSize >
+LongNumber< bitSize > NaiveMod( LongNumber< bitSize > value, const LongNumber< bitSize >& modulus )
+{
+    size_t shift = bitSize - modulus.BitLength();
+    for( size_t i = shift; i != std::numeric_limits< size_t >::max(); --i )
+    {
+        LongNumber< bitSize > shifted = modulus << i;
+        if( value >= shifted )
+        {
+            value -= shifted;
+        }
+    }
+    return value;
+}
+
+class BarrettTest : public ::testing::TestWithParam< Number >
+{
+};
+
+TEST_P( BarrettTest, ReduceWide )
+{
+    const Number& q = GetParam();
+    BarrettContext< 256 > ctx( q );
+    WideNumber wideQ( q );
+    WideNumber square = wideQ * wideQ;
+
+    for( int i = 0; i < 50; ++i )
+    {
+        WideNumber value = RandomNumber< 512 >();
+        while( value >= square )
+        {
+            value >>= 1;
+        }
+        ASSERT_EQ( ctx.Reduce( value ), Number( NaiveMod( value, wideQ ) ) ) << value;
+    }
+    WideNumber max = square - WideNumber( 1 );
+    ASSERT_EQ( ctx.Reduce( max ), Number( NaiveMod( max, wideQ ) ) );
+    ASSERT_EQ( ctx.Reduce( wideQ ), Number( 0 ) );
+    ASSERT_EQ( ctx.Reduce( WideNumber( 0 ) ), Number( 0 ) );
+}
+
+TEST_P( BarrettTest, ReduceSingle )
+{
+    const Number& q = GetParam();
+    BarrettContext< 256 > ctx( q );
+
+    for( int i = 0; i < 50; ++i )
+    {
+        Number value = RandomNumber< 256 >();
+        ASSERT_EQ( ctx.Reduce( value ), NaiveMod( value, q ) ) << value;
+    }
+}
+
+TEST_P( BarrettTest, SignatureArithmetic )
+{
+    const Number& q = GetParam();
+    BarrettContext< 256 > ctx( q );
+    WideNumber wideQ( q );
+
+    for( int i = 0; i < 20; ++i )
+    {
+        Number r = ctx.Reduce( RandomNumber< 256 >() );
+        Number d = ctx.Reduce( RandomNumber< 256 >() );
+        Number k = ctx.Reduce( RandomNumber< 256 >() );
+        Number e = ctx.Reduce( RandomNumber< 256 >() );
+
+        WideNumber rd = NaiveMod( WideNumber( r ) * WideNumber( d ), wideQ );
+        WideNumber ke = NaiveMod( WideNumber( k ) * WideNumber( e ), wideQ );
+        Number expected( NaiveMod( rd + ke, wideQ ) );
+        ASSERT_EQ( ctx.MulAdd( r, d, k, e ), expected );
+
+        Number diff = ctx.Sub( r, d );
+        ASSERT_EQ( ctx.Add( diff, d ), r );
+    }
+}
+
+TEST( BarrettContextTest, InvalidModulus )
+{
+    EXPECT_THROW( BarrettContext< 256 >( Number( 0 ) ), std::runtime_error );
+    EXPECT_THROW( BarrettContext< 256 >( Number( 12345 ) ), std::runtime_error );
+    EXPECT_THROW( BarrettContext< 256 >( Number( 1 ) << 200 ), std::runtime_error );
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    CoreTest, BarrettTest, ::testing::Values(
+        // GOST R 34.10-2012 example curve subgroup order
+        Number{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                0x50, 0xfe, 0x8a, 0x18, 0x92, 0x97, 0x61, 0x54, 0xc5, 0x9c, 0xfc, 0x19, 0x3a, 0xcc, 0xf5, 0xb3 },
+        // id-tc26-gost-3410-2012-256-paramSetA subgroup order
+        Number{ 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x0f, 0xd8, 0xcd, 0xdf, 0xc8, 0x7b, 0x66, 0x35, 0xc1, 0x15, 0xaf, 0x55, 0x6c, 0x36, 0x0c, 0x67 },
+        // id-GostR3410-2001-CryptoPro-A-ParamSet subgroup order
+        Number{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0x6c, 0x61, 0x10, 0x70, 0x99, 0x5a, 0xd1, 0x00, 0x45, 0x84, 0x1b, 0x09, 0xb7, 0x61, 0xb8, 0x93 }
+    )
+);
+// clang-format on
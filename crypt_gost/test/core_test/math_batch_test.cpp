@@ -0,0 +1,95 @@
+#include <core/cpu/cpu_features.hpp>
+#include <core/math/barrett.hpp>
+#include <core/math/number_batch.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::math;
+
+// Parameter is the feature mask, so that scalar, AVX2 and IFMA kernels are all run where
+// the processor supports them.
+class BatchTest : public FeatureMaskTest
+{
+public:
+    template < size_t bitSize, size_t lanes >
+    void CheckArithmetic( const LongNumber< bitSize >& p )
+    {
+        using Batch = LongNumberBatch< bitSize, lanes >;
+        using Number = LongNumber< bitSize >;
+        Number max = Number( 0 ) - Number( 1 );
+
+        Batch a;
+        Batch b;
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            a.Set( lane, RandomBelow( max ) );
+            b.Set( lane, RandomBelow( max ) );
+        }
+        a.Set( 0, max );
+        b.Set( 0, max );
+
+        Batch sum;
+        Batch product;
+        sum.Add( a, b );
+        product.Mul( a, b );
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            ASSERT_EQ( sum.Get( lane ), a.Get( lane ) + b.Get( lane ) ) << lane;
+            ASSERT_EQ( product.Get( lane ), a.Get( lane ) * b.Get( lane ) ) << lane;
+        }
+
+        typename Batch::Context ctx( p );
+        BarrettContext< bitSize > reference( p );
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            a.Set( lane, RandomBelow( p ) );
+            b.Set( lane, RandomBelow( p ) );
+        }
+        a.Set( lanes - 1, p - Number( 1 ) );
+        b.Set( lanes - 1, p - Number( 1 ) );
+
+        Batch montA;
+        Batch montB;
+        montA.ToMont( a, ctx );
+        montB.ToMont( b, ctx );
+        product.MontMul( montA, montB, ctx );
+        product.FromMont( product, ctx );
+        for( size_t lane = 0; lane < lanes; ++lane )
+        {
+            ASSERT_EQ( product.Get( lane ), reference.Mul( a.Get( lane ), b.Get( lane ) ) )
+                << lane;
+        }
+    }
+};
+
+TEST_P( BatchTest, Arithmetic256 )
+{
+    // GOST R 34.10-2012 example curve prime
+    LongNumber< 256 > p{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x31 };
+    CheckArithmetic< 256, 4 >( p );
+    CheckArithmetic< 256, 8 >( p );
+    CheckArithmetic< 256, 12 >( p );
+}
+
+TEST_P( BatchTest, Arithmetic512 )
+{
+    // 2^512 - 569
+    LongNumber< 512 > p = LongNumber< 512 >( 0 ) - LongNumber< 512 >( 569 );
+    CheckArithmetic< 512, 8 >( p );
+}
+
+TEST( BatchContextTest, InvalidModulus )
+{
+    EXPECT_THROW( BatchMontgomeryContext< 256 >( LongNumber< 256 >( 1 ) ), std::runtime_error );
+    EXPECT_THROW( BatchMontgomeryContext< 256 >( LongNumber< 256 >( 1 ) << 100 ),
+                  std::runtime_error );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         BatchTest,
+                         ::testing::Values( 0u, cpu::FEATURE_AVX2, ~0u ) );
@@ -0,0 +1,82 @@
+#include <array>
+#include <sstream>
+
+#include <core/math/math.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace crypt_gost::core::math;
+
+TEST( ByteOrderTest, LimbsAreLeastSignificantFirst )
+{
+    LongNumber< 128 > number{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                              0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    std::array< uint8_t, 16 > le;
+    number.ExportLE( le.data(), le.size() );
+    for( size_t i = 0; i < le.size(); ++i )
+    {
+        EXPECT_EQ( le[ i ], 0x0f - i );
+    }
+    EXPECT_EQ( number >> 120, LongNumber< 128 >( 0x00 ) );
+    EXPECT_EQ( number >> 112, LongNumber< 128 >( 0x01 ) );
+    EXPECT_EQ( number << 120 >> 120, LongNumber< 128 >( 0x0f ) );
+}
+
+TEST( ByteOrderTest, ImportExportRoundTrip )
+{
+    const uint8_t bytes[] = { 0x9a, 0x41, 0x07, 0x3c, 0x55, 0xe2, 0x18, 0x6f, 0xd0, 0x2b, 0x83 };
+
+    LongNumber< 128, uint32_t > be;
+    be.ImportBE( bytes, sizeof( bytes ) );
+    LongNumber< 128, uint32_t > le;
+    le.ImportLE( bytes, sizeof( bytes ) );
+
+    uint8_t out[ 20 ];
+    be.ExportBE( out, sizeof( out ) );
+    for( size_t i = 0; i < sizeof( out ) - sizeof( bytes ); ++i )
+    {
+        EXPECT_EQ( out[ i ], 0 );
+    }
+    EXPECT_EQ( 0, std::memcmp( out + sizeof( out ) - sizeof( bytes ), bytes, sizeof( bytes ) ) );
+
+    le.ExportLE( out, sizeof( out ) );
+    EXPECT_EQ( 0, std::memcmp( out, bytes, sizeof( bytes ) ) );
+    for( size_t i = sizeof( bytes ); i < sizeof( out ); ++i )
+    {
+        EXPECT_EQ( out[ i ], 0 );
+    }
+
+    // Same bytes read in opposite orders give byte-reversed numbers.
+    le.ExportBE( out, 16 );
+    LongNumber< 128, uint32_t > reversed;
+    reversed.ImportLE( out, 16 );
+    uint8_t expected[ 16 ] = {};
+    std::memcpy( expected, bytes, sizeof( bytes ) );
+    LongNumber< 128, uint32_t > check;
+    check.ImportBE( expected, sizeof( expected ) );
+    EXPECT_EQ( reversed, check );
+}
+
+TEST( ByteOrderTest, InvalidSize )
+{
+    uint8_t buf[ 33 ] = {};
+    LongNumber< 256 > number;
+    EXPECT_THROW( number.ImportBE( buf, sizeof( buf ) ), std::runtime_error );
+    EXPECT_THROW( number.ImportLE( buf, sizeof( buf ) ), std::runtime_error );
+    EXPECT_THROW( number.ExportBE( buf, 31 ), std::runtime_error );
+    EXPECT_THROW( number.ExportLE( buf, 31 ), std::runtime_error );
+    EXPECT_NO_THROW( number.ImportBE( buf, 0 ) );
+    EXPECT_TRUE( number.IsZero() );
+}
+
+TEST( ByteOrderTest, PrintDoesNotModifyNumber )
+{
+    LongNumber< 64, uint16_t > number = 0x1234;
+    std::ostringstream first;
+    first << number;
+    std::ostringstream second;
+    second << number;
+    EXPECT_EQ( first.str(), "00:00:00:00:00:00:12:34" );
+    EXPECT_EQ( first.str(), second.str() );
+    EXPECT_EQ( number, ( LongNumber< 64, uint16_t >( 0x1234 ) ) );
+}
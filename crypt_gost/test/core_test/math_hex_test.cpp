@@ -0,0 +1,79 @@
+#include <sstream>
+#include <string>
+
+#include <core/math/math.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::math;
+
+TEST( HexCodecTest, EncodeDecode )
+{
+    uint8_t bytes[ 256 ];
+    for( size_t i = 0; i < sizeof( bytes ); ++i )
+    {
+        bytes[ i ] = static_cast< uint8_t >( i );
+    }
+    char hex[ 2 * sizeof( bytes ) ];
+    util::hex::Encode( hex, bytes, sizeof( bytes ) );
+    EXPECT_EQ( std::string( hex, 8 ), "00010203" );
+    EXPECT_EQ( std::string( hex + 2 * 0xa9, 6 ), "a9aaab" );
+
+    uint8_t decoded[ sizeof( bytes ) ];
+    ASSERT_TRUE( util::hex::Decode( decoded, hex, sizeof( hex ) ) );
+    EXPECT_EQ( 0, std::memcmp( decoded, bytes, sizeof( bytes ) ) );
+
+    ASSERT_TRUE( util::hex::Decode( decoded, "FfA0", 4 ) );
+    EXPECT_EQ( decoded[ 0 ], 0xff );
+    EXPECT_EQ( decoded[ 1 ], 0xa0 );
+    EXPECT_FALSE( util::hex::Decode( decoded, "0g", 2 ) );
+    EXPECT_FALSE( util::hex::Decode( decoded, "abc", 3 ) );
+}
+
+TEST( HexCodecTest, LongNumberRoundTrip )
+{
+    const std::string hex = "7a929ade789bb9be10ed359dd39a72c11b60961f49397eee1d19ce9891ec3b28";
+    LongNumber< 256 > number;
+    number.FromHex( hex );
+
+    char out[ LongNumber< 256 >::HEX_LENGTH ];
+    number.ToHex( out );
+    EXPECT_EQ( std::string( out, sizeof( out ) ), hex );
+
+    LongNumber< 256, uint16_t > narrow;
+    narrow.FromHex( hex );
+    char narrowOut[ LongNumber< 256, uint16_t >::HEX_LENGTH ];
+    narrow.ToHex( narrowOut );
+    EXPECT_EQ( std::string( narrowOut, sizeof( narrowOut ) ), hex );
+
+    uint8_t bytes[ 32 ];
+    number.ToBytes( bytes );
+    EXPECT_EQ( bytes[ 0 ], 0x7a );
+    EXPECT_EQ( bytes[ 31 ], 0x28 );
+    LongNumber< 256 > fromBytes;
+    fromBytes.FromBytes( bytes, sizeof( bytes ) );
+    EXPECT_EQ( fromBytes, number );
+}
+
+TEST( HexCodecTest, LongNumberShortAndInvalidInput )
+{
+    LongNumber< 128 > number;
+    number.FromHex( "ABC" );
+    EXPECT_EQ( number, LongNumber< 128 >( 0xabc ) );
+    number.FromHex( "" );
+    EXPECT_TRUE( number.IsZero() );
+
+    EXPECT_THROW( number.FromHex( std::string( 33, '1' ) ), std::runtime_error );
+    EXPECT_THROW( number.FromHex( "12 34" ), std::runtime_error );
+    EXPECT_THROW( number.FromHex( "0x1234" ), std::runtime_error );
+}
+
+TEST( HexCodecTest, StreamFormat )
+{
+    LongNumber< 64 > number;
+    number.FromHex( "0123456789ABCDEF" );
+    std::ostringstream os;
+    os << number;
+    EXPECT_EQ( os.str(), "01:23:45:67:89:ab:cd:ef" );
+}
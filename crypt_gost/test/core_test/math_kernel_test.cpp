@@ -0,0 +1,119 @@
+#include <cstdlib>
+#include <vector>
+
+#include <core/cpu/cpu_features.hpp>
+#include <core/math/kernel.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core;
+using namespace crypt_gost::core::math;
+
+using Words = std::vector< uint64_t >;
+
+static Words RandomWords( size_t n )
+{
+    Words ret( n );
+    for( auto& word: ret )
+    {
+        word = ( static_cast< uint64_t >( std::rand() ) << 62 )
+               ^ ( static_cast< uint64_t >( std::rand() ) << 31 ) ^ std::rand();
+        // Saturated words exercise carry propagation.
+        if( std::rand() % 4 == 0 )
+        {
+            word = ~0ull;
+        }
+    }
+    return ret;
+}
+
+// Parameter is the feature mask, kernels selected under it are compared with the
+// portable implementation.
+class KernelTest : public FeatureMaskTest
+{
+};
+
+TEST_P( KernelTest, AddSub )
+{
+    for( size_t n: { 1, 2, 4, 8, 9 } )
+    {
+        for( int i = 0; i < 100; ++i )
+        {
+            Words a = RandomWords( n );
+            Words b = RandomWords( n );
+            Words expected( n );
+            Words actual( n );
+
+            uint64_t expectedCarry = kernel::generic::Add( expected.data(), a.data(), b.data(), n );
+            uint64_t actualCarry = kernel::Add( actual.data(), a.data(), b.data(), n );
+            ASSERT_EQ( expected, actual );
+            ASSERT_EQ( expectedCarry, actualCarry );
+
+            expectedCarry = kernel::generic::Sub( expected.data(), a.data(), b.data(), n );
+            actualCarry = kernel::Sub( actual.data(), a.data(), b.data(), n );
+            ASSERT_EQ( expected, actual );
+            ASSERT_EQ( expectedCarry, actualCarry );
+
+            // In place.
+            kernel::Sub( a.data(), a.data(), b.data(), n );
+            ASSERT_EQ( expected, a );
+        }
+    }
+}
+
+TEST_P( KernelTest, Shift )
+{
+    for( size_t n: { 1, 3, 4, 8 } )
+    {
+        for( size_t shift = 0; shift < n * 64; shift += 7 )
+        {
+            Words a = RandomWords( n );
+            Words expected( n );
+            Words actual = a;
+
+            kernel::generic::ShiftLeft( expected.data(), a.data(), n, shift );
+            kernel::ShiftLeft( actual.data(), actual.data(), n, shift );
+            ASSERT_EQ( expected, actual ) << "shift " << shift;
+
+            actual = a;
+            kernel::generic::ShiftRight( expected.data(), a.data(), n, shift );
+            kernel::ShiftRight( actual.data(), actual.data(), n, shift );
+            ASSERT_EQ( expected, actual ) << "shift " << shift;
+        }
+    }
+}
+
+TEST_P( KernelTest, AddMul1 )
+{
+    for( size_t n: { 1, 2, 4, 8 } )
+    {
+        for( int i = 0; i < 100; ++i )
+        {
+            Words a = RandomWords( n );
+            Words expected = RandomWords( n );
+            Words actual = expected;
+            uint64_t b = RandomWords( 1 )[ 0 ];
+
+            uint64_t expectedCarry = kernel::generic::AddMul1( expected.data(), a.data(), n, b );
+            uint64_t actualCarry = kernel::AddMul1( actual.data(), a.data(), n, b );
+            ASSERT_EQ( expected, actual );
+            ASSERT_EQ( expectedCarry, actualCarry );
+        }
+    }
+}
+
+TEST( KernelGenericTest, ShiftByWholeWords )
+{
+    Words a{ 1, 2, 3, 4 };
+    Words r( 4 );
+    kernel::generic::ShiftLeft( r.data(), a.data(), 4, 64 );
+    EXPECT_EQ( r, ( Words{ 0, 1, 2, 3 } ) );
+    kernel::generic::ShiftRight( r.data(), a.data(), 4, 128 );
+    EXPECT_EQ( r, ( Words{ 3, 4, 0, 0 } ) );
+    kernel::generic::ShiftLeft( r.data(), a.data(), 4, 4 );
+    EXPECT_EQ( r, ( Words{ 0x10, 0x20, 0x30, 0x40 } ) );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest, KernelTest, ::testing::Values( 0u, ~0u ) );
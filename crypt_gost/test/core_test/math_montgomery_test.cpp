@@ -0,0 +1,164 @@
+#include <core/math/montgomery.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core::math;
+
+using Number = LongNumber< 256 >;
+
+// Reference power by square-and-multiply with Barrett reduction.
+template < size_t bitSize >
+static LongNumber< bitSize > NaivePow( const BarrettContext< bitSize >& ctx,
+                                       const LongNumber< bitSize >& base,
+                                       const LongNumber< bitSize >& exponent )
+{
+    LongNumber< bitSize > ret = 1;
+    for( size_t i = exponent.BitLength(); i > 0; --i )
+    {
+        ret = ctx.Mul( ret, ret );
+        if( ( ( exponent >> ( i - 1 ) ).Limbs()[ 0 ] & 1 ) != 0 )
+        {
+            ret = ctx.Mul( ret, base );
+        }
+    }
+    return ret;
+}
+
+class MontgomeryTest : public ::testing::TestWithParam< Number >
+{
+};
+
+TEST_P( MontgomeryTest, Arithmetic )
+{
+    const Number& p = GetParam();
+    MontgomeryContext< 256 > ctx( p );
+    BarrettContext< 256 > reference( p );
+
+    EXPECT_EQ( ctx.FromMont( ctx.One() ), Number( 1 ) );
+    for( int i = 0; i < 50; ++i )
+    {
+        Number a = RandomBelow( p );
+        Number b = RandomBelow( p );
+        Number montA = ctx.ToMont( a );
+        Number montB = ctx.ToMont( b );
+        ASSERT_EQ( ctx.FromMont( montA ), a );
+        ASSERT_EQ( ctx.FromMont( ctx.Mul( montA, montB ) ), reference.Mul( a, b ) );
+        ASSERT_EQ( ctx.FromMont( ctx.Sqr( montA ) ), reference.Mul( a, a ) );
+        ASSERT_EQ( ctx.Add( a, b ), reference.Add( a, b ) );
+        ASSERT_EQ( ctx.Sub( a, b ), reference.Sub( a, b ) );
+    }
+    Number max = p - Number( 1 );
+    EXPECT_EQ( ctx.FromMont( ctx.Mul( ctx.ToMont( max ), ctx.ToMont( max ) ) ), Number( 1 ) );
+    EXPECT_EQ( ctx.Add( max, max ), p - Number( 2 ) );
+}
+
+TEST_P( MontgomeryTest, Pow )
+{
+    const Number& p = GetParam();
+    MontgomeryContext< 256 > ctx( p );
+    BarrettContext< 256 > reference( p );
+
+    for( int i = 0; i < 5; ++i )
+    {
+        Number base = RandomBelow( p );
+        Number exponent = RandomBelow( Number( 0 ) - Number( 1 ) );
+        ASSERT_EQ( ctx.FromMont( ctx.Pow( ctx.ToMont( base ), exponent ) ),
+                   NaivePow( reference, base, exponent ) );
+    }
+    Number base = ctx.ToMont( Number( 12345 ) );
+    EXPECT_EQ( ctx.Pow( base, Number( 0 ) ), ctx.One() );
+    EXPECT_EQ( ctx.Pow( base, Number( 1 ) ), base );
+    // Fermat's little theorem.
+    EXPECT_EQ( ctx.Pow( base, p - Number( 1 ) ), ctx.One() );
+}
+
+TEST_P( MontgomeryTest, Inverse )
+{
+    const Number& p = GetParam();
+    MontgomeryContext< 256 > ctx( p );
+
+    for( int i = 0; i < 20; ++i )
+    {
+        Number a = ctx.ToMont( RandomBelow( p ) );
+        if( a.IsZero() )
+        {
+            continue;
+        }
+        Number inverse = ctx.Inverse( a );
+        ASSERT_EQ( ctx.Mul( a, inverse ), ctx.One() );
+        ASSERT_EQ( ctx.InverseGcd( a ), inverse );
+    }
+    EXPECT_EQ( ctx.Inverse( ctx.One() ), ctx.One() );
+    EXPECT_TRUE( ctx.Inverse( Number( 0 ) ).IsZero() );
+    EXPECT_THROW( ctx.InverseGcd( Number( 0 ) ), std::runtime_error );
+}
+
+TEST_P( MontgomeryTest, BatchInverse )
+{
+    const Number& p = GetParam();
+    MontgomeryContext< 256 > ctx( p );
+
+    LongNumberArray< 256 > values( 33 );
+    for( size_t i = 0; i < values.Size(); ++i )
+    {
+        Number value = RandomBelow( p );
+        values.Set( i, ctx.ToMont( value.IsZero() ? Number( 1 ) : value ) );
+    }
+    LongNumberArray< 256 > inverses = values;
+    ctx.BatchInverse( inverses );
+    for( size_t i = 0; i < values.Size(); ++i )
+    {
+        ASSERT_EQ( inverses.Get( i ), ctx.Inverse( values.Get( i ) ) );
+    }
+
+    values.Set( 7, Number( 0 ) );
+    EXPECT_THROW( ctx.BatchInverse( values ), std::runtime_error );
+}
+
+TEST( MontgomeryContextTest, CompositeModulus )
+{
+    // 2^256 - 1 is divisible by 3, 5, 17, 257 and 65537, but not by 7, 11 or 13.
+    Number m = Number( 0 ) - Number( 1 );
+    MontgomeryContext< 256 > ctx( m );
+    for( uint64_t value: { 7, 11, 13, 1 } )
+    {
+        Number a = ctx.ToMont( Number( value ) );
+        ASSERT_EQ( ctx.Mul( a, ctx.InverseGcd( a ) ), ctx.One() ) << value;
+    }
+    for( uint64_t value: { 3, 5, 255, 65537 } )
+    {
+        EXPECT_THROW( ctx.InverseGcd( ctx.ToMont( Number( value ) ) ), std::runtime_error );
+    }
+    EXPECT_THROW( MontgomeryContext< 256 >( Number( 1 ) << 10 ), std::runtime_error );
+}
+
+TEST( MontgomeryContextTest, NarrowWords )
+{
+    using Narrow = LongNumber< 128, uint16_t >;
+    // 2^127 - 1
+    Narrow p = ( Narrow( 1 ) << 127 ) - Narrow( 1 );
+    MontgomeryContext< 128, uint16_t > ctx( p );
+    Narrow a = ctx.ToMont( Narrow( 0x1234 ) );
+    EXPECT_EQ( ctx.Mul( a, ctx.Inverse( a ) ), ctx.One() );
+    EXPECT_EQ( ctx.InverseGcd( a ), ctx.Inverse( a ) );
+    Narrow cube = Narrow( 0x1234 ) * Narrow( 0x1234 ) * Narrow( 0x1234 );
+    EXPECT_EQ( ctx.FromMont( ctx.Pow( a, Narrow( 3 ) ) ), cube );
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    CoreTest, MontgomeryTest, ::testing::Values(
+        // GOST R 34.10-2012 example curve prime
+        Number{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x31 },
+        // id-tc26-gost-3410-2012-256-paramSetA prime
+        Number{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0x97 },
+        // GOST R 34.10-2012 example curve subgroup order
+        Number{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                0x50, 0xfe, 0x8a, 0x18, 0x92, 0x97, 0x61, 0x54, 0xc5, 0x9c, 0xfc, 0x19, 0x3a, 0xcc, 0xf5, 0xb3 }
+    )
+);
+// clang-format on
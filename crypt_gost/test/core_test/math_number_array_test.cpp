@@ -0,0 +1,107 @@
+#include <core/math/number_array.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core::math;
+
+using Number = LongNumber< 256 >;
+using Array = LongNumberArray< 256 >;
+
+class NumberArrayTest : public ::testing::TestWithParam< Array::Layout >
+{
+public:
+    static constexpr size_t SIZE = 100;
+
+    NumberArrayTest()
+        : a( SIZE, GetParam() )
+        , b( SIZE, GetParam() )
+    {
+        for( size_t i = 0; i < SIZE; ++i )
+        {
+            a.Set( i, RandomNumber< 256 >() );
+            b.Set( i, RandomNumber< 256 >() );
+        }
+        // Carry across all words.
+        a.Set( 0, Number( 0 ) - Number( 1 ) );
+        b.Set( 0, Number( 1 ) );
+    }
+
+    Array a;
+    Array b;
+};
+
+TEST_P( NumberArrayTest, SetGet )
+{
+    Array array( 3, GetParam() );
+    EXPECT_TRUE( array.Get( 2 ).IsZero() );
+    Number value = RandomNumber< 256 >();
+    array.Set( 1, value );
+    EXPECT_EQ( array.Get( 1 ), value );
+    EXPECT_TRUE( array.Get( 0 ).IsZero() );
+    EXPECT_EQ( array.Limb( 1, 0 ), value.Limbs()[ 0 ] );
+    EXPECT_THROW( array.Get( 3 ), std::runtime_error );
+    EXPECT_THROW( array.Set( 3, value ), std::runtime_error );
+}
+
+TEST_P( NumberArrayTest, ElementWise )
+{
+    Array sum( SIZE, GetParam() );
+    Array xored( SIZE, GetParam() );
+    Array product( SIZE, GetParam() );
+    sum.Add( a, b );
+    xored.Xor( a, b );
+    product.Mul( a, b );
+    for( size_t i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( sum.Get( i ), a.Get( i ) + b.Get( i ) );
+        ASSERT_EQ( xored.Get( i ), a.Get( i ) ^ b.Get( i ) );
+        ASSERT_EQ( product.Get( i ), a.Get( i ) * b.Get( i ) );
+    }
+    EXPECT_TRUE( sum.Get( 0 ).IsZero() );
+
+    Array copy = a;
+    a.Add( a, a );
+    for( size_t i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( a.Get( i ), copy.Get( i ) << 1 );
+    }
+}
+
+TEST_P( NumberArrayTest, ModMul )
+{
+    Number q{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+              0x00, 0x00, 0x00, 0x00, 0x01, 0x50, 0xfe, 0x8a, 0x18, 0x92, 0x97,
+              0x61, 0x54, 0xc5, 0x9c, 0xfc, 0x19, 0x3a, 0xcc, 0xf5, 0xb3 };
+    BarrettContext< 256 > ctx( q );
+    for( size_t i = 0; i < SIZE; ++i )
+    {
+        a.Set( i, ctx.Reduce( a.Get( i ) ) );
+        b.Set( i, ctx.Reduce( b.Get( i ) ) );
+    }
+    Array product( SIZE, GetParam() );
+    product.ModMul( a, b, ctx );
+    for( size_t i = 0; i < SIZE; ++i )
+    {
+        ASSERT_EQ( product.Get( i ), ctx.Mul( a.Get( i ), b.Get( i ) ) );
+    }
+}
+
+TEST( NumberArrayLayoutTest, IncompatibleArrays )
+{
+    Array packed( 4, Array::PACKED );
+    Array soa( 4, Array::SOA );
+    Array shorter( 3, Array::PACKED );
+    EXPECT_THROW( packed.Add( packed, soa ), std::runtime_error );
+    EXPECT_THROW( packed.Xor( shorter, packed ), std::runtime_error );
+
+    soa.Set( 2, Number( 0x1234 ) );
+    EXPECT_EQ( soa.Limb( 2, 0 ), 0x1234u );
+    EXPECT_EQ( &soa.Limb( 2, 1 ) - &soa.Limb( 2, 0 ), 4 );
+    EXPECT_EQ( &packed.Limb( 2, 1 ) - &packed.Limb( 2, 0 ), 1 );
+}
+
+INSTANTIATE_TEST_CASE_P( CoreTest,
+                         NumberArrayTest,
+                         ::testing::Values( Array::PACKED, Array::SOA ) );
@@ -0,0 +1,67 @@
+#include <core/math/sqrt.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core::math;
+
+using Number = LongNumber< 256 >;
+
+struct SqrtParams
+{
+    const char* modulus;
+    SqrtContext< 256 >::Method method;
+};
+
+class SqrtTest : public ::testing::TestWithParam< SqrtParams >
+{
+};
+
+// Every square has a root, and the result agrees with Euler's criterion.
+TEST_P( SqrtTest, Roots )
+{
+    Number p;
+    p.FromHex( GetParam().modulus );
+    SqrtContext< 256 > ctx( p );
+    const auto& field = ctx.GetField();
+    ASSERT_EQ( ctx.GetMethod(), GetParam().method );
+
+    Number root;
+    EXPECT_TRUE( ctx.Sqrt( Number( 0 ), root ) );
+    EXPECT_TRUE( root.IsZero() );
+    EXPECT_TRUE( ctx.Sqrt( field.One(), root ) );
+    EXPECT_EQ( field.Sqr( root ), field.One() );
+
+    Number halfOrder = p >> 1;
+    for( int i = 0; i < 32; ++i )
+    {
+        Number a = field.ToMont( RandomBelow( p ) );
+        Number square = field.Sqr( a );
+        ASSERT_TRUE( ctx.Sqrt( square, root ) );
+        EXPECT_EQ( field.Sqr( root ), square );
+        EXPECT_TRUE( root == a || root == field.Sub( Number( 0 ), a ) );
+
+        bool residue = field.Pow( a, halfOrder ) == field.One();
+        EXPECT_EQ( ctx.Sqrt( a, root ), residue );
+        if( residue )
+        {
+            EXPECT_EQ( field.Sqr( root ), a );
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CoreTest,
+    SqrtTest,
+    // id-tc26-gost-3410-2012-256-paramSetA, 2^255 - 19, GOST R 34.10-2012 test curve with
+    // p - 1 = 2^4 * m, and a prime with p - 1 = 2^40 * m.
+    ::testing::Values(
+        SqrtParams{ "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffd97",
+                    SqrtContext< 256 >::EXPONENT },
+        SqrtParams{ "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed",
+                    SqrtContext< 256 >::ATKIN },
+        SqrtParams{ "8000000000000000000000000000000000000000000000000000000000000431",
+                    SqrtContext< 256 >::TONELLI_SHANKS },
+        SqrtParams{ "80000000000000000000000000000000000000000000000000012b0000000001",
+                    SqrtContext< 256 >::TONELLI_SHANKS } ) );
@@ -0,0 +1,102 @@
+#include <core/math/math.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace crypt_gost::core::math;
+using namespace crypt_gost::core::allocator;
+
+class CountingAllocator : public I_Allocator
+{
+public:
+    void* Allocate( size_t size, size_t alignment = 0 ) noexcept override
+    {
+        ++allocations;
+        return HeapAllocator::GetInstance().Allocate( size, alignment );
+    }
+
+    void Deallocate( void* ptr ) noexcept override
+    {
+        HeapAllocator::GetInstance().Deallocate( ptr );
+    }
+
+    size_t allocations = 0;
+};
+
+class TemporariesTest : public ::testing::Test
+{
+public:
+    TemporariesTest()
+        : a( 0x0f0f, alloc )
+        , b( 0x00ff, alloc )
+        , c( 0x1234, alloc )
+        , d( 0x4321, alloc )
+    {
+    }
+
+    CountingAllocator alloc;
+    LongNumber< 256 > a;
+    LongNumber< 256 > b;
+    LongNumber< 256 > c;
+    LongNumber< 256 > d;
+};
+
+TEST_F( TemporariesTest, CompoundExpression )
+{
+    alloc.allocations = 0;
+    LongNumber< 256 > res = a ^ b ^ ( c + d );
+    EXPECT_EQ( alloc.allocations, 2u );
+    EXPECT_EQ( res, LongNumber< 256 >( 0x0f0f ^ 0x00ff ^ ( 0x1234 + 0x4321 ) ) );
+
+    alloc.allocations = 0;
+    res = ( a + b ) * ( c - d ) * a;
+    EXPECT_EQ( alloc.allocations, 2u );
+    LongNumber< 256 > expected = a;
+    expected += b;
+    LongNumber< 256 > diff = c;
+    diff -= d;
+    expected *= diff;
+    expected *= a;
+    EXPECT_EQ( res, expected );
+}
+
+TEST_F( TemporariesTest, CompoundAssignmentDoesNotAllocate )
+{
+    alloc.allocations = 0;
+    a += b;
+    a ^= c;
+    a -= d;
+    a *= b;
+    a *= a;
+    a <<= 3;
+    a >>= 1;
+    EXPECT_EQ( alloc.allocations, 0u );
+}
+
+TEST_F( TemporariesTest, RvalueShift )
+{
+    alloc.allocations = 0;
+    LongNumber< 256 > res = ( a + b ) << 130 >> 2;
+    EXPECT_EQ( alloc.allocations, 1u );
+    EXPECT_EQ( res >> 128, LongNumber< 256 >( 0x0f0f + 0x00ff ) );
+}
+
+TEST( MathZeroTest, XorUpdatesZeroFlag )
+{
+    LongNumber< 128 > a;
+    LongNumber< 128 > b = 5;
+    a ^= b;
+    EXPECT_FALSE( a.IsZero() );
+    EXPECT_EQ( a * b, LongNumber< 128 >( 25 ) );
+    a ^= b;
+    EXPECT_TRUE( a.IsZero() );
+}
+
+TEST( MathZeroTest, SelfAssignment )
+{
+    LongNumber< 128 > a = 0x1234;
+    LongNumber< 128 >& alias = a;
+    a = alias;
+    EXPECT_EQ( a, LongNumber< 128 >( 0x1234 ) );
+    a = std::move( alias );
+    EXPECT_EQ( a, LongNumber< 128 >( 0x1234 ) );
+}
@@ -0,0 +1,90 @@
+#include <string>
+
+#include <core/math/math.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+using namespace crypt_gost::core::math;
+
+static_assert( LongNumber< 320 >::LIMB_COUNT == 5 );
+static_assert( LongNumber< 192, uint32_t >::LIMB_COUNT == 6 );
+static_assert( LongNumber< 24, uint8_t >::LIMB_COUNT == 3 );
+
+TEST( WidthTest, CarryIntoExtraWord )
+{
+    LongNumber< 256 > max = LongNumber< 256 >( 0 ) - LongNumber< 256 >( 1 );
+    LongNumber< 320 > sum( max );
+    sum += LongNumber< 320 >( max );
+    EXPECT_EQ( sum.BitLength(), 257u );
+    EXPECT_EQ( sum >> 256, LongNumber< 320 >( 1 ) );
+    EXPECT_EQ( LongNumber< 256 >( sum ), max - LongNumber< 256 >( 1 ) );
+}
+
+TEST( WidthTest, MatchesWiderArithmetic )
+{
+    for( int i = 0; i < 50; ++i )
+    {
+        LongNumber< 320 > a = RandomNumber< 320 >();
+        LongNumber< 320 > b = RandomNumber< 320 >();
+        LongNumber< 512 > wideA( a );
+        LongNumber< 512 > wideB( b );
+
+        ASSERT_EQ( a + b, LongNumber< 320 >( wideA + wideB ) );
+        ASSERT_EQ( a - b, LongNumber< 320 >( wideA - wideB ) );
+        ASSERT_EQ( a * b, LongNumber< 320 >( wideA * wideB ) );
+        ASSERT_EQ( a >> 70, LongNumber< 320 >( wideA >> 70 ) );
+        ASSERT_EQ( a << 130, LongNumber< 320 >( wideA << 130 ) );
+        ASSERT_EQ( a < b, wideA < wideB );
+    }
+}
+
+TEST( WidthTest, LazyAccumulation )
+{
+    // Sixteen 512-bit products fit into 576 bits without intermediate reduction.
+    LongNumber< 576 > accumulator;
+    LongNumber< 1024 > reference;
+    for( int i = 0; i < 16; ++i )
+    {
+        LongNumber< 576 > a( RandomNumber< 256 >() );
+        LongNumber< 576 > b( RandomNumber< 256 >() );
+        accumulator += a * b;
+        reference += LongNumber< 1024 >( a ) * LongNumber< 1024 >( b );
+    }
+    EXPECT_EQ( LongNumber< 1024 >( accumulator ), reference );
+    EXPECT_GT( accumulator.BitLength(), 512u );
+}
+
+TEST( WidthTest, NarrowWords )
+{
+    LongNumber< 192, uint32_t > a = RandomNumber< 192, uint32_t >();
+    LongNumber< 192, uint32_t > b = RandomNumber< 192, uint32_t >();
+    LongNumber< 256, uint32_t > wideA( a );
+    LongNumber< 256, uint32_t > wideB( b );
+    EXPECT_EQ( a * b, ( LongNumber< 192, uint32_t >( wideA * wideB ) ) );
+
+    LongNumber< 24, uint8_t > small{ 0x12, 0x34, 0x56 };
+    char hex[ LongNumber< 24, uint8_t >::HEX_LENGTH ];
+    small.ToHex( hex );
+    EXPECT_EQ( std::string( hex, sizeof( hex ) ), "123456" );
+    LongNumber< 24, uint8_t > sum = small + LongNumber< 24, uint8_t >( 0xaa );
+    LongNumber< 24, uint8_t > expected{ 0x12, 0x35, 0x00 };
+    EXPECT_EQ( sum, expected );
+}
+
+TEST( WidthTest, Serialization )
+{
+    LongNumber< 320 > number;
+    const std::string hex = "0123456789abcdef00112233445566778899aabbccddeefffedcba9876543210";
+    number.FromHex( hex );
+    char out[ LongNumber< 320 >::HEX_LENGTH ];
+    number.ToHex( out );
+    EXPECT_EQ( std::string( out, sizeof( out ) ), std::string( 16, '0' ) + hex );
+
+    uint8_t bytes[ 40 ];
+    number.ExportBE( bytes, sizeof( bytes ) );
+    LongNumber< 320 > imported;
+    imported.ImportBE( bytes, sizeof( bytes ) );
+    EXPECT_EQ( imported, number );
+}
@@ -0,0 +1,23 @@
+#include <cstring>
+#include <core/util/hex.hpp>
+
+#include <gtest/gtest.h>
+
+#include "test_util.hpp"
+
+std::vector< uint8_t > Bytes( const char* hex )
+{
+    std::vector< uint8_t > ret( std::strlen( hex ) / 2 );
+    EXPECT_TRUE( crypt_gost::core::util::hex::Decode( ret.data(), hex, std::strlen( hex ) ) );
+    return ret;
+}
+
+std::vector< uint8_t > Data( size_t size )
+{
+    std::vector< uint8_t > ret( size );
+    for( size_t i = 0; i < size; ++i )
+    {
+        ret[ i ] = static_cast< uint8_t >( i * 131 + ( i >> 9 ) );
+    }
+    return ret;
+}
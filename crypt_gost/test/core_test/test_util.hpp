@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <core/cpu/cpu_features.hpp>
+#include <core/math/math.hpp>
+#include <core/util/segment.hpp>
+
+#include <gtest/gtest.h>
+
+/**
+ * @brief Fixture whose parameter is the CPU feature mask, so that tests run the kernels
+ * selected under it. The mask is reset after each test.
+ */
+class FeatureMaskTest : public ::testing::TestWithParam< uint32_t >
+{
+public:
+    void SetUp() override
+    {
+        crypt_gost::core::cpu::SetFeatureMask( GetParam() );
+    }
+
+    void TearDown() override
+    {
+        crypt_gost::core::cpu::SetFeatureMask( ~0u );
+    }
+};
+
+/**
+ * @brief Decode hex string, failing the test on invalid input.
+ */
+std::vector< uint8_t > Bytes( const char* hex );
+
+/**
+ * @brief Data of \p size bytes with a pattern which does not repeat with a short period.
+ */
+std::vector< uint8_t > Data( size_t size );
+
+/**
+ * @brief Fragments with sizes taken from \p sizes in a cycle.
+ *
+ * @tparam Segment util::Segment or util::ConstSegment.
+ */
+template < typename Segment = crypt_gost::core::util::Segment >
+std::vector< Segment > Split( decltype( Segment::data ) data,
+                              size_t size,
+                              const std::vector< size_t >& sizes )
+{
+    std::vector< Segment > ret;
+    for( size_t offset = 0, i = 0; offset < size; ++i )
+    {
+        size_t n = std::min( sizes[ i % sizes.size() ], size - offset );
+        ret.push_back( { data + offset, n } );
+        offset += n;
+    }
+    return ret;
+}
+
+/**
+ * @brief Number with every limb taken from std::rand.
+ */
+template < size_t bitSize, typename T = uint64_t >
+crypt_gost::core::math::LongNumber< bitSize, T > RandomNumber()
+{
+    using Number = crypt_gost::core::math::LongNumber< bitSize, T >;
+    T limbs[ Number::LIMB_COUNT ];
+    for( auto& limb: limbs )
+    {
+        limb = static_cast< T >( ( static_cast< uint64_t >( std::rand() ) << 62 )
+                                 ^ ( static_cast< uint64_t >( std::rand() ) << 31 ) ^ std::rand() );
+    }
+    Number ret;
+    ret.AssignLimbs( limbs );
+    return ret;
+}
+
+/**
+ * @brief Random number below \p bound, shifted right until it fits, so that numbers shorter
+ * than \p bound occur as well.
+ */
+template < size_t bitSize >
+crypt_gost::core::math::LongNumber< bitSize >
+RandomBelow( const crypt_gost::core::math::LongNumber< bitSize >& bound )
+{
+    auto ret = RandomNumber< bitSize >();
+    while( ret >= bound )
+    {
+        ret >>= 1;
+    }
+    return ret;
+}
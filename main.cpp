@@ -47,9 +47,10 @@ int main()
                                    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 };
     std::vector< uint8_t > bytes2{ 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
                                    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02 };
-    crypt_gost::core::math::LongNumber< 128, uint32_t > number1( bytes1.data() );
+    crypt_gost::core::math::LongNumber< 128, uint32_t > number1;
+    number1.ImportBE( bytes1.data(), bytes1.size() );
     crypt_gost::core::math::LongNumber< 128, uint32_t > number2 = number1;
-    number2 = crypt_gost::core::math::LongNumber< 128, uint32_t >{ bytes2.data() };
+    number2.ImportBE( bytes2.data(), bytes2.size() );
     std::cout << "Number1 = " << number1 << std::endl;
     std::cout << "Number2 = " << number2 << std::endl;
     crypt_gost::core::math::LongNumber< 128, uint32_t > number3 = number1 ^ number2;